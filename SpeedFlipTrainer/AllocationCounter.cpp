@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "AllocationCounter.h"
+
+#ifdef SF_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+static thread_local uint64_t allocations = 0;
+static thread_local int excludeDepth = 0;
+
+uint64_t AllocationCounter::Count()
+{
+	return allocations;
+}
+
+AllocationCounter::Exclude::Exclude()
+{
+	excludeDepth++;
+}
+
+AllocationCounter::Exclude::~Exclude()
+{
+	excludeDepth--;
+}
+
+static void* CountedAlloc(size_t size)
+{
+	if (excludeDepth == 0)
+		allocations++;
+	return std::malloc(size ? size : 1);
+}
+
+// Replacing the global operators only affects allocations made by this DLL
+void* operator new(size_t size)
+{
+	if (void* p = CountedAlloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* p = CountedAlloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+#else
+
+uint64_t AllocationCounter::Count()
+{
+	return 0;
+}
+
+AllocationCounter::Exclude::Exclude() {}
+AllocationCounter::Exclude::~Exclude() {}
+
+#endif
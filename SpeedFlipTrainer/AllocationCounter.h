@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts heap allocations made through the global operator new of the plugin.
+// Counting is only compiled in with SF_COUNT_ALLOCATIONS (Debug builds), otherwise
+// Count() is always 0 and the scopes below cost nothing.
+namespace AllocationCounter
+{
+#ifdef SF_COUNT_ALLOCATIONS
+	constexpr bool Enabled = true;
+#else
+	constexpr bool Enabled = false;
+#endif
+
+	// Allocations made by the calling thread so far
+	uint64_t Count();
+
+	// Allocations made while an Exclude is alive are not counted. Used around SDK calls
+	// that take std::string by value, the copy they force is outside of our control.
+	class Exclude
+	{
+	public:
+		Exclude();
+		~Exclude();
+		Exclude(const Exclude&) = delete;
+		Exclude& operator=(const Exclude&) = delete;
+	};
+}
+
+// Allocations made by the calling thread since the scope was created
+class AllocationScope
+{
+public:
+	AllocationScope() : start(AllocationCounter::Count()) {}
+	uint64_t Allocations() const { return AllocationCounter::Count() - start; }
+
+private:
+	uint64_t start;
+};
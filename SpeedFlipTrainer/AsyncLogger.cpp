@@ -0,0 +1,183 @@
+#include "pch.h"
+#include "AsyncLogger.h"
+
+#include <chrono>
+
+AsyncLogger& AsyncLogger::Instance()
+{
+	static AsyncLogger logger;
+	return logger;
+}
+
+AsyncLogger::AsyncLogger()
+{
+	for (size_t i = 0; i < Capacity; i++)
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+	Stop();
+
+	// Text records that were never written still own their string
+	Record record;
+	while (TryPop(record))
+		delete record.text;
+}
+
+void AsyncLogger::Start(Sink newSink)
+{
+	Stop();
+
+	sink = std::move(newSink);
+	stopping = false;
+	running.store(true, std::memory_order_release);
+	worker = std::thread(&AsyncLogger::WorkerLoop, this);
+}
+
+void AsyncLogger::Stop()
+{
+	if (!worker.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	worker.join();
+
+	running.store(false, std::memory_order_release);
+	Drain();
+	sink = nullptr;
+}
+
+void AsyncLogger::PushText(LogLevel level, std::string text)
+{
+	auto owned = new std::string(std::move(text));
+	bool pushed = TryPush([&](Record& record) {
+		record.level = level;
+		record.format = nullptr;
+		record.formatData = nullptr;
+		record.formatSize = 0;
+		record.text = owned;
+	});
+	if (!pushed)
+	{
+		delete owned;
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool AsyncLogger::TryPop(Record& record)
+{
+	Slot& slot = slots[head & (Capacity - 1)];
+	size_t sequence = slot.sequence.load(std::memory_order_acquire);
+	if (sequence != head + 1)
+		return false;
+
+	record = slot.record;
+	slot.sequence.store(head + Capacity, std::memory_order_release);
+	head++;
+	return true;
+}
+
+void AsyncLogger::WorkerLoop()
+{
+	// Producers never signal, the thread polls so pushing stays free of locks and syscalls
+	constexpr auto PollInterval = std::chrono::milliseconds(10);
+
+	while (true)
+	{
+		Drain();
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		if (stopping)
+			return;
+		wake.wait_for(lock, PollInterval, [this] { return stopping; });
+	}
+}
+
+size_t AsyncLogger::Drain()
+{
+	size_t written = 0;
+	Record record;
+	while (TryPop(record))
+	{
+		Write(record);
+		written++;
+	}
+	return written;
+}
+
+void AsyncLogger::Write(const Record& record)
+{
+	uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+	if (droppedNow != reportedDropped && sink)
+	{
+		sink(LogLevel::Warning, fmt::format("Log buffer full, {} lines dropped", droppedNow - reportedDropped));
+		reportedDropped = droppedNow;
+	}
+
+	if (record.text)
+	{
+		if (sink)
+			sink(record.level, *record.text);
+		delete record.text;
+		return;
+	}
+
+	line.clear();
+	record.format(line, fmt::string_view(record.formatData, record.formatSize), record.args);
+	if (sink)
+		sink(record.level, fmt::to_string(line));
+}
+
+void LogLineQueue::SetDispatcher(Dispatcher newDispatch)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	dispatch = std::move(newDispatch);
+}
+
+void LogLineQueue::Push(LogLevel level, const std::string& text)
+{
+	Dispatcher dispatcher;
+	bool first;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		dispatcher = dispatch;
+		if (!dispatcher)
+		{
+			write(level, text);
+			return;
+		}
+		first = lines.empty();
+		lines.emplace_back(level, text);
+	}
+
+	// Lines pushed before the dispatched call runs go out with it
+	if (!first)
+		return;
+	std::weak_ptr<int> queue = alive;
+	dispatcher([this, queue]() {
+		if (!queue.expired())
+			RunPending();
+	});
+}
+
+void LogLineQueue::RunPending()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		writing.swap(lines);
+	}
+	for (const Line& line : writing)
+		write(line.first, line.second);
+	writing.clear();
+}
+
+size_t LogLineQueue::Pending() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return lines.size();
+}
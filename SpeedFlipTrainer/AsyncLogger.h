@@ -0,0 +1,237 @@
+#pragma once
+
+#include "fmt/format.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum class LogLevel : uint8_t
+{
+	Debug,
+	Info,
+	Warning,
+	Error,
+};
+
+// Records below this level are compiled out, the format string is still checked
+#define SF_LOG_LEVEL_DEBUG 0
+#define SF_LOG_LEVEL_INFO 1
+#define SF_LOG_LEVEL_WARNING 2
+#define SF_LOG_LEVEL_ERROR 3
+
+#ifndef SF_LOG_LEVEL
+#ifdef _DEBUG
+#define SF_LOG_LEVEL SF_LOG_LEVEL_DEBUG
+#else
+#define SF_LOG_LEVEL SF_LOG_LEVEL_INFO
+#endif
+#endif
+
+// Hot path logging. The arguments are copied into the ring as they are and formatted on the
+// logger thread, so they have to be plain values: no strings, no pointers.
+#define SF_LOG(level, format, ...) \
+	do \
+	{ \
+		if constexpr (static_cast<int>(level) >= SF_LOG_LEVEL) \
+			AsyncLogger::Instance().Push(level, FMT_STRING(format), ##__VA_ARGS__); \
+	} while (0)
+
+#define SF_LOG_DEBUG(format, ...) SF_LOG(LogLevel::Debug, format, ##__VA_ARGS__)
+#define SF_LOG_INFO(format, ...) SF_LOG(LogLevel::Info, format, ##__VA_ARGS__)
+#define SF_LOG_WARNING(format, ...) SF_LOG(LogLevel::Warning, format, ##__VA_ARGS__)
+#define SF_LOG_ERROR(format, ...) SF_LOG(LogLevel::Error, format, ##__VA_ARGS__)
+
+// Log records go through a bounded lock-free ring that any thread can push to. Pushing
+// copies a format string pointer and the raw arguments into a fixed size record, nothing
+// is formatted or allocated on the calling thread. A logger thread formats the records
+// in order and hands the lines to the sink. A full ring drops records instead of waiting,
+// the number of dropped records is reported with the next line.
+class AsyncLogger
+{
+public:
+	using Sink = std::function<void(LogLevel, const std::string&)>;
+
+	static constexpr size_t Capacity = 1024; // Power of two
+	static constexpr size_t MaxArgBytes = 48;
+
+	static AsyncLogger& Instance();
+
+	AsyncLogger();
+	~AsyncLogger();
+
+	AsyncLogger(const AsyncLogger&) = delete;
+	AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+	// Starts the logger thread, records pushed before are written first
+	void Start(Sink sink);
+	// Writes what is left on the calling thread and joins the logger thread
+	void Stop();
+	bool IsRunning() const { return running.load(std::memory_order_acquire); }
+
+	template <typename S, typename... Args>
+	void Push(LogLevel level, const S& format, const Args&... args);
+
+	// Queues a line that is already formatted, used by LOG for cold paths
+	void PushText(LogLevel level, std::string text);
+
+	uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+	using FormatFn = void (*)(fmt::memory_buffer& out, fmt::string_view format, const unsigned char* args);
+
+	struct Record
+	{
+		LogLevel level;
+		FormatFn format;         // nullptr for text records
+		const char* formatData;  // String literal from the call site
+		size_t formatSize;
+		std::string* text;       // Owned, only for text records
+		alignas(std::max_align_t) unsigned char args[MaxArgBytes];
+	};
+
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		Record record;
+	};
+
+	template <typename... Args>
+	static void FormatRecord(fmt::memory_buffer& out, fmt::string_view format, const unsigned char* args);
+
+	template <typename Fill>
+	bool TryPush(Fill&& fill);
+	bool TryPop(Record& record);
+
+	void WorkerLoop();
+	// Formats and writes every queued record, returns the number written
+	size_t Drain();
+	void Write(const Record& record);
+
+	Slot slots[Capacity];
+	alignas(64) std::atomic<size_t> tail{ 0 }; // Producers
+	alignas(64) size_t head = 0;               // Logger thread, or Stop once it joined
+
+	std::atomic<uint64_t> dropped{ 0 };
+	uint64_t reportedDropped = 0;
+
+	std::atomic<bool> running{ false };
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	bool stopping = false;
+	std::thread worker;
+	Sink sink;
+	fmt::memory_buffer line;
+};
+
+// Hands the lines of the logger thread to a sink that may only run on the game thread, such
+// as the console. Push queues a line, the first line of a batch dispatches one call that
+// writes the whole batch (gameWrapper->Execute in game). RunPending writes what is left on
+// the calling thread when the plugin unloads, dispatched calls do nothing once the queue is gone.
+class LogLineQueue
+{
+public:
+	using Job = std::function<void()>;
+	using Dispatcher = std::function<void(Job)>;
+
+	explicit LogLineQueue(AsyncLogger::Sink write) : write(std::move(write)) {}
+
+	LogLineQueue(const LogLineQueue&) = delete;
+	LogLineQueue& operator=(const LogLineQueue&) = delete;
+
+	// Without a dispatcher lines are written by Push, on the logger thread
+	void SetDispatcher(Dispatcher dispatch);
+
+	// Called by the AsyncLogger sink
+	void Push(LogLevel level, const std::string& text);
+	// Writes every queued line, in order
+	void RunPending();
+
+	size_t Pending() const;
+
+private:
+	using Line = std::pair<LogLevel, std::string>;
+
+	AsyncLogger::Sink write;
+	Dispatcher dispatch;
+
+	mutable std::mutex mutex;
+	std::vector<Line> lines;
+	std::vector<Line> writing; // Only touched by RunPending
+
+	std::shared_ptr<int> alive = std::make_shared<int>(0);
+};
+
+template <typename... Args>
+void AsyncLogger::FormatRecord(fmt::memory_buffer& out, fmt::string_view format, const unsigned char* args)
+{
+	const auto& values = *reinterpret_cast<const std::tuple<Args...>*>(args);
+	std::apply([&](const Args&... unpacked) { fmt::format_to(out, format, unpacked...); }, values);
+}
+
+template <typename Fill>
+bool AsyncLogger::TryPush(Fill&& fill)
+{
+	// Bounded multi-producer queue, each slot's sequence says whose turn it is
+	size_t pos = tail.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Slot& slot = slots[pos & (Capacity - 1)];
+		size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				fill(slot.record);
+				slot.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false; // Full
+		}
+		else
+		{
+			pos = tail.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template <typename S, typename... Args>
+void AsyncLogger::Push(LogLevel level, const S& format, const Args&... args)
+{
+	static_assert(fmt::is_compile_string<S>::value, "Use the SF_LOG macros, they check the format string at compile time");
+	fmt::detail::check_format_string<Args...>(format);
+
+	using Values = std::tuple<std::decay_t<Args>...>;
+	static_assert(sizeof(Values) <= MaxArgBytes, "Too many log arguments for one record");
+	static_assert(std::conjunction<std::is_trivially_copyable<std::decay_t<Args>>...>::value,
+		"Log arguments are copied raw, format strings on the caller side and use LOG");
+	static_assert(!std::disjunction<std::is_pointer<std::decay_t<Args>>...>::value,
+		"Pointers may dangle before the record is formatted, use LOG");
+
+	fmt::string_view view = fmt::to_string_view(format);
+	bool pushed = TryPush([&](Record& record) {
+		record.level = level;
+		record.format = &FormatRecord<std::decay_t<Args>...>;
+		record.formatData = view.data();
+		record.formatSize = view.size();
+		record.text = nullptr;
+		new (record.args) Values(args...);
+	});
+	if (!pushed)
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
@@ -1,38 +1,94 @@
 #include "pch.h"
 #include "Attempt.h"
+#include "FileIO.h"
+#include "CsvWriter.h"
 
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include <algorithm>
 
 using namespace std;
 
 void Attempt::Record(int tick, ControllerInput input)
 {
-	inputs[tick] = input;
+	inputs.Record(tick, input);
 }
 
-void Attempt::Play(ControllerInput* ci, int tick)
-{	
-	auto it = inputs.find(tick);
-	if (it == inputs.end())
+bool Attempt::Play(ControllerInput* ci, int tick, InputRuns::Cursor& cursor) const
+{
+	if (mapped)
+		return mapped->Decode(tick, ci);
+
+	// Still recording, the timeline lookup is O(1) as well
+	if (runs.empty() || runsRevision != inputs.Revision())
+		return inputs.Play(ci, tick);
+
+	const ControllerInput* input = cursor.Next(runs, tick);
+	if (input == nullptr)
+		return false;
+
+	CopyControllerInput(ci, *input);
+	return true;
+}
+
+bool Attempt::HasInputs() const
+{
+	return !inputs.empty() || !runs.empty() || (mapped && !mapped->empty());
+}
+
+int Attempt::End() const
+{
+	if (mapped)
+		return mapped->End();
+	return std::max(inputs.End(), runs.End());
+}
+
+void Attempt::Clear()
+{
+	startedInAir = false;
+	startedNoBoost = false;
+	jumpTick = 0;
+	jumped = false;
+	flipCancelTick = 0;
+	flipCanceled = false;
+	dodgeAngle = 0;
+	dodgedTick = 0;
+	dodged = false;
+	positionY = -1.1;
+	traveledY = 0;
+	ticksToBall = 0;
+	timeToBall = 0.0f;
+	hit = false;
+	exploded = false;
+	ticksNotPressingBoost = 0;
+	ticksNotPressingThrottle = 0;
+
+	trajectory.Reset();
+	physics.clear();
+	inputs.clear();
+	runs.clear();
+	runsRevision = inputs.Revision();
+	mapped.reset();
+}
+
+void Attempt::Freeze()
+{
+	if (inputs.empty() || (!runs.empty() && runsRevision == inputs.Revision()))
+		return;
+
+	runs.Build(inputs);
+	runsRevision = inputs.Revision();
+}
+
+void Attempt::Compact()
+{
+	if (inputs.empty())
 		return;
 
-	ci->ActivateBoost = it->second.ActivateBoost;
-	ci->DodgeForward = it->second.DodgeForward;
-	ci->DodgeStrafe = it->second.DodgeStrafe;
-	ci->Handbrake = it->second.Handbrake;
-	ci->HoldingBoost = it->second.HoldingBoost;
-	ci->Jump = it->second.Jump;
-	ci->Jumped = it->second.Jumped;
-	ci->Pitch = it->second.Pitch;
-	ci->Roll = it->second.Roll;
-	ci->Steer = it->second.Steer;
-	ci->Throttle = it->second.Throttle;
-	ci->Yaw = it->second.Yaw;
+	Freeze();
+	inputs = InputTimeline(0);
+	runsRevision = inputs.Revision();
 }
 
-filesystem::path Attempt::GetFilename(filesystem::path dir)
+filesystem::path Attempt::GetFilename(filesystem::path dir, const char* extension) const
 {
 	// Get date string
 	auto t = time(0);
@@ -55,91 +111,175 @@ filesystem::path Attempt::GetFilename(filesystem::path dir)
 	auto secs = to_string(now->tm_sec);
 	secs.insert(secs.begin(), 2 - secs.length(), '0');
 
-	string filename = year + "-" + month + "-" + day + "." + hour + "." + min + "." + secs + ".csv";
+	string filename = year + "-" + month + "-" + day + "." + hour + "." + min + "." + secs + extension;
 	return dir / filename;
 }
 
-void Attempt::WriteInputsToFile(filesystem::path filepath)
+const InputTimeline& Attempt::SavedInputs(InputTimeline& scratch) const
 {
-	ofstream os;
-	os.open(filepath, ios::out);
-	os << "Tick,"
-	   << "ActivateBoost,"
-	   << "DodgeForward,"
-	   << "DodgeStrafe,"
-	   << "Handbrake,"
-	   << "HoldingBoost,"
-	   << "Jump,"
-	   << "Jumped,"
-	   << "Pitch,"
-	   << "Roll,"
-	   << "Steer,"
-	   << "Throttle,"
-	   << "Yaw" << '\n';
-	for (auto& kv : inputs) {
-		os << kv.first << ","
-		   << kv.second.ActivateBoost << ","
-		   << kv.second.DodgeForward << ","
-		   << kv.second.DodgeStrafe << ","
-		   << kv.second.Handbrake << ","
-		   << kv.second.HoldingBoost << ","
-		   << kv.second.Jump << ","
-		   << kv.second.Jumped << ","
-		   << kv.second.Pitch << ","
-		   << kv.second.Roll << ","
-		   << kv.second.Steer << ","
-		   << kv.second.Throttle << ","
-		   << kv.second.Yaw << '\n';
-	}
-	os.close();
+	if (!inputs.empty())
+		return inputs;
+
+	if (!runs.empty())
+		runs.CopyTo(scratch);
+	else if (mapped)
+		mapped->CopyTo(scratch);
+	return scratch;
 }
 
-void Attempt::ReadInputsFromFile(filesystem::path filepath)
+bool Attempt::WriteInputsToFile(filesystem::path filepath, string* error) const
 {
-	ifstream is;
-	is.open(filepath, ios::in);
+	InputTimeline scratch(0);
+	const InputTimeline& inputs = SavedInputs(scratch);
 
-	string line, word;
+	static const char* const columns[] = {
+		"Tick", "ActivateBoost", "DodgeForward", "DodgeStrafe", "Handbrake", "HoldingBoost",
+		"Jump", "Jumped", "Pitch", "Roll", "Steer", "Throttle", "Yaw"
+	};
+
+	// Most records are short integer flags and a few floats, this is rarely exceeded
+	CsvWriter csv;
+	csv.Reserve(128 + inputs.size() * 48);
+
+	for (const char* column : columns)
+		csv.Write(string_view(column));
+	csv.EndRecord();
+
+	inputs.ForEach([&csv](int tick, const ControllerInput& input) {
+		csv.Write(tick);
+		csv.Write(static_cast<bool>(input.ActivateBoost));
+		csv.Write(input.DodgeForward);
+		csv.Write(input.DodgeStrafe);
+		csv.Write(static_cast<bool>(input.Handbrake));
+		csv.Write(static_cast<bool>(input.HoldingBoost));
+		csv.Write(static_cast<bool>(input.Jump));
+		csv.Write(static_cast<bool>(input.Jumped));
+		csv.Write(input.Pitch);
+		csv.Write(input.Roll);
+		csv.Write(input.Steer);
+		csv.Write(input.Throttle);
+		csv.Write(input.Yaw);
+		csv.EndRecord();
+	});
+
+	return csv.WriteTo(filepath, error);
+}
+
+bool Attempt::ReadInputsFromFile(filesystem::path filepath, ParseError* error)
+{
+	if (filepath.extension() == AttemptFileExtension)
+	{
+		string message;
+		if (MapBinaryFile(filepath, &message))
+			return true;
 
+		if (error) *error = ParseError{ 0, 0, message };
+		return false;
+	}
+
+	MappedFile file;
+	string message;
+	if (!file.Open(filepath, &message))
+	{
+		if (error) *error = ParseError{ 0, 0, message };
+		return false;
+	}
+
+	const char* data = reinterpret_cast<const char*>(file.Data());
+	CsvReader reader(data, data + file.Size());
+
+	mapped.reset();
+	runs.clear();
 	inputs.clear(); // clear current inputs
+	physics.clear(); // .csv files only hold inputs
 
-	getline(is, line); // skip header line
+	reader.NextRecord(); // skip header line
 
-	while (getline(is, line)) 
+	while (reader.NextRecord())
 	{
 		ControllerInput i;
+		int tick;
+		bool activateBoost, handbrake, holdingBoost, jump, jumped;
+
+		bool ok = reader.Read(tick)
+			&& reader.Read(activateBoost)
+			&& reader.Read(i.DodgeForward)
+			&& reader.Read(i.DodgeStrafe)
+			&& reader.Read(handbrake)
+			&& reader.Read(holdingBoost)
+			&& reader.Read(jump)
+			&& reader.Read(jumped)
+			&& reader.Read(i.Pitch)
+			&& reader.Read(i.Roll)
+			&& reader.Read(i.Steer)
+			&& reader.Read(i.Throttle)
+			&& reader.Read(i.Yaw);
+		if (!ok)
+			break;
+
+		i.ActivateBoost = activateBoost;
+		i.Handbrake = handbrake;
+		i.HoldingBoost = holdingBoost;
+		i.Jump = jump;
+		i.Jumped = jumped;
 
-		// Parse line
-		stringstream s(line);
-		getline(s, word, ',');
-		int tick = stoi(word);
-		getline(s, word, ',');
-		i.ActivateBoost = stoul(word);
-		getline(s, word, ',');
-		i.DodgeForward = stof(word);
-		getline(s, word, ',');
-		i.DodgeStrafe = stof(word);
-		getline(s, word, ',');
-		i.Handbrake = stoul(word);
-		getline(s, word, ',');
-		i.HoldingBoost = stoul(word);
-		getline(s, word, ',');
-		i.Jump = stoul(word);
-		getline(s, word, ',');
-		i.Jumped = stoul(word);
-		getline(s, word, ',');
-		i.Pitch = stof(word);
-		getline(s, word, ',');
-		i.Roll = stof(word);
-		getline(s, word, ',');
-		i.Steer = stof(word);
-		getline(s, word, ',');
-		i.Throttle = stof(word);
-		getline(s, word, ',');
-		i.Yaw = stof(word);
-
-		inputs[tick] = i;
+		inputs.Record(tick, i);
 	}
 
-	is.close();
-}
\ No newline at end of file
+	if (reader.Failed())
+	{
+		if (error) *error = reader.Error();
+		inputs.clear();
+		return false;
+	}
+	return true;
+}
+
+bool Attempt::WriteBinaryFile(filesystem::path filepath, string* error) const
+{
+	InputTimeline scratch(0);
+	const InputTimeline& inputs = SavedInputs(scratch);
+
+	PhysicsTrack mappedPhysics;
+	const PhysicsTrack* track = &physics;
+	if (physics.empty() && mapped && mapped->HasPhysics())
+	{
+		mapped->CopyPhysicsTo(mappedPhysics);
+		track = &mappedPhysics;
+	}
+	return WriteAttemptFile(inputs, track, filepath, error);
+}
+
+bool Attempt::MapBinaryFile(filesystem::path filepath, string* error)
+{
+	auto view = make_shared<AttemptFileView>();
+	if (!view->Open(filepath, error))
+		return false;
+
+	inputs.clear();
+	runs.clear();
+	physics.clear();
+	mapped = view;
+	return true;
+}
+
+bool Attempt::WriteToFile(filesystem::path filepath, string* error) const
+{
+	if (filepath.extension() == AttemptFileExtension)
+		return WriteBinaryFile(filepath, error);
+
+	return WriteInputsToFile(filepath, error);
+}
+
+bool Attempt::ConvertFile(filesystem::path from, filesystem::path to, string* error)
+{
+	Attempt a;
+	ParseError parseError;
+	if (!a.ReadInputsFromFile(from, &parseError))
+	{
+		if (error) *error = parseError.ToString();
+		return false;
+	}
+
+	return a.WriteToFile(to, error);
+}
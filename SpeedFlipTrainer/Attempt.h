@@ -1,7 +1,14 @@
 #pragma once
 
-#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include "InputTimeline.h"
+#include "InputRuns.h"
+#include "AttemptFile.h"
+#include "CsvReader.h"
+#include "Trajectory.h"
+#include "PhysicsTrack.h"
 #include <filesystem>
+#include <memory>
 
 using namespace std;
 
@@ -31,6 +38,12 @@ public:
 	float positionY = -1.1;
 	float traveledY = 0;
 
+	// Car positions and path statistics since the attempt started
+	Trajectory trajectory;
+
+	// Car state per tick, only recorded with sf_capture_physics and saved in .sfa files
+	PhysicsTrack physics;
+
 	// Number of ticks taken to reach the ball
 	int ticksToBall = 0;
 	float timeToBall = 0.0f;
@@ -44,12 +57,42 @@ public:
 	int ticksNotPressingThrottle = 0;
 
 	void Record(int tick, ControllerInput input);
-	void Play(ControllerInput* ci, int tick);
-	filesystem::path GetFilename(filesystem::path dir);
-	void WriteInputsToFile(std::filesystem::path filepath);
-	void ReadInputsFromFile(std::filesystem::path filepath);
+	// The playback position lives in the caller, so one attempt can be shared by several players
+	bool Play(ControllerInput* ci, int tick, InputRuns::Cursor& cursor) const;
+	bool HasInputs() const;
+	// One past the last tick with an input, wherever the inputs are stored
+	int End() const;
+
+	// Forgets everything recorded but keeps the allocated storage for the next attempt
+	void Clear();
+	// Builds the runs used for playback, called before an attempt is shared as a snapshot
+	void Freeze();
+	// Replaces the tick timeline by its run-length encoding to save memory, playback is unaffected
+	void Compact();
+	filesystem::path GetFilename(filesystem::path dir, const char* extension = ".csv") const;
+	bool WriteInputsToFile(std::filesystem::path filepath, std::string* error = nullptr) const;
+	bool ReadInputsFromFile(std::filesystem::path filepath, ParseError* error = nullptr);
+
+	// Binary .sfa attempts, see AttemptFile.h
+	bool WriteBinaryFile(std::filesystem::path filepath, std::string* error = nullptr) const;
+	bool MapBinaryFile(std::filesystem::path filepath, std::string* error = nullptr);
+
+	// Picks .csv or .sfa from the file extension
+	bool WriteToFile(std::filesystem::path filepath, std::string* error = nullptr) const;
+
+	// Converts between .csv and .sfa based on the file extensions
+	static bool ConvertFile(std::filesystem::path from, std::filesystem::path to, std::string* error = nullptr);
+
+	InputTimeline inputs;
+
+	// Run-length encoded copy of inputs used for playback, only used while it matches inputs
+	InputRuns runs;
+	unsigned int runsRevision = 0;
 
-	map<int, ControllerInput> inputs;
+	// Set when the inputs are played straight from a memory mapped .sfa file
+	std::shared_ptr<const AttemptFileView> mapped;
 private:
+	// inputs, or the timeline rebuilt into scratch when it was compacted or is mapped
+	const InputTimeline& SavedInputs(InputTimeline& scratch) const;
 };
 
@@ -0,0 +1,467 @@
+#include "pch.h"
+#include "AttemptFile.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+static const uint32_t FixedDivisors[] = { 1, 10, 100, 128, 1000, 10000 };
+
+static float GetAxis(const ControllerInput& input, int axis)
+{
+	switch (axis)
+	{
+	case Axis_DodgeForward: return input.DodgeForward;
+	case Axis_DodgeStrafe: return input.DodgeStrafe;
+	case Axis_Pitch: return input.Pitch;
+	case Axis_Roll: return input.Roll;
+	case Axis_Steer: return input.Steer;
+	case Axis_Throttle: return input.Throttle;
+	case Axis_Yaw: return input.Yaw;
+	}
+	return 0;
+}
+
+static void SetAxis(ControllerInput* input, int axis, float value)
+{
+	switch (axis)
+	{
+	case Axis_DodgeForward: input->DodgeForward = value; break;
+	case Axis_DodgeStrafe: input->DodgeStrafe = value; break;
+	case Axis_Pitch: input->Pitch = value; break;
+	case Axis_Roll: input->Roll = value; break;
+	case Axis_Steer: input->Steer = value; break;
+	case Axis_Throttle: input->Throttle = value; break;
+	case Axis_Yaw: input->Yaw = value; break;
+	}
+}
+
+static float DecodeFixed(int32_t q, uint32_t divisor)
+{
+	return static_cast<float>(static_cast<double>(q) / divisor);
+}
+
+// Bitwise, so -0 only matches -0 and is kept as float32
+static bool SameBits(float a, float b)
+{
+	uint32_t x, y;
+	memcpy(&x, &a, sizeof(x));
+	memcpy(&y, &b, sizeof(y));
+	return x == y;
+}
+
+// Returns true if every value in the channel survives a round trip through q / divisor
+static bool FitsFixed(const std::vector<float>& values, uint32_t divisor, int32_t limit)
+{
+	for (float v : values)
+	{
+		if (!std::isfinite(v))
+			return false;
+
+		double q = std::round(static_cast<double>(v) * divisor);
+		if (q < -limit || q > limit)
+			return false;
+		if (!SameBits(DecodeFixed(static_cast<int32_t>(q), divisor), v))
+			return false;
+	}
+	return true;
+}
+
+static AttemptChannelDesc ChooseEncoding(const std::vector<float>& values)
+{
+	AttemptChannelDesc desc{};
+	desc.encoding = static_cast<uint8_t>(ChannelEncoding::Float32);
+	desc.divisor = 0;
+
+	for (uint32_t divisor : FixedDivisors)
+	{
+		if (FitsFixed(values, divisor, INT8_MAX))
+		{
+			desc.encoding = static_cast<uint8_t>(ChannelEncoding::Fixed8);
+			desc.divisor = divisor;
+			return desc;
+		}
+	}
+	for (uint32_t divisor : FixedDivisors)
+	{
+		if (FitsFixed(values, divisor, INT16_MAX))
+		{
+			desc.encoding = static_cast<uint8_t>(ChannelEncoding::Fixed16);
+			desc.divisor = divisor;
+			return desc;
+		}
+	}
+	return desc;
+}
+
+static size_t EncodingWidth(ChannelEncoding encoding)
+{
+	switch (encoding)
+	{
+	case ChannelEncoding::Fixed8: return 1;
+	case ChannelEncoding::Fixed16: return 2;
+	default: return 4;
+	}
+}
+
+static uint32_t AlignUp(size_t value, size_t alignment)
+{
+	return static_cast<uint32_t>((value + alignment - 1) / alignment * alignment);
+}
+
+bool WriteAttemptFile(const InputTimeline& inputs, const std::filesystem::path& filepath, std::string* error)
+{
+	return WriteAttemptFile(inputs, nullptr, filepath, error);
+}
+
+bool WriteAttemptFile(const InputTimeline& inputs, const PhysicsTrack* physics, const std::filesystem::path& filepath, std::string* error)
+{
+	if (physics && physics->empty())
+		physics = nullptr;
+
+	const uint32_t tickCount = static_cast<uint32_t>(inputs.End());
+
+	// Gather each axis so the encoding can be chosen per channel
+	std::vector<float> axisValues[Axis_Count];
+	for (auto& values : axisValues)
+		values.assign(tickCount, 0.0f);
+
+	inputs.ForEach([&](int tick, const ControllerInput& input) {
+		for (int axis = 0; axis < Axis_Count; axis++)
+			axisValues[axis][tick] = GetAxis(input, axis);
+	});
+
+	AttemptFileHeader header{};
+	header.magic = AttemptFileMagic;
+	header.version = physics ? AttemptFilePhysicsVersion : AttemptFileVersion;
+	header.headerSize = sizeof(AttemptFileHeader);
+	header.tickCount = tickCount;
+	header.recordedCount = static_cast<uint32_t>(inputs.size());
+
+	uint32_t offset = AlignUp(sizeof(AttemptFileHeader), 8);
+	header.presenceOffset = offset;
+	offset = AlignUp(offset + (tickCount + 7) / 8, 4);
+	header.buttonsOffset = offset;
+	offset = AlignUp(offset + tickCount, 4);
+
+	for (int axis = 0; axis < Axis_Count; axis++)
+	{
+		AttemptChannelDesc& desc = header.axes[axis];
+		desc = ChooseEncoding(axisValues[axis]);
+		desc.offset = offset;
+		desc.size = static_cast<uint32_t>(tickCount * EncodingWidth(static_cast<ChannelEncoding>(desc.encoding)));
+		offset = AlignUp(offset + desc.size, 4);
+	}
+
+	AttemptPhysicsHeader physicsHeader{};
+	if (physics)
+	{
+		const uint32_t physicsTicks = static_cast<uint32_t>(physics->End());
+		physicsHeader.tickCount = physicsTicks;
+		physicsHeader.recordedCount = static_cast<uint32_t>(physics->size());
+		physicsHeader.locationScale = PhysicsTrack::LocationScale;
+		physicsHeader.velocityScale = PhysicsTrack::VelocityScale;
+		physicsHeader.angularScale = PhysicsTrack::AngularScale;
+		physicsHeader.boostScale = PhysicsTrack::BoostScale;
+
+		header.physicsOffset = offset;
+		offset = AlignUp(offset + sizeof(AttemptPhysicsHeader), 4);
+		physicsHeader.presenceOffset = offset;
+		offset = AlignUp(offset + (physicsTicks + 7) / 8, 4);
+		for (int channel = 0; channel < Phys_Count; channel++)
+		{
+			physicsHeader.channelOffsets[channel] = offset;
+			offset = AlignUp(offset + physicsTicks * sizeof(int16_t), 4);
+		}
+		physicsHeader.boostOffset = offset;
+		offset = AlignUp(offset + physicsTicks, 4);
+		physicsHeader.flagsOffset = offset;
+		offset = AlignUp(offset + physicsTicks, 4);
+	}
+
+	std::vector<unsigned char> buffer(offset, 0);
+
+	inputs.ForEach([&](int tick, const ControllerInput& input) {
+		buffer[header.presenceOffset + tick / 8] |= static_cast<unsigned char>(1 << (tick % 8));
+
+		uint8_t buttons = 0;
+		if (input.ActivateBoost) buttons |= Button_ActivateBoost;
+		if (input.Handbrake) buttons |= Button_Handbrake;
+		if (input.HoldingBoost) buttons |= Button_HoldingBoost;
+		if (input.Jump) buttons |= Button_Jump;
+		if (input.Jumped) buttons |= Button_Jumped;
+		buffer[header.buttonsOffset + tick] = buttons;
+	});
+
+	for (int axis = 0; axis < Axis_Count; axis++)
+	{
+		const AttemptChannelDesc& desc = header.axes[axis];
+		unsigned char* out = buffer.data() + desc.offset;
+
+		for (uint32_t tick = 0; tick < tickCount; tick++)
+		{
+			float v = axisValues[axis][tick];
+			switch (static_cast<ChannelEncoding>(desc.encoding))
+			{
+			case ChannelEncoding::Fixed8:
+			{
+				int8_t q = static_cast<int8_t>(std::round(static_cast<double>(v) * desc.divisor));
+				memcpy(out + tick, &q, sizeof(q));
+				break;
+			}
+			case ChannelEncoding::Fixed16:
+			{
+				int16_t q = static_cast<int16_t>(std::round(static_cast<double>(v) * desc.divisor));
+				memcpy(out + tick * sizeof(q), &q, sizeof(q));
+				break;
+			}
+			default:
+				memcpy(out + tick * sizeof(v), &v, sizeof(v));
+				break;
+			}
+		}
+	}
+
+	if (physics)
+	{
+		memcpy(buffer.data() + header.physicsOffset, &physicsHeader, sizeof(physicsHeader));
+		for (int tick = 0; tick < physics->End(); tick++)
+		{
+			if (physics->Contains(tick))
+				buffer[physicsHeader.presenceOffset + tick / 8] |= static_cast<unsigned char>(1 << (tick % 8));
+		}
+		for (int channel = 0; channel < Phys_Count; channel++)
+			memcpy(buffer.data() + physicsHeader.channelOffsets[channel], physics->Channel(channel), physicsHeader.tickCount * sizeof(int16_t));
+		memcpy(buffer.data() + physicsHeader.boostOffset, physics->Boost(), physicsHeader.tickCount);
+		memcpy(buffer.data() + physicsHeader.flagsOffset, physics->Flags(), physicsHeader.tickCount);
+	}
+
+	const uint32_t payloadStart = AlignUp(sizeof(AttemptFileHeader), 8);
+	header.payloadSize = offset - payloadStart;
+	header.payloadCrc = Crc32(buffer.data() + payloadStart, header.payloadSize);
+	header.headerCrc = Crc32(&header, offsetof(AttemptFileHeader, headerCrc));
+	memcpy(buffer.data(), &header, sizeof(header));
+
+	return WriteWholeFile(filepath, buffer.data(), buffer.size(), error);
+}
+
+bool AttemptFileView::Open(const std::filesystem::path& filepath, std::string* error)
+{
+	header = nullptr;
+	physics = nullptr;
+	if (!file.Open(filepath, error))
+		return false;
+
+	auto fail = [&](const char* message) {
+		if (error) *error = message;
+		file.Close();
+		return false;
+	};
+
+	if (file.Size() < sizeof(AttemptFileHeader))
+		return fail("file is too small to be an attempt");
+
+	const AttemptFileHeader* h = reinterpret_cast<const AttemptFileHeader*>(file.Data());
+	if (h->magic != AttemptFileMagic)
+		return fail("not an attempt file");
+	if (h->version != AttemptFileVersion && h->version != AttemptFilePhysicsVersion)
+		return fail("unsupported attempt file version");
+	if (h->headerSize != sizeof(AttemptFileHeader))
+		return fail("unexpected header size");
+	if (h->headerCrc != Crc32(h, offsetof(AttemptFileHeader, headerCrc)))
+		return fail("header checksum mismatch");
+
+	const size_t payloadStart = AlignUp(sizeof(AttemptFileHeader), 8);
+	if (payloadStart + h->payloadSize > file.Size())
+		return fail("file is truncated");
+	if (h->payloadCrc != Crc32(file.Data() + payloadStart, h->payloadSize))
+		return fail("payload checksum mismatch");
+
+	// Every channel must lie inside the payload
+	const size_t payloadEnd = payloadStart + h->payloadSize;
+	if (h->presenceOffset < payloadStart || static_cast<size_t>(h->presenceOffset) + (h->tickCount + 7) / 8 > payloadEnd ||
+		h->buttonsOffset < payloadStart || static_cast<size_t>(h->buttonsOffset) + h->tickCount > payloadEnd)
+		return fail("channel out of bounds");
+	for (const AttemptChannelDesc& desc : h->axes)
+	{
+		auto encoding = static_cast<ChannelEncoding>(desc.encoding);
+		if (encoding != ChannelEncoding::Float32 && encoding != ChannelEncoding::Fixed8 && encoding != ChannelEncoding::Fixed16)
+			return fail("unknown channel encoding");
+		if (encoding != ChannelEncoding::Float32 && desc.divisor == 0)
+			return fail("invalid channel divisor");
+		if (desc.size < h->tickCount * EncodingWidth(encoding) || desc.offset < payloadStart || static_cast<size_t>(desc.offset) + desc.size > payloadEnd)
+			return fail("channel out of bounds");
+	}
+	if (h->version == AttemptFileVersion && h->physicsOffset != 0)
+		return fail("physics section in a version 1 file");
+
+	if (h->physicsOffset != 0 && !OpenPhysics(h, payloadStart, payloadEnd))
+		return fail("physics section out of bounds");
+
+	header = h;
+	return true;
+}
+
+bool AttemptFileView::OpenPhysics(const AttemptFileHeader* h, size_t payloadStart, size_t payloadEnd)
+{
+	auto inPayload = [&](size_t offset, size_t size) {
+		return offset >= payloadStart && offset + size <= payloadEnd;
+	};
+
+	if (!inPayload(h->physicsOffset, sizeof(AttemptPhysicsHeader)))
+		return false;
+
+	const AttemptPhysicsHeader* p = reinterpret_cast<const AttemptPhysicsHeader*>(file.Data() + h->physicsOffset);
+	if (p->locationScale == 0 || p->velocityScale == 0 || p->angularScale == 0 || p->boostScale == 0)
+		return false;
+	if (!inPayload(p->presenceOffset, (p->tickCount + 7) / 8) || !inPayload(p->boostOffset, p->tickCount) || !inPayload(p->flagsOffset, p->tickCount))
+		return false;
+	for (uint32_t offset : p->channelOffsets)
+	{
+		if (!inPayload(offset, static_cast<size_t>(p->tickCount) * sizeof(int16_t)))
+			return false;
+	}
+
+	physics = p;
+	return true;
+}
+
+bool AttemptFileView::Contains(int tick) const
+{
+	if (!header || tick < 0 || tick >= End())
+		return false;
+
+	return (file.Data()[header->presenceOffset + tick / 8] >> (tick % 8)) & 1;
+}
+
+float AttemptFileView::DecodeAxis(int axis, int tick) const
+{
+	const AttemptChannelDesc& desc = header->axes[axis];
+	const unsigned char* in = file.Data() + desc.offset;
+
+	switch (static_cast<ChannelEncoding>(desc.encoding))
+	{
+	case ChannelEncoding::Fixed8:
+	{
+		int8_t q;
+		memcpy(&q, in + tick, sizeof(q));
+		return DecodeFixed(q, desc.divisor);
+	}
+	case ChannelEncoding::Fixed16:
+	{
+		int16_t q;
+		memcpy(&q, in + tick * sizeof(q), sizeof(q));
+		return DecodeFixed(q, desc.divisor);
+	}
+	default:
+	{
+		float v;
+		memcpy(&v, in + tick * sizeof(v), sizeof(v));
+		return v;
+	}
+	}
+}
+
+bool AttemptFileView::Decode(int tick, ControllerInput* ci) const
+{
+	if (!Contains(tick))
+		return false;
+
+	uint8_t buttons = file.Data()[header->buttonsOffset + tick];
+	ci->ActivateBoost = (buttons & Button_ActivateBoost) != 0;
+	ci->Handbrake = (buttons & Button_Handbrake) != 0;
+	ci->HoldingBoost = (buttons & Button_HoldingBoost) != 0;
+	ci->Jump = (buttons & Button_Jump) != 0;
+	ci->Jumped = (buttons & Button_Jumped) != 0;
+
+	for (int axis = 0; axis < Axis_Count; axis++)
+		SetAxis(ci, axis, DecodeAxis(axis, tick));
+
+	return true;
+}
+
+bool AttemptFileView::ContainsPhysics(int tick) const
+{
+	if (!physics || tick < 0 || tick >= static_cast<int>(physics->tickCount))
+		return false;
+
+	return (file.Data()[physics->presenceOffset + tick / 8] >> (tick % 8)) & 1;
+}
+
+int16_t AttemptFileView::PhysicsValue(int channel, int tick) const
+{
+	int16_t q;
+	memcpy(&q, file.Data() + physics->channelOffsets[channel] + tick * sizeof(q), sizeof(q));
+	return q;
+}
+
+bool AttemptFileView::DecodePhysics(int tick, PhysicsState& state) const
+{
+	if (!ContainsPhysics(tick))
+		return false;
+
+	auto decode = [&](int channel, uint16_t scale) {
+		return PhysicsTrack::Dequantize(PhysicsValue(channel, tick), scale);
+	};
+
+	state.location = Vector(decode(Phys_LocationX, physics->locationScale), decode(Phys_LocationY, physics->locationScale), decode(Phys_LocationZ, physics->locationScale));
+	state.rotation.Pitch = PhysicsValue(Phys_Pitch, tick);
+	state.rotation.Yaw = PhysicsValue(Phys_Yaw, tick);
+	state.rotation.Roll = PhysicsValue(Phys_Roll, tick);
+	state.velocity = Vector(decode(Phys_VelocityX, physics->velocityScale), decode(Phys_VelocityY, physics->velocityScale), decode(Phys_VelocityZ, physics->velocityScale));
+	state.angularVelocity = Vector(decode(Phys_AngularX, physics->angularScale), decode(Phys_AngularY, physics->angularScale), decode(Phys_AngularZ, physics->angularScale));
+	state.boost = static_cast<float>(file.Data()[physics->boostOffset + tick]) / physics->boostScale;
+
+	uint8_t flags = file.Data()[physics->flagsOffset + tick];
+	state.onGround = (flags & PhysicsFlag_OnGround) != 0;
+	state.jumped = (flags & PhysicsFlag_Jumped) != 0;
+	state.dodging = (flags & PhysicsFlag_Dodging) != 0;
+	return true;
+}
+
+void AttemptFileView::CopyPhysicsTo(PhysicsTrack& track) const
+{
+	track.clear();
+	if (!physics)
+		return;
+
+	track.Reserve(static_cast<int>(physics->tickCount));
+
+	// Files written with the current scales are copied without requantizing
+	bool sameScales = physics->locationScale == PhysicsTrack::LocationScale && physics->velocityScale == PhysicsTrack::VelocityScale
+		&& physics->angularScale == PhysicsTrack::AngularScale && physics->boostScale == PhysicsTrack::BoostScale;
+
+	for (int tick = 0; tick < static_cast<int>(physics->tickCount); tick++)
+	{
+		if (!ContainsPhysics(tick))
+			continue;
+
+		if (sameScales)
+		{
+			int16_t values[Phys_Count];
+			for (int channel = 0; channel < Phys_Count; channel++)
+				values[channel] = PhysicsValue(channel, tick);
+			track.RecordRaw(tick, values, file.Data()[physics->boostOffset + tick], file.Data()[physics->flagsOffset + tick]);
+		}
+		else
+		{
+			PhysicsState state;
+			DecodePhysics(tick, state);
+			track.Record(tick, state);
+		}
+	}
+}
+
+void AttemptFileView::CopyTo(InputTimeline& inputs) const
+{
+	inputs.clear();
+	inputs.Reserve(End());
+
+	ControllerInput input;
+	for (int tick = 0; tick < End(); tick++)
+	{
+		if (Decode(tick, &input))
+			inputs.Record(tick, input);
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include "FileIO.h"
+#include "InputTimeline.h"
+#include "PhysicsTrack.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Binary attempt format (.sfa)
+//
+// All values are little-endian. The file is a fixed header followed by a payload
+// of independent channels that can be read in place from a memory mapping:
+//   - presence bitmap, one bit per tick
+//   - buttons, one byte per tick (see AttemptButton)
+//   - one channel per ControllerInput axis
+// Ticks are stored densely from tick 0, so a tick is also its index in every channel.
+//
+// Each axis channel picks its own encoding when written. An axis is stored as
+// a fixed-point integer (value = q / divisor) only if every value in the channel
+// decodes back to the exact same float, otherwise it is stored as raw floats.
+// Conversion from and to CSV is therefore lossless.
+//
+// Version 2 adds an optional physics section in the payload, see AttemptPhysicsHeader.
+// Files without physics are still written as version 1.
+
+constexpr const char* AttemptFileExtension = ".sfa";
+constexpr uint32_t AttemptFileMagic = 0x1A414653; // "SFA\x1A"
+constexpr uint16_t AttemptFileVersion = 1;
+constexpr uint16_t AttemptFilePhysicsVersion = 2;
+
+enum AttemptAxis
+{
+	Axis_DodgeForward,
+	Axis_DodgeStrafe,
+	Axis_Pitch,
+	Axis_Roll,
+	Axis_Steer,
+	Axis_Throttle,
+	Axis_Yaw,
+	Axis_Count
+};
+
+enum AttemptButton : uint8_t
+{
+	Button_ActivateBoost = 1 << 0,
+	Button_Handbrake = 1 << 1,
+	Button_HoldingBoost = 1 << 2,
+	Button_Jump = 1 << 3,
+	Button_Jumped = 1 << 4
+};
+
+enum class ChannelEncoding : uint8_t
+{
+	Float32 = 0,
+	Fixed8 = 1,
+	Fixed16 = 2
+};
+
+#pragma pack(push, 1)
+struct AttemptChannelDesc
+{
+	uint8_t encoding;
+	uint8_t reserved[3];
+	uint32_t divisor;
+	uint32_t offset; // From the start of the file
+	uint32_t size;
+};
+
+struct AttemptFileHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t tickCount;     // Highest recorded tick + 1
+	uint32_t recordedCount; // Number of ticks with an input
+	uint32_t presenceOffset;
+	uint32_t buttonsOffset;
+	AttemptChannelDesc axes[Axis_Count];
+	uint32_t payloadSize;
+	uint32_t payloadCrc;
+	uint32_t physicsOffset; // AttemptPhysicsHeader, 0 if there is none (always 0 in version 1)
+	uint32_t headerCrc; // Over every header byte before this field
+};
+
+// Physics section, the channels are PhysicsTrack's: int16 channels, then boost and flags bytes
+struct AttemptPhysicsHeader
+{
+	uint32_t tickCount;
+	uint32_t recordedCount;
+	uint32_t presenceOffset;
+	uint32_t channelOffsets[Phys_Count];
+	uint32_t boostOffset;
+	uint32_t flagsOffset;
+	uint16_t locationScale;
+	uint16_t velocityScale;
+	uint16_t angularScale;
+	uint16_t boostScale;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AttemptChannelDesc) == 16, "AttemptChannelDesc layout changed");
+static_assert(sizeof(AttemptFileHeader) == 152, "AttemptFileHeader layout changed");
+static_assert(sizeof(AttemptPhysicsHeader) == 76, "AttemptPhysicsHeader layout changed");
+
+// Writes the timeline as a .sfa file, with a physics section if physics is not empty
+bool WriteAttemptFile(const InputTimeline& inputs, const std::filesystem::path& filepath, std::string* error = nullptr);
+bool WriteAttemptFile(const InputTimeline& inputs, const PhysicsTrack* physics, const std::filesystem::path& filepath, std::string* error = nullptr);
+
+// Read-only view of a .sfa file, decoded on demand straight from the mapping
+class AttemptFileView
+{
+public:
+	bool Open(const std::filesystem::path& filepath, std::string* error = nullptr);
+
+	size_t size() const { return header ? header->recordedCount : 0; }
+	bool empty() const { return size() == 0; }
+	int End() const { return header ? static_cast<int>(header->tickCount) : 0; }
+
+	bool Contains(int tick) const;
+	bool Decode(int tick, ControllerInput* ci) const;
+
+	// Decodes every recorded tick into the timeline
+	void CopyTo(InputTimeline& inputs) const;
+
+	bool HasPhysics() const { return physics != nullptr; }
+	bool DecodePhysics(int tick, PhysicsState& state) const;
+	void CopyPhysicsTo(PhysicsTrack& track) const;
+
+private:
+	float DecodeAxis(int axis, int tick) const;
+	bool ContainsPhysics(int tick) const;
+	int16_t PhysicsValue(int channel, int tick) const;
+	bool OpenPhysics(const AttemptFileHeader* h, size_t payloadStart, size_t payloadEnd);
+
+	MappedFile file;
+	const AttemptFileHeader* header = nullptr;
+	const AttemptPhysicsHeader* physics = nullptr;
+};
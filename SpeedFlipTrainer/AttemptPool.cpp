@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "AttemptPool.h"
+
+std::shared_ptr<const Attempt> AttemptPool::Freeze(Attempt& live)
+{
+	std::unique_ptr<Attempt> frozen = Take();
+	std::swap(*frozen, live);
+	live.Clear();
+	frozen->Freeze();
+
+	std::weak_ptr<Spares> pool = spares;
+	return std::shared_ptr<const Attempt>(frozen.release(), [pool](const Attempt* released) {
+		std::unique_ptr<Attempt> attempt(const_cast<Attempt*>(released));
+		if (auto owner = pool.lock())
+		{
+			std::lock_guard<std::mutex> lock(owner->mutex);
+			if (owner->attempts.size() < MaxSpare)
+				owner->attempts.push_back(std::move(attempt));
+		}
+	});
+}
+
+size_t AttemptPool::Spare() const
+{
+	std::lock_guard<std::mutex> lock(spares->mutex);
+	return spares->attempts.size();
+}
+
+std::unique_ptr<Attempt> AttemptPool::Take()
+{
+	{
+		std::lock_guard<std::mutex> lock(spares->mutex);
+		if (!spares->attempts.empty())
+		{
+			std::unique_ptr<Attempt> attempt = std::move(spares->attempts.back());
+			spares->attempts.pop_back();
+			return attempt;
+		}
+	}
+
+	allocated++;
+	return std::make_unique<Attempt>();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Attempt.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Turns finished attempts into shared immutable snapshots and recycles their storage.
+// Freeze swaps the recorded attempt with a spare one, so the live recorder keeps going
+// with already allocated buffers and nothing is copied. Replay, saving and anything else
+// holding the snapshot share it, once the last reference is dropped (on any thread) the
+// attempt comes back as a spare.
+class AttemptPool
+{
+public:
+	// More spares than this are freed instead of kept
+	static constexpr size_t MaxSpare = 4;
+
+	// live is cleared afterwards, an attempt without inputs is frozen as is
+	std::shared_ptr<const Attempt> Freeze(Attempt& live);
+
+	size_t Spare() const;
+	// Snapshots that needed a new attempt because no spare was left
+	size_t Allocated() const { return allocated; }
+
+private:
+	struct Spares
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<Attempt>> attempts;
+	};
+
+	std::unique_ptr<Attempt> Take();
+
+	// Snapshots only hold a weak reference, so they can outlive the pool
+	std::shared_ptr<Spares> spares = std::make_shared<Spares>();
+	size_t allocated = 0;
+};
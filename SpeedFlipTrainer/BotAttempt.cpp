@@ -1,11 +1,10 @@
 #include "pch.h"
 #include "BotAttempt.h"
+#include "FileIO.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
-
-#include <sstream>
-#include <fstream>
+#include <algorithm>
 
 using namespace std;
 
@@ -20,6 +19,7 @@ void BotAttempt::Become26Bot()
 	adjustAmmount = 0.75;
 	adjustDuration = 16;
 	airRollDuration = 40;
+	Compile();
 }
 
 void BotAttempt::Become45Bot()
@@ -33,129 +33,169 @@ void BotAttempt::Become45Bot()
 	adjustAmmount = 0.7;
 	adjustDuration = 16;
 	airRollDuration = 40;
+	Compile();
 }
 
-void BotAttempt::Play(ControllerInput* ci, int tick)
+void BotAttempt::Compile()
 {
-	ci->Throttle = 1;
-	ci->ActivateBoost = 1;
-	ci->HoldingBoost = 1;
-
-	if (tick <= beforeJump)
+	// Phase boundaries, each phase runs up to and including its end tick
+	const int jumpEnd = beforeJump + jumpDuration;
+	const int releaseEnd = jumpEnd + 1;
+	const int dodgeEnd = releaseEnd + cancelSpeed;
+	const int cancelEnd = dodgeEnd + beforeCancelAdjust;
+	const int adjustEnd = cancelEnd + adjustDuration;
+	const int airRollEnd = adjustEnd + airRollDuration;
+
+	const double rads = dodgeAngle * M_PI / 180;
+	const float dodgeSteer = sin(rads);
+	const float dodgePitch = -1 * cos(rads);
+
+	const int tickCount = max(airRollEnd + 2, MinCompiledTicks);
+	inputs.clear();
+	inputs.Reserve(tickCount);
+
+	for (int tick = 0; tick < tickCount; tick++)
 	{
-		ci->Steer = initialSteer;
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
+		// Inputs a phase does not set stay neutral, as if the controller was idle
+		ControllerInput ci;
+		ci.Throttle = 1;
+		ci.ActivateBoost = 1;
+		ci.HoldingBoost = 1;
+
+		if (tick <= beforeJump)
+		{
+			ci.Steer = initialSteer;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+		}
+		else if (tick <= jumpEnd)
+		{
+			// First jump
+			ci.Jump = 1;
+			ci.Jumped = 1;
+
+			ci.Steer = 1;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+		}
+		else if (tick <= releaseEnd)
+		{
+			// Stop jumping
+			ci.Jump = 0;
+			ci.Jumped = 0;
+		}
+		else if (tick <= dodgeEnd)
+		{
+			// Dodge
+			ci.Jump = 1;
+			ci.Jumped = 1;
+
+			ci.Steer = dodgeSteer;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+
+			ci.Pitch = dodgePitch;
+			ci.DodgeForward = -1 * ci.Pitch;
+		}
+		else if (tick <= cancelEnd)
+		{
+			// Cancel flip
+			ci.Jump = 0;
+			ci.Jumped = 0;
+
+			ci.Steer = 0;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+
+			ci.Pitch = 1;
+			ci.DodgeForward = -1;
+		}
+		else if (tick <= adjustEnd)
+		{
+			ci.Steer = -1 * adjustAmmount;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+
+			ci.Pitch = adjustAmmount;
+			ci.DodgeForward = -1 * ci.Pitch;
+		}
+		else if (tick <= airRollEnd)
+		{
+			ci.Steer = 0;
+			ci.Yaw = ci.Steer;
+			ci.DodgeStrafe = ci.Steer;
+
+			ci.Roll = -1;
+
+			ci.Pitch = 1;
+			ci.DodgeForward = -1 * ci.Pitch;
+		}
+		else
+		{
+			ci.Roll = 0;
+
+			ci.Pitch = 0;
+			ci.DodgeForward = 0;
+		}
+
+		inputs.Record(tick, ci);
 	}
-	else if (tick <= beforeJump + jumpDuration)
-	{
-		// First jump
-		ci->Jump = 1;
-		ci->Jumped = 1;
+}
 
-		ci->Steer = 1;
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
-	}
-	else if (tick <= beforeJump + jumpDuration + 1)
-	{
-		// Stop jumping
-		ci->Jump = 0;
-		ci->Jumped = 0;
-	}
-	else if (tick <= beforeJump + jumpDuration + 1 + cancelSpeed)
-	{
-		// Dodge
-		ci->Jump = 1;
-		ci->Jumped = 1;
+void BotAttempt::Play(ControllerInput* ci, int tick)
+{
+	if (inputs.empty() || tick < 0)
+		return;
 
-		double rads = dodgeAngle * M_PI / 180;
+	inputs.Play(ci, min(tick, inputs.End() - 1));
+}
 
-		ci->Steer = sin(rads);
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
+Attempt BotAttempt::ToAttempt() const
+{
+	Attempt a;
+	a.inputs = inputs;
+	return a;
+}
 
-		ci->Pitch = -1 * cos(rads);
-		ci->DodgeForward = -1 * ci->Pitch;
-	}
-	else if (tick <= beforeJump + jumpDuration + 1 + cancelSpeed + beforeCancelAdjust)
+bool BotAttempt::ReadInputsFromFile(std::filesystem::path filepath, ParseError* error)
+{
+	MappedFile file;
+	string message;
+	if (!file.Open(filepath, &message))
 	{
-		// Cancel flip
-		ci->Jump = 0;
-		ci->Jumped = 0;
-
-		ci->Steer = 0;
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
-
-		ci->Pitch = 1;
-		ci->DodgeForward = -1;
+		if (error) *error = ParseError{ 0, 0, message };
+		return false;
 	}
-	else if (tick <= beforeJump + jumpDuration + 1 + cancelSpeed + beforeCancelAdjust + adjustDuration)
-	{
-		ci->Steer = -1 * adjustAmmount;
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
 
-		ci->Pitch = adjustAmmount;
-		ci->DodgeForward = -1 * ci->Pitch;
-	}
-	else if (tick <= beforeJump + jumpDuration + 1 + cancelSpeed + beforeCancelAdjust + adjustDuration + airRollDuration)
-	{
-		ci->Steer = 0;
-		ci->Yaw = ci->Steer;
-		ci->DodgeStrafe = ci->Steer;
+	const char* data = reinterpret_cast<const char*>(file.Data());
+	CsvReader reader(data, data + file.Size());
 
-		ci->Roll = -1;
+	reader.NextRecord(); // skip header line
 
-		ci->Pitch = 1;
-		ci->DodgeForward = -1 * ci->Pitch;
-	}
-	else if (tick > beforeJump + jumpDuration + 1 + cancelSpeed + beforeCancelAdjust + adjustDuration + airRollDuration)
+	// Parse into a copy so a bad file leaves the current bot untouched
+	BotAttempt b = *this;
+	while (reader.NextRecord())
 	{
-		ci->Roll = 0;
-
-		ci->Pitch = 0;
-		ci->DodgeForward = 0;
+		bool ok = reader.Read(b.beforeJump)
+			&& reader.Read(b.initialSteer)
+			&& reader.Read(b.jumpDuration)
+			&& reader.Read(b.dodgeAngle)
+			&& reader.Read(b.cancelSpeed)
+			&& reader.Read(b.beforeCancelAdjust)
+			&& reader.Read(b.adjustAmmount)
+			&& reader.Read(b.adjustDuration)
+			&& reader.Read(b.airRollDuration);
+		if (!ok)
+			break;
 	}
-}
-void BotAttempt::ReadInputsFromFile(std::filesystem::path filepath)
-{
-	ifstream is;
-	is.open(filepath, ios::in); 
-	
-	string line, word;
 
-	getline(is, line); // skip header line
-
-	while (getline(is, line))
+	if (reader.Failed())
 	{
-		stringstream s(line);
-		getline(s, word, ',');
-		beforeJump = stoi(word);
-
-		getline(s, word, ',');
-		initialSteer = stof(word);
-
-		getline(s, word, ',');
-		jumpDuration = stoi(word);
-
-		getline(s, word, ',');
-		dodgeAngle = stoi(word);
-
-		getline(s, word, ',');
-		cancelSpeed = stoi(word);
-
-		getline(s, word, ',');
-		beforeCancelAdjust = stoi(word);
-
-		getline(s, word, ',');
-		adjustAmmount = stof(word);
-
-		getline(s, word, ',');
-		adjustDuration = stoi(word);
-
-		getline(s, word, ',');
-		airRollDuration = stoi(word);
+		if (error) *error = reader.Error();
+		return false;
 	}
+
+	*this = b;
+	Compile();
+	return true;
 }
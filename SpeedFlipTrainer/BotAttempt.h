@@ -1,4 +1,9 @@
 #pragma once
+
+#include "Attempt.h"
+#include "CsvReader.h"
+#include "InputTimeline.h"
+
 class BotAttempt
 {
 public:
@@ -12,8 +17,17 @@ public:
 	int cancelSpeed = 0;
 	int airRollDuration = 0;
 
+	// Bots are compiled into a per-tick input table whenever they are loaded
+	// and cover at least this many ticks, ticks past the end hold the last input
+	static constexpr int MinCompiledTicks = 360;
+	InputTimeline inputs;
+
 	void Become26Bot();
 	void Become45Bot();
-	void ReadInputsFromFile(std::filesystem::path filepath);
+	bool ReadInputsFromFile(std::filesystem::path filepath, ParseError* error = nullptr);
+	void Compile();
 	void Play(ControllerInput* ci, int tick);
+
+	// The compiled table as a regular attempt
+	Attempt ToAttempt() const;
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "CarTickSnapshot.h"
+#include "bakkesmod/wrappers/GameObject/CarWrapper.h"
+#include "bakkesmod/wrappers/GameEvent/ServerWrapper.h"
+
+CarTickSnapshot CarTickSnapshot::Capture(GameWrapper& game, CarWrapper car, bool captureDodge, bool capturePhysics)
+{
+	CarTickSnapshot snap;
+
+	snap.physicsFrame = game.GetEngine().GetPhysicsFrame();
+	snap.wrapperCalls += 2;
+
+	snap.hasPri = !car.GetPRI().IsNull();
+	snap.wrapperCalls++;
+
+	ServerWrapper server = game.GetCurrentGameState();
+	snap.wrapperCalls++;
+	if (!server.IsNull())
+	{
+		snap.hasServer = true;
+		snap.timeRemaining = server.GetGameTimeRemaining();
+		snap.wrapperCalls++;
+	}
+
+	snap.input = car.GetInput();
+	snap.location = car.GetLocation();
+	snap.onGround = car.IsOnGround();
+	snap.jumped = car.GetbJumped();
+	snap.wrapperCalls += 4;
+
+	if (captureDodge)
+	{
+		DodgeComponentWrapper dodge = car.GetDodgeComponent();
+		snap.wrapperCalls++;
+		if (!dodge.IsNull())
+		{
+			snap.hasDodge = true;
+			snap.dodgeTorque = dodge.GetDodgeTorque();
+			snap.dodgeDirection = dodge.GetDodgeDirection();
+			snap.wrapperCalls += 2;
+		}
+	}
+
+	if (capturePhysics)
+	{
+		// Six calls at most, see PhysicsCallBudget
+		PhysicsState& physics = snap.physics;
+		physics.location = snap.location;
+		physics.onGround = snap.onGround;
+		physics.jumped = snap.jumped;
+		physics.rotation = car.GetRotation();
+		physics.velocity = car.GetVelocity();
+		physics.angularVelocity = car.GetAngularVelocity();
+		physics.dodging = car.IsDodging();
+		snap.wrapperCalls += 4;
+
+		BoostWrapper boost = car.GetBoostComponent();
+		snap.wrapperCalls++;
+		if (!boost.IsNull())
+		{
+			physics.boost = boost.GetCurrentBoostAmount();
+			snap.wrapperCalls++;
+		}
+		snap.hasPhysics = true;
+	}
+
+	return snap;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include "PhysicsTrack.h"
+
+class GameWrapper;
+class CarWrapper;
+
+// Everything the trainer reads from the game during one SetVehicleInput tick.
+// Captured once at the top of the hook so measurement code never calls back into the game,
+// and built from recorded attempts by ReplayHarness. Only Capture needs the wrappers.
+struct CarTickSnapshot
+{
+	// Upper bound for wrapper calls made by one tick of the SetVehicleInput hook
+	static constexpr int WrapperCallBudget = 16;
+	// Extra calls allowed when the physics state is captured, Capture never exceeds it
+	static constexpr int PhysicsCallBudget = 6;
+
+	int physicsFrame = 0;
+	bool hasPri = false;
+	bool hasServer = false;
+	float timeRemaining = 0;
+
+	ControllerInput input;
+	Vector location;
+	bool onGround = false;
+	bool jumped = false;
+
+	// Only captured while the attempt is still waiting for its dodge
+	bool hasDodge = false;
+	Vector dodgeTorque;
+	Vector dodgeDirection;
+
+	// Only captured with sf_capture_physics, location, onGround and jumped are copied from above
+	bool hasPhysics = false;
+	PhysicsState physics;
+
+	// Number of calls into the game made for this tick, including the hook's own
+	int wrapperCalls = 0;
+
+	int WrapperCallLimit() const { return WrapperCallBudget + (hasPhysics ? PhysicsCallBudget : 0); }
+
+	static CarTickSnapshot Capture(GameWrapper& game, CarWrapper car, bool captureDodge, bool capturePhysics = false);
+};
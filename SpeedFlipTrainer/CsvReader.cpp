@@ -0,0 +1,154 @@
+#include "pch.h"
+#include "CsvReader.h"
+
+#include <charconv>
+#include <cstring>
+
+std::string ParseError::ToString() const
+{
+	if (line <= 0)
+		return message;
+
+	return "line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message;
+}
+
+CsvReader::CsvReader(const char* begin, const char* end, char delimiter)
+	: cur(begin), end(end), lineStart(begin), recordEnd(begin), delimiter(delimiter)
+{
+}
+
+static bool IsBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool CsvReader::NextRecord()
+{
+	if (failed)
+		return false;
+
+	// Leave the current record, unread trailing fields are ignored
+	if (inRecord)
+		cur = recordEnd < end ? recordEnd + 1 : end;
+
+	while (cur < end)
+	{
+		line++;
+		lineStart = cur;
+		const char* newline = static_cast<const char*>(memchr(cur, '\n', end - cur));
+		recordEnd = newline ? newline : end;
+
+		const char* p = cur;
+		while (p < recordEnd && IsBlank(*p))
+			p++;
+
+		if (p < recordEnd)
+		{
+			inRecord = true;
+			return true;
+		}
+
+		cur = recordEnd < end ? recordEnd + 1 : end;
+	}
+
+	inRecord = false;
+	return false;
+}
+
+bool CsvReader::BeginField(const char*& fieldEnd)
+{
+	if (failed)
+		return false;
+	if (!inRecord || cur > recordEnd)
+		return Fail(recordEnd, "missing field");
+
+	const char* delim = static_cast<const char*>(memchr(cur, delimiter, recordEnd - cur));
+	fieldEnd = delim ? delim : recordEnd;
+
+	while (cur < fieldEnd && IsBlank(*cur))
+		cur++;
+	if (cur < fieldEnd && *cur == '+')
+		cur++;
+	if (cur == fieldEnd)
+		return Fail(cur, "empty field");
+
+	return true;
+}
+
+void CsvReader::EndField(const char* fieldEnd)
+{
+	// Past the delimiter, or one past the end of the record after the last field
+	cur = fieldEnd + 1;
+}
+
+bool CsvReader::Fail(const char* at, const char* message)
+{
+	failed = true;
+	error.line = line;
+	error.column = static_cast<int>(at - lineStart) + 1;
+	error.message = message;
+	return false;
+}
+
+template <typename T>
+static bool ParseField(const char* first, const char* last, T& value, const char*& stop)
+{
+	while (last > first && IsBlank(last[-1]))
+		last--;
+
+	auto result = std::from_chars(first, last, value);
+	stop = result.ptr;
+	return result.ec == std::errc() && result.ptr == last;
+}
+
+bool CsvReader::Read(int& value)
+{
+	const char* fieldEnd;
+	if (!BeginField(fieldEnd))
+		return false;
+
+	const char* stop;
+	if (!ParseField(cur, fieldEnd, value, stop))
+		return Fail(stop, "expected an integer");
+
+	EndField(fieldEnd);
+	return true;
+}
+
+bool CsvReader::Read(double& value)
+{
+	const char* fieldEnd;
+	if (!BeginField(fieldEnd))
+		return false;
+
+	const char* stop;
+	if (!ParseField(cur, fieldEnd, value, stop))
+		return Fail(stop, "expected a number");
+
+	EndField(fieldEnd);
+	return true;
+}
+
+bool CsvReader::Read(float& value)
+{
+	const char* fieldEnd;
+	if (!BeginField(fieldEnd))
+		return false;
+
+	const char* stop;
+	if (!ParseField(cur, fieldEnd, value, stop))
+		return Fail(stop, "expected a number");
+
+	EndField(fieldEnd);
+	return true;
+}
+
+bool CsvReader::Read(bool& value)
+{
+	int i;
+	if (!Read(i))
+		return false;
+
+	value = i != 0;
+	return true;
+}
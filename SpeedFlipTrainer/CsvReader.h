@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+// Location and reason of a failed read. Line and column are 1-based, 0 when not applicable.
+struct ParseError
+{
+	int line = 0;
+	int column = 0;
+	std::string message;
+
+	std::string ToString() const;
+};
+
+// Single-pass reader for delimited records over an in-memory buffer.
+// Fields are converted in place with std::from_chars, so reading never allocates
+// and does not depend on the current locale. The first failure stops the reader
+// and is kept in Error().
+class CsvReader
+{
+public:
+	CsvReader(const char* begin, const char* end, char delimiter = ',');
+
+	// Moves to the start of the next non-empty line, returns false at the end of the buffer or after an error
+	bool NextRecord();
+
+	// Each Read consumes one field of the current record
+	bool Read(int& value);
+	bool Read(double& value);
+	bool Read(float& value);
+	bool Read(bool& value);
+
+	bool Failed() const { return failed; }
+	const ParseError& Error() const { return error; }
+
+private:
+	bool BeginField(const char*& fieldEnd);
+	void EndField(const char* fieldEnd);
+	bool Fail(const char* at, const char* message);
+
+	const char* cur;
+	const char* end;
+	const char* lineStart;
+	const char* recordEnd;
+	char delimiter;
+	int line = 0;
+	bool inRecord = false;
+	bool failed = false;
+	ParseError error;
+};
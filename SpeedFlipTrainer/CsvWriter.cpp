@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "CsvWriter.h"
+#include "FileIO.h"
+
+void CsvWriter::BeginField()
+{
+	if (!firstField)
+		buffer.push_back(delimiter);
+	firstField = false;
+}
+
+void CsvWriter::Write(int value)
+{
+	BeginField();
+	fmt::format_to(buffer, "{}", value);
+}
+
+void CsvWriter::Write(float value)
+{
+	BeginField();
+	size_t start = buffer.size();
+	fmt::format_to(buffer, "{}", value);
+
+	// fmt keeps a ".0" on whole numbers, streams write 1 and 0 and so do the existing files
+	size_t size = buffer.size();
+	if (size - start > 2 && buffer[size - 2] == '.' && buffer[size - 1] == '0')
+		buffer.resize(size - 2);
+}
+
+void CsvWriter::Write(bool value)
+{
+	BeginField();
+	buffer.push_back(value ? '1' : '0');
+}
+
+void CsvWriter::Write(std::string_view text)
+{
+	BeginField();
+	buffer.append(text.data(), text.data() + text.size());
+}
+
+void CsvWriter::EndRecord()
+{
+	buffer.push_back('\n');
+	firstField = true;
+}
+
+bool CsvWriter::WriteTo(const std::filesystem::path& path, std::string* error) const
+{
+	return WriteWholeFile(path, buffer.data(), buffer.size(), error);
+}
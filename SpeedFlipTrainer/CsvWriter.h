@@ -0,0 +1,38 @@
+#pragma once
+
+#include "fmt/format.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Formats delimited records into one growing memory buffer, the counterpart of CsvReader.
+// Numbers are written without the locale and floats with the shortest text that reads
+// back to the same value, so a file written, read and written again is byte identical.
+class CsvWriter
+{
+public:
+	explicit CsvWriter(char delimiter = ',') : delimiter(delimiter) {}
+
+	void Reserve(size_t bytes) { buffer.reserve(bytes); }
+
+	// Each Write appends one field to the current record
+	void Write(int value);
+	void Write(float value);
+	void Write(bool value);
+	void Write(std::string_view text);
+	void EndRecord();
+
+	const char* Data() const { return buffer.data(); }
+	size_t Size() const { return buffer.size(); }
+
+	// Writes the whole buffer with one call, see WriteWholeFile
+	bool WriteTo(const std::filesystem::path& path, std::string* error = nullptr) const;
+
+private:
+	void BeginField();
+
+	fmt::memory_buffer buffer;
+	char delimiter;
+	bool firstField = true;
+};
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "DrawList.h"
+
+#include <algorithm>
+
+DrawList::DrawList()
+{
+	commands.reserve(256);
+	text.reserve(1024);
+	scratch.reserve(128);
+}
+
+uint32_t DrawList::PackColor(const CustomColor& color)
+{
+	return (static_cast<uint32_t>(color.r) << 24) | (static_cast<uint32_t>(color.g) << 16)
+		| (static_cast<uint32_t>(color.b) << 8) | color.GetAlphaChar();
+}
+
+void DrawList::Add(Kind kind, DrawLayer layer, const CustomColor& color, Vector2 a, Vector2 b, float width)
+{
+	Command cmd;
+	cmd.kind = kind;
+	cmd.color = PackColor(color);
+	cmd.a = a;
+	cmd.b = b;
+	cmd.width = width;
+	cmd.textOffset = 0;
+	cmd.textLength = 0;
+
+	// Sorting by color as well would batch more SetColor calls, but could move a fill
+	// under one it overlaps. The record order in the low bits keeps the sort stable.
+	uint64_t order = commands.size();
+	cmd.key = (static_cast<uint64_t>(layer) << 56) | order;
+	commands.push_back(cmd);
+}
+
+void DrawList::FillBox(DrawLayer layer, const CustomColor& color, Vector2 position, Vector2 size)
+{
+	Add(Kind::FillBox, layer, color, position, size, 0);
+}
+
+void DrawList::DrawBox(DrawLayer layer, const CustomColor& color, Vector2 position, Vector2 size)
+{
+	Add(Kind::DrawBox, layer, color, position, size, 0);
+}
+
+void DrawList::DrawLine(DrawLayer layer, const CustomColor& color, Vector2 start, Vector2 end, float width)
+{
+	Add(Kind::Line, layer, color, start, end, width);
+}
+
+void DrawList::DrawString(const CustomColor& color, Vector2 position, std::string_view str)
+{
+	Add(Kind::String, DrawLayer::Text, color, position, Vector2{ 0, 0 }, 0);
+	commands.back().textOffset = static_cast<uint32_t>(text.size());
+	commands.back().textLength = static_cast<uint32_t>(str.size());
+	text.append(str.data(), str.size());
+}
+
+void DrawList::Clear()
+{
+	commands.clear();
+	text.clear();
+}
+
+void DrawList::Sort()
+{
+	// The keys are unique, so an unstable sort gives the same order every frame
+	std::sort(commands.begin(), commands.end(), [](const Command& x, const Command& y) {
+		return x.key < y.key;
+	});
+}
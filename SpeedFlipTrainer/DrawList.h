@@ -0,0 +1,181 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "AllocationCounter.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Structure for custom colors
+struct CustomColor
+{
+	unsigned char r, g, b;
+	float a; // Opacity 0.0f to 1.0f
+
+	CustomColor(unsigned char red = 0, unsigned char green = 0, unsigned char blue = 0, float alpha = 1.0f)
+		: r(red), g(green), b(blue), a(alpha)
+	{
+	}
+
+	// Conversion to LinearColor for BakkesMod drawing functions
+	LinearColor ToLinearColor() const
+	{
+		return LinearColor{ static_cast<float>(r) / 255.0f, static_cast<float>(g) / 255.0f, static_cast<float>(b) / 255.0f, a };
+	}
+
+	// For CanvasWrapper::SetColor(char, char, char, char)
+	unsigned char GetAlphaChar() const
+	{
+		return static_cast<unsigned char>(a * 255.0f);
+	}
+};
+
+// Layers are drawn in this order, inside a layer primitives are drawn in record order.
+enum class DrawLayer : uint8_t
+{
+	Background,
+	Fill,
+	Lines,
+	Overlay,
+	Text,
+};
+
+// Calls made on the canvas by one DrawList::Flush
+struct DrawListStats
+{
+	int commands = 0;
+	int canvasCalls = 0;
+	int colorChanges = 0;
+};
+
+// Records the primitives of a frame and replays them on a canvas in one go.
+// Flush sorts the commands by layer, keeping the record order inside a layer so overlapping
+// primitives stay on top of each other as recorded. SetColor is only called when the color
+// changes, so runs of the same color share one call. The list keeps its memory
+// between frames, recording a frame the size of the last one does not allocate.
+class DrawList
+{
+public:
+	// Reserves room for a typical frame
+	DrawList();
+
+	void FillBox(DrawLayer layer, const CustomColor& color, Vector2 position, Vector2 size);
+	// 1px outline
+	void DrawBox(DrawLayer layer, const CustomColor& color, Vector2 position, Vector2 size);
+	void DrawLine(DrawLayer layer, const CustomColor& color, Vector2 start, Vector2 end, float width);
+	// The text is copied into the list, it does not have to outlive the call
+	void DrawString(const CustomColor& color, Vector2 position, std::string_view text);
+
+	bool IsEmpty() const { return commands.empty(); }
+	int Size() const { return static_cast<int>(commands.size()); }
+	void Clear();
+
+	// Replays the recorded commands on canvas and clears the list.
+	// Canvas is CanvasWrapper in game, anything with the same drawing calls works.
+	template <typename Canvas>
+	DrawListStats Flush(Canvas& canvas);
+
+private:
+	enum class Kind : uint8_t
+	{
+		FillBox,
+		DrawBox,
+		Line,
+		String,
+	};
+
+	struct Command
+	{
+		uint64_t key; // Layer, then record order
+		Kind kind;
+		uint32_t color;
+		Vector2 a;
+		Vector2 b; // Box size or line end
+		float width;
+		uint32_t textOffset;
+		uint32_t textLength;
+	};
+
+	static uint32_t PackColor(const CustomColor& color);
+	void Add(Kind kind, DrawLayer layer, const CustomColor& color, Vector2 a, Vector2 b, float width);
+	void Sort();
+
+	std::vector<Command> commands;
+	std::string text; // Characters of every DrawString, commands refer to ranges of it
+	std::string scratch;
+};
+
+// Drop-in canvas that only counts the calls made on it, to check how many calls a frame makes
+struct CountingCanvas
+{
+	int setColor = 0;
+	int setPosition = 0;
+	int fillBox = 0;
+	int drawBox = 0;
+	int drawLine = 0;
+	int drawString = 0;
+
+	void SetColor(char, char, char, char) { setColor++; }
+	void SetPosition(Vector2) { setPosition++; }
+	void FillBox(Vector2) { fillBox++; }
+	void DrawBox(Vector2) { drawBox++; }
+	void DrawLine(Vector2, Vector2, float) { drawLine++; }
+	void DrawString(const std::string&) { drawString++; }
+
+	int Total() const { return setColor + setPosition + fillBox + drawBox + drawLine + drawString; }
+};
+
+template <typename Canvas>
+DrawListStats DrawList::Flush(Canvas& canvas)
+{
+	DrawListStats stats;
+	stats.commands = Size();
+	Sort();
+
+	bool hasColor = false;
+	uint32_t currentColor = 0;
+	for (const Command& cmd : commands)
+	{
+		if (!hasColor || cmd.color != currentColor)
+		{
+			canvas.SetColor(static_cast<char>(cmd.color >> 24), static_cast<char>(cmd.color >> 16),
+				static_cast<char>(cmd.color >> 8), static_cast<char>(cmd.color));
+			currentColor = cmd.color;
+			hasColor = true;
+			stats.colorChanges++;
+			stats.canvasCalls++;
+		}
+
+		switch (cmd.kind)
+		{
+		case Kind::FillBox:
+			canvas.SetPosition(cmd.a);
+			canvas.FillBox(cmd.b);
+			stats.canvasCalls += 2;
+			break;
+		case Kind::DrawBox:
+			canvas.SetPosition(cmd.a);
+			canvas.DrawBox(cmd.b);
+			stats.canvasCalls += 2;
+			break;
+		case Kind::Line:
+			canvas.DrawLine(cmd.a, cmd.b, cmd.width);
+			stats.canvasCalls++;
+			break;
+		case Kind::String:
+		{
+			scratch.assign(text, cmd.textOffset, cmd.textLength);
+			canvas.SetPosition(cmd.a);
+			AllocationCounter::Exclude sdkCopy;
+			canvas.DrawString(scratch);
+			stats.canvasCalls += 2;
+			break;
+		}
+		}
+	}
+
+	Clear();
+	return stats;
+}
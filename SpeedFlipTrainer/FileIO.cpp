@@ -0,0 +1,257 @@
+#include "pch.h"
+#include "FileIO.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Next to the target so the rename stays on one volume. Unique per call, so two workers
+// saving the same file never write the same temporary. Kept a native string, a path would
+// allocate again for its components.
+static std::filesystem::path::string_type TemporaryPath(const std::filesystem::path& path)
+{
+	static std::atomic<uint32_t> counter{ 0 };
+	char suffix[24];
+	int length = snprintf(suffix, sizeof(suffix), ".%u.tmp", counter.fetch_add(1, std::memory_order_relaxed));
+
+	std::filesystem::path::string_type temporary;
+	temporary.reserve(path.native().size() + length);
+	temporary = path.native();
+	temporary.append(suffix, suffix + length);
+	return temporary;
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+#ifdef _WIN32
+		std::swap(file, other.file);
+		std::swap(mapping, other.mapping);
+#else
+		std::swap(fd, other.fd);
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path, std::string* error)
+{
+	Close();
+
+	// FILE_SHARE_DELETE lets WriteWholeFile rename a new version over a mapped file
+	HANDLE h = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (h == INVALID_HANDLE_VALUE)
+	{
+		if (error) *error = "could not open file";
+		return false;
+	}
+	file = h;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(h, &fileSize) || fileSize.QuadPart == 0)
+	{
+		if (error) *error = "file is empty";
+		Close();
+		return false;
+	}
+
+	mapping = CreateFileMappingW(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		if (error) *error = "could not create file mapping";
+		Close();
+		return false;
+	}
+
+	data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		if (error) *error = "could not map file";
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file)
+		CloseHandle(file);
+
+	data = nullptr;
+	size = 0;
+	mapping = nullptr;
+	file = nullptr;
+}
+
+bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size, std::string* error)
+{
+	std::filesystem::path::string_type temporary = TemporaryPath(path);
+	HANDLE h = CreateFileW(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (h == INVALID_HANDLE_VALUE)
+	{
+		if (error) *error = "could not open file for writing";
+		return false;
+	}
+
+	DWORD written = 0;
+	bool ok = WriteFile(h, data, static_cast<DWORD>(size), &written, nullptr) && written == size;
+	ok = CloseHandle(h) && ok;
+	if (!ok)
+	{
+		if (error) *error = "could not write file";
+		DeleteFileW(temporary.c_str());
+		return false;
+	}
+
+	// The old file stays whole until the new one replaces it, a mapping of it keeps its bytes
+	if (!MoveFileExW(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+	{
+		if (error) *error = "could not replace file";
+		DeleteFileW(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path, std::string* error)
+{
+	Close();
+
+	fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		if (error) *error = "could not open file";
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		if (error) *error = "file is empty";
+		Close();
+		return false;
+	}
+
+	void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		if (error) *error = "could not map file";
+		Close();
+		return false;
+	}
+	data = static_cast<const unsigned char*>(p);
+	size = static_cast<size_t>(st.st_size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data)
+		munmap(const_cast<unsigned char*>(data), size);
+	if (fd >= 0)
+		close(fd);
+
+	data = nullptr;
+	size = 0;
+	fd = -1;
+}
+
+bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size, std::string* error)
+{
+	std::filesystem::path::string_type temporary = TemporaryPath(path);
+	int out = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (out < 0)
+	{
+		if (error) *error = "could not open file for writing";
+		return false;
+	}
+
+	// write only returns early on signals or full disks, loop so a short write is not lost
+	const char* p = static_cast<const char*>(data);
+	size_t left = size;
+	while (left > 0)
+	{
+		ssize_t n = write(out, p, left);
+		if (n <= 0)
+			break;
+		p += n;
+		left -= static_cast<size_t>(n);
+	}
+
+	bool ok = close(out) == 0 && left == 0;
+	if (!ok)
+	{
+		if (error) *error = "could not write file";
+		unlink(temporary.c_str());
+		return false;
+	}
+
+	// The old file stays whole until the new one replaces it, a mapping of it keeps its bytes
+	if (rename(temporary.c_str(), path.c_str()) != 0)
+	{
+		if (error) *error = "could not replace file";
+		unlink(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+#endif
+
+static std::array<uint32_t, 256> MakeCrc32Table()
+{
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		uint32_t c = i;
+		for (int k = 0; k < 8; k++)
+			c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		table[i] = c;
+	}
+	return table;
+}
+
+uint32_t Crc32(const void* data, size_t size, uint32_t crc)
+{
+	static const std::array<uint32_t, 256> table = MakeCrc32Table();
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++)
+		crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Read-only memory mapping of a whole file.
+// The mapping stays valid until Close() or destruction.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	bool Open(const std::filesystem::path& path, std::string* error = nullptr);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+	const unsigned char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const unsigned char* data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+};
+
+// Writes size bytes of data to a temporary file next to path in a single write call, then
+// renames it over path. Readers, including a MappedFile of the old file, never see a
+// truncated or partly written file.
+bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size, std::string* error = nullptr);
+
+// Standard CRC-32 (IEEE 802.3), pass the previous result to checksum in chunks
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "fmt/core.h"
+
+#include <string_view>
+
+// Fixed capacity string formatted on the stack, for text that is rebuilt every frame.
+// Output longer than the capacity is cut off instead of allocating.
+template <size_t Capacity>
+class FixedString
+{
+public:
+	FixedString() = default;
+
+	template <typename S, typename... Args>
+	explicit FixedString(const S& format, Args&&... args)
+	{
+		auto result = fmt::format_to_n(data, Capacity, format, std::forward<Args>(args)...);
+		length = result.size < Capacity ? result.size : Capacity;
+	}
+
+	std::string_view View() const { return std::string_view(data, length); }
+	size_t Size() const { return length; }
+
+private:
+	char data[Capacity];
+	size_t length = 0;
+};
@@ -0,0 +1,271 @@
+#include "pch.h"
+#include "AsyncLogger.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// sf_async_logger_test
+// Fills the ring past Capacity, before the logger runs and while its sink is blocked, and
+// checks that the dropped records are reported once ahead of the next line. Stop has to
+// write every record pushed before it. Lines handed to a LogLineQueue reach their sink only
+// on the thread that ticks, the way SpeedFlipTrainer writes to the console.
+
+namespace
+{
+	struct Line
+	{
+		LogLevel level;
+		std::string text;
+		std::thread::id thread;
+	};
+
+	// Sink of a test, it can hold the logger thread inside the first line it gets
+	struct Collector
+	{
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::vector<Line> lines;
+		bool blockFirst = false;
+		bool entered = false;
+		bool released = false;
+
+		AsyncLogger::Sink Sink()
+		{
+			return [this](LogLevel level, const std::string& text) {
+				std::unique_lock<std::mutex> lock(mutex);
+				lines.push_back(Line{ level, text, std::this_thread::get_id() });
+				if (blockFirst && !entered)
+				{
+					entered = true;
+					changed.notify_all();
+					changed.wait(lock, [this] { return released; });
+				}
+			};
+		}
+
+		void WaitUntilBlocked()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			changed.wait(lock, [this] { return entered; });
+		}
+
+		void Release()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			released = true;
+			changed.notify_all();
+		}
+	};
+
+	std::string DroppedLine(int count)
+	{
+		return "Log buffer full, " + std::to_string(count) + " lines dropped";
+	}
+
+	void CheckNumbered(const std::vector<Line>& lines, size_t first, int from, int count, const char* when)
+	{
+		if (lines.size() < first + count)
+		{
+			SF_CHECK(false, "%s: %zu lines, expected at least %zu", when, lines.size(), first + count);
+			return;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			std::string expected = "line " + std::to_string(from + i);
+			if (lines[first + i].text != expected)
+			{
+				SF_CHECK(false, "%s: line %zu is \"%s\" instead of \"%s\"", when, first + i, lines[first + i].text.c_str(), expected.c_str());
+				return;
+			}
+		}
+	}
+
+	// Nothing drains the ring before Start, everything past Capacity is dropped
+	void TestOverflowBeforeStart()
+	{
+		auto logger = std::make_unique<AsyncLogger>();
+		constexpr int Extra = 100;
+		for (int i = 0; i < static_cast<int>(AsyncLogger::Capacity) + Extra; i++)
+			logger->Push(LogLevel::Info, FMT_STRING("line {}"), i);
+		SF_CHECK(logger->Dropped() == Extra, "%llu records dropped instead of %d", static_cast<unsigned long long>(logger->Dropped()), Extra);
+
+		Collector collector;
+		logger->Start(collector.Sink());
+		logger->Stop();
+
+		std::vector<Line>& lines = collector.lines;
+		SF_CHECK(lines.size() == AsyncLogger::Capacity + 1, "%zu lines written", lines.size());
+		SF_CHECK(!lines.empty() && lines[0].text == DroppedLine(Extra) && lines[0].level == LogLevel::Warning,
+			"the drop report is \"%s\"", lines.empty() ? "" : lines[0].text.c_str());
+		CheckNumbered(lines, 1, 0, static_cast<int>(AsyncLogger::Capacity), "before start");
+
+		// The drops were reported, the next run has nothing to add
+		lines.clear();
+		logger->PushText(LogLevel::Error, "text line");
+		logger->Start(collector.Sink());
+		logger->Stop();
+		SF_CHECK(lines.size() == 1 && lines[0].text == "text line" && lines[0].level == LogLevel::Error, "the drop report was repeated");
+	}
+
+	// While the sink holds the logger thread the ring fills up, the report comes with the next line
+	void TestOverflowWhileRunning()
+	{
+		auto logger = std::make_unique<AsyncLogger>();
+		Collector collector;
+		collector.blockFirst = true;
+		logger->Start(collector.Sink());
+
+		logger->Push(LogLevel::Info, FMT_STRING("line {}"), 0);
+		collector.WaitUntilBlocked();
+
+		// Line 0 left the ring, so it holds Capacity more
+		constexpr int Extra = 50;
+		for (int i = 1; i <= static_cast<int>(AsyncLogger::Capacity) + Extra; i++)
+			logger->Push(LogLevel::Info, FMT_STRING("line {}"), i);
+		SF_CHECK(logger->Dropped() == Extra, "%llu records dropped instead of %d", static_cast<unsigned long long>(logger->Dropped()), Extra);
+
+		collector.Release();
+		logger->Stop();
+
+		std::vector<Line>& lines = collector.lines;
+		SF_CHECK(lines.size() == AsyncLogger::Capacity + 2, "%zu lines written", lines.size());
+		SF_CHECK(lines.size() > 1 && lines[0].text == "line 0" && lines[1].text == DroppedLine(Extra),
+			"the drop report is not the line after the blocked one");
+		CheckNumbered(lines, 2, 1, static_cast<int>(AsyncLogger::Capacity), "while running");
+	}
+
+	// Records pushed right before Stop, from several threads, are all written before it returns
+	void TestStopDrains()
+	{
+		auto logger = std::make_unique<AsyncLogger>();
+		Collector collector;
+		logger->Start(collector.Sink());
+
+		constexpr int Threads = 4;
+		constexpr int PerThread = 200; // Fits the ring, nothing is dropped
+		std::vector<std::thread> producers;
+		for (int t = 0; t < Threads; t++)
+			producers.emplace_back([&logger, t] {
+				for (int i = 0; i < PerThread; i++)
+					logger->Push(LogLevel::Info, FMT_STRING("thread {} line {}"), t, i);
+			});
+		for (std::thread& producer : producers)
+			producer.join();
+		logger->Stop();
+
+		size_t written = collector.lines.size();
+		SF_CHECK(logger->Dropped() == 0, "records were dropped");
+		SF_CHECK(written == Threads * PerThread, "%zu of %d records written by Stop", written, Threads * PerThread);
+
+		// Each thread's lines in the order it pushed them
+		int next[Threads] = {};
+		for (const Line& line : collector.lines)
+		{
+			int t = -1, i = -1;
+			if (sscanf(line.text.c_str(), "thread %d line %d", &t, &i) != 2 || t < 0 || t >= Threads || i != next[t])
+			{
+				SF_CHECK(false, "line \"%s\" out of order", line.text.c_str());
+				break;
+			}
+			next[t]++;
+		}
+
+		// Stopped, a record stays in the ring until the next Start and the old sink is gone
+		logger->Push(LogLevel::Info, FMT_STRING("line {}"), 7);
+		std::this_thread::sleep_for(std::chrono::milliseconds(30));
+		SF_CHECK(collector.lines.size() == written, "a record pushed after Stop was written");
+		SF_CHECK(!logger->IsRunning(), "the logger runs after Stop");
+
+		Collector restarted;
+		logger->Start(restarted.Sink());
+		logger->Stop();
+		SF_CHECK(restarted.lines.size() == 1 && restarted.lines[0].text == "line 7", "the record pushed while stopped was not written on restart");
+	}
+
+	// Stands in for gameWrapper->Execute
+	struct FakeGameThread
+	{
+		std::mutex mutex;
+		std::vector<LogLineQueue::Job> queued;
+
+		void Execute(LogLineQueue::Job job)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			queued.push_back(std::move(job));
+		}
+
+		size_t Queued()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return queued.size();
+		}
+
+		void Tick()
+		{
+			std::vector<LogLineQueue::Job> jobs;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs.swap(queued);
+			}
+			for (LogLineQueue::Job& job : jobs)
+				job();
+		}
+	};
+
+	void TestLinesOnGameThread()
+	{
+		FakeGameThread game;
+		Collector console;
+		{
+			LogLineQueue queue(console.Sink());
+			queue.SetDispatcher([&game](LogLineQueue::Job job) { game.Execute(std::move(job)); });
+
+			auto logger = std::make_unique<AsyncLogger>();
+			logger->Start([&queue](LogLevel level, const std::string& text) { queue.Push(level, text); });
+			for (int i = 0; i < 300; i++)
+				logger->Push(LogLevel::Info, FMT_STRING("line {}"), i);
+			logger->Stop();
+
+			// Formatted and queued, none written and one call dispatched per batch
+			SF_CHECK(console.lines.empty(), "%zu lines reached the console from the logger thread", console.lines.size());
+			SF_CHECK(queue.Pending() == 300, "%zu of 300 lines queued", queue.Pending());
+			SF_CHECK(game.Queued() >= 1 && game.Queued() < 300, "%zu calls dispatched for 300 lines", game.Queued());
+
+			game.Tick();
+			SF_CHECK(queue.Pending() == 0, "%zu lines left after the tick", queue.Pending());
+			CheckNumbered(console.lines, 0, 0, 300, "game thread");
+			for (const Line& line : console.lines)
+			{
+				if (line.thread != std::this_thread::get_id())
+				{
+					SF_CHECK(false, "\"%s\" was written off the game thread", line.text.c_str());
+					break;
+				}
+			}
+
+			// The next line dispatches again, RunPending writes it when the plugin unloads
+			queue.Push(LogLevel::Info, "line 300");
+			SF_CHECK(game.Queued() == 1, "a line after the tick did not dispatch a call");
+			queue.RunPending();
+			SF_CHECK(console.lines.size() == 301 && console.lines.back().text == "line 300", "RunPending did not write the last line");
+		}
+
+		// The queue is gone, the call still queued on the game thread must not touch it
+		game.Tick();
+		SF_CHECK(console.lines.size() == 301, "a dispatched call wrote after the queue was destroyed");
+	}
+}
+
+int main()
+{
+	TestOverflowBeforeStart();
+	TestOverflowWhileRunning();
+	TestStopDrains();
+	TestLinesOnGameThread();
+	return Headless::TestResult();
+}
@@ -0,0 +1,214 @@
+#include "pch.h"
+#include "Attempt.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// sf_attempt_file_test <RecordedFlips dir>
+// Rewrites every recorded attempt csv -> csv and csv -> sfa -> csv and checks the output is
+// byte-identical, reloads random axis values exactly, then round trips an attempt whose axes
+// hold -0, which has to stay -0. Saving over a .sfa that is still mapped must leave the
+// mapped attempt playing its old inputs.
+
+namespace
+{
+	std::string ReadBytes(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::ostringstream bytes;
+		bytes << in.rdbuf();
+		return bytes.str();
+	}
+
+	// from -> .sfa -> .csv, returns the final csv
+	std::string RoundTrip(const std::filesystem::path& from, const std::filesystem::path& work)
+	{
+		std::filesystem::path sfa = work / (from.stem().string() + AttemptFileExtension);
+		std::filesystem::path csv = work / (from.stem().string() + ".roundtrip.csv");
+		std::string error;
+		SF_CHECK(Attempt::ConvertFile(from, sfa, &error), "%s to .sfa: %s", from.string().c_str(), error.c_str());
+		SF_CHECK(Attempt::ConvertFile(sfa, csv, &error), "%s back to .csv: %s", from.string().c_str(), error.c_str());
+		return ReadBytes(csv);
+	}
+
+	// from -> Attempt -> .csv, returns the written csv
+	std::string Rewrite(const std::filesystem::path& from, const std::filesystem::path& work)
+	{
+		std::filesystem::path csv = work / (from.stem().string() + ".rewritten.csv");
+		Attempt attempt;
+		ParseError parseError;
+		std::string error;
+		SF_CHECK(attempt.ReadInputsFromFile(from, &parseError), "%s: %s", from.string().c_str(), parseError.ToString().c_str());
+		SF_CHECK(attempt.WriteInputsToFile(csv, &error), "%s: %s", csv.string().c_str(), error.c_str());
+		return ReadBytes(csv);
+	}
+
+	void TestRecordedFlips(const std::filesystem::path& dir, const std::filesystem::path& work)
+	{
+		int files = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(dir))
+		{
+			if (entry.path().extension() != ".csv")
+				continue;
+			files++;
+			std::string original = ReadBytes(entry.path());
+			SF_CHECK(Rewrite(entry.path(), work) == original, "%s changed after reading and writing it again", entry.path().filename().string().c_str());
+			SF_CHECK(RoundTrip(entry.path(), work) == original, "%s changed after csv -> sfa -> csv", entry.path().filename().string().c_str());
+		}
+		SF_CHECK(files > 0, "no .csv files in %s", dir.string().c_str());
+	}
+
+	// Axis values with every bit of the mantissa in use have to come back exactly
+	void TestRandomValues(const std::filesystem::path& work)
+	{
+		constexpr int Ticks = 20000;
+		uint32_t state = 2024;
+		auto next = [&state] {
+			state = state * 1664525u + 1013904223u;
+			return static_cast<float>(state >> 8) / 8388608.0f - 1.0f;
+		};
+
+		std::vector<ControllerInput> written(Ticks);
+		Attempt attempt;
+		for (int tick = 0; tick < Ticks; tick++)
+		{
+			ControllerInput& input = written[tick];
+			input.Throttle = next();
+			input.Steer = next();
+			input.Pitch = next();
+			input.Yaw = next();
+			input.Roll = next();
+			input.DodgeForward = next();
+			input.DodgeStrafe = next();
+			input.Jump = tick % 3 == 0;
+			input.ActivateBoost = tick % 5 == 0;
+			attempt.Record(tick, input);
+		}
+
+		std::filesystem::path csv = work / "random_values.csv";
+		std::string error;
+		SF_CHECK(attempt.WriteInputsToFile(csv, &error), "%s", error.c_str());
+
+		Attempt loaded;
+		SF_CHECK(loaded.ReadInputsFromFile(csv), "cannot read %s", csv.string().c_str());
+		loaded.Freeze();
+		InputRuns::Cursor cursor;
+		int mismatches = 0;
+		for (int tick = 0; tick < Ticks; tick++)
+		{
+			ControllerInput input;
+			loaded.Play(&input, tick, cursor);
+			const ControllerInput& expected = written[tick];
+			if (input.Throttle != expected.Throttle || input.Steer != expected.Steer || input.Pitch != expected.Pitch
+				|| input.Yaw != expected.Yaw || input.Roll != expected.Roll || input.DodgeForward != expected.DodgeForward
+				|| input.DodgeStrafe != expected.DodgeStrafe || input.Jump != expected.Jump || input.ActivateBoost != expected.ActivateBoost)
+				mismatches++;
+		}
+		SF_CHECK(mismatches == 0, "%d of %d random ticks read back different values", mismatches, Ticks);
+	}
+
+	void TestNegativeZero(const std::filesystem::path& work)
+	{
+		Attempt attempt;
+		for (int tick = 0; tick < 32; tick++)
+		{
+			ControllerInput input;
+			input.Throttle = 1.0f;
+			input.DodgeForward = tick % 2 ? -0.0f : 0.0f;
+			input.Steer = tick < 16 ? -0.0f : 0.5f;
+			attempt.Record(tick, input);
+		}
+
+		std::filesystem::path csv = work / "negative_zero.csv";
+		std::string error;
+		SF_CHECK(attempt.WriteInputsToFile(csv, &error), "%s", error.c_str());
+		std::string original = ReadBytes(csv);
+		SF_CHECK(original.find("-0") != std::string::npos, "the csv does not contain -0");
+		SF_CHECK(RoundTrip(csv, work) == original, "-0 changed after csv -> sfa -> csv");
+
+		Attempt mapped;
+		SF_CHECK(mapped.ReadInputsFromFile(work / ("negative_zero" + std::string(AttemptFileExtension))), "cannot read the .sfa");
+		mapped.Freeze();
+		InputRuns::Cursor cursor;
+		for (int tick = 0; tick < 32; tick++)
+		{
+			ControllerInput input;
+			mapped.Play(&input, tick, cursor);
+			SF_CHECK(std::signbit(input.DodgeForward) == (tick % 2 == 1), "DodgeForward sign at tick %d", tick);
+			SF_CHECK(std::signbit(input.Steer) == (tick < 16), "Steer sign at tick %d", tick);
+		}
+	}
+
+	Attempt Steering(float steer, int ticks)
+	{
+		Attempt attempt;
+		for (int tick = 0; tick < ticks; tick++)
+		{
+			ControllerInput input;
+			input.Throttle = 1.0f;
+			input.Steer = steer;
+			attempt.Record(tick, input);
+		}
+		return attempt;
+	}
+
+	// The attempt keeps its .sfa mapped, truncating the file in place would cut the mapping short
+	void TestReplaceMappedFile(const std::filesystem::path& work)
+	{
+		std::filesystem::path sfa = work / ("replaced" + std::string(AttemptFileExtension));
+		std::string error;
+		SF_CHECK(Steering(0.25f, 600).WriteBinaryFile(sfa, &error), "%s", error.c_str());
+
+		Attempt mapped;
+		SF_CHECK(mapped.ReadInputsFromFile(sfa), "cannot read the .sfa");
+		mapped.Freeze();
+
+		SF_CHECK(Steering(-0.75f, 10).WriteBinaryFile(sfa, &error), "cannot save over a mapped file: %s", error.c_str());
+
+		InputRuns::Cursor cursor;
+		int wrong = 0;
+		for (int tick = 0; tick < 600; tick++)
+		{
+			ControllerInput input;
+			mapped.Play(&input, tick, cursor);
+			if (input.Steer != 0.25f)
+				wrong++;
+		}
+		SF_CHECK(wrong == 0, "%d of 600 ticks of the mapped attempt changed when the file was replaced", wrong);
+
+		Attempt reloaded;
+		SF_CHECK(reloaded.ReadInputsFromFile(sfa), "cannot read the replaced .sfa");
+		reloaded.Freeze();
+		ControllerInput input;
+		InputRuns::Cursor reloadedCursor;
+		reloaded.Play(&input, 5, reloadedCursor);
+		SF_CHECK(input.Steer == -0.75f, "the replaced .sfa steers %g", input.Steer);
+
+		for (const auto& entry : std::filesystem::directory_iterator(work))
+			SF_CHECK(entry.path().extension() != ".tmp", "%s was left behind", entry.path().filename().string().c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: sf_attempt_file_test <RecordedFlips dir>\n");
+		return 2;
+	}
+
+	std::filesystem::path work = std::filesystem::temp_directory_path() / "sf_attempt_file_test";
+	std::filesystem::create_directories(work);
+
+	TestRecordedFlips(argv[1], work);
+	TestRandomValues(work);
+	TestNegativeZero(work);
+	TestReplaceMappedFile(work);
+
+	std::error_code ignored;
+	std::filesystem::remove_all(work, ignored);
+	return Headless::TestResult();
+}
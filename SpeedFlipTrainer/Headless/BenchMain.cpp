@@ -0,0 +1,711 @@
+#include "pch.h"
+#include "FakeGame.h"
+#include "AllocationCounter.h"
+#include "BotAttempt.h"
+#include "LatencyHistogram.h"
+#include "Projection.h"
+#include "RenderMeter.h"
+#include "ScalarMath.h"
+#include "TrainerMath.h"
+#include "TrainerSession.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// sf_bench [--quick] [--json <file>] [--baseline <file>] [--write-baseline <file>]
+//          [--tolerance <fraction>] [--ignore-time] [--filter <text>] [--flips <dir>]
+// Times the trainer's hot paths on the headless core and reports ns and heap allocations
+// per operation. With --baseline a case fails when it allocates more than recorded, or is
+// slower than the recorded time by more than the tolerance (0.25 by default). Recorded times
+// only mean something on the machine that wrote them, --ignore-time checks allocations only.
+// A baseline line may end with an absolute ns/op limit, checked unless --ignore-time is given
+// whatever time was recorded. --write-baseline keeps the limits of the file it overwrites.
+// --flips is the RecordedFlips directory, by default the one of the source tree.
+// Exits with 1 if any case regressed.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Results the compiler must not optimize away
+	volatile float sink;
+
+	struct BenchResult
+	{
+		std::string name;
+		const char* unit = "tick";
+		uint64_t ops = 0;
+		double nsPerOp = 0;
+		double allocsPerOp = 0;
+	};
+
+	struct BenchOptions
+	{
+		bool quick = false;
+		std::string filter;
+		std::filesystem::path flips = SF_RECORDED_FLIPS_DIR;
+	};
+
+	// Calls iteration() (which does opsPerIteration operations) until the time budget is used,
+	// five times over, and keeps the fastest round. The first call is a warm-up so buffers that
+	// are kept between calls are already allocated.
+	template <typename Fn>
+	BenchResult Run(const BenchOptions& options, const char* name, const char* unit, int opsPerIteration, Fn&& iteration)
+	{
+		BenchResult result;
+		result.name = name;
+		result.unit = unit;
+
+		iteration();
+
+		auto budget = std::chrono::milliseconds(options.quick ? 10 : 100);
+		double best = -1;
+		for (int round = 0; round < 5; round++)
+		{
+			uint64_t iterations = 0;
+			AllocationScope allocations;
+			auto start = Clock::now();
+			auto elapsed = Clock::duration::zero();
+			do
+			{
+				iteration();
+				iterations++;
+				elapsed = Clock::now() - start;
+			} while (elapsed < budget);
+
+			uint64_t ops = iterations * opsPerIteration;
+			double ns = std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+			if (best < 0 || ns < best)
+			{
+				best = ns;
+				result.ops = ops;
+				result.nsPerOp = ns;
+				result.allocsPerOp = static_cast<double>(allocations.Allocations()) / ops;
+			}
+		}
+		return result;
+	}
+
+	// Ticks of the -26 bot, used as the player's input wherever a tick stream is needed
+	std::vector<ControllerInput> BotInputs()
+	{
+		BotAttempt bot;
+		bot.Become26Bot();
+		std::vector<ControllerInput> inputs(BotAttempt::MinCompiledTicks);
+		for (int tick = 0; tick < static_cast<int>(inputs.size()); tick++)
+			bot.Play(&inputs[tick], tick);
+		return inputs;
+	}
+
+	// What CarTickSnapshot::Capture would return for a car driving inputs straight ahead
+	std::vector<CarTickSnapshot> Snapshots(const std::vector<ControllerInput>& inputs)
+	{
+		std::vector<CarTickSnapshot> snaps(inputs.size());
+		bool jumped = false;
+		for (size_t tick = 0; tick < inputs.size(); tick++)
+		{
+			CarTickSnapshot& snap = snaps[tick];
+			snap.physicsFrame = static_cast<int>(tick) + 1;
+			snap.hasPri = true;
+			snap.hasServer = true;
+			snap.timeRemaining = 300.0f - (tick + 1) / 120.0f;
+			snap.input = inputs[tick];
+			snap.location = Vector(0, -2048.0f + tick * 15.0f, 17.0f);
+			jumped = jumped || inputs[tick].Jumped;
+			snap.jumped = jumped;
+			snap.onGround = !jumped;
+			snap.hasDodge = true;
+			snap.dodgeDirection = Vector(inputs[tick].DodgeForward, inputs[tick].DodgeStrafe, 0);
+		}
+		return snaps;
+	}
+
+	// Attempt inputs as they were stored before InputTimeline
+	using InputMap = std::map<int, ControllerInput>;
+
+	// The inputs of every csv in dir
+	std::vector<InputTimeline> LoadRecordedFlips(const std::filesystem::path& dir)
+	{
+		std::vector<InputTimeline> flips;
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+		{
+			Attempt attempt;
+			if (entry.path().extension() == ".csv" && attempt.ReadInputsFromFile(entry.path()))
+				flips.push_back(attempt.inputs);
+		}
+		return flips;
+	}
+
+	// The ofstream writer WriteInputsToFile had before CsvWriter, kept to compare against
+	void WriteStreamCsv(const std::filesystem::path& path, const std::vector<ControllerInput>& inputs)
+	{
+		std::ofstream os(path, std::ios::out);
+		os << "Tick,ActivateBoost,DodgeForward,DodgeStrafe,Handbrake,HoldingBoost,Jump,Jumped,Pitch,Roll,Steer,Throttle,Yaw" << '\n';
+		for (size_t tick = 0; tick < inputs.size(); tick++)
+		{
+			const ControllerInput& input = inputs[tick];
+			os << tick << ","
+			   << input.ActivateBoost << ","
+			   << input.DodgeForward << ","
+			   << input.DodgeStrafe << ","
+			   << input.Handbrake << ","
+			   << input.HoldingBoost << ","
+			   << input.Jump << ","
+			   << input.Jumped << ","
+			   << input.Pitch << ","
+			   << input.Roll << ","
+			   << input.Steer << ","
+			   << input.Throttle << ","
+			   << input.Yaw << '\n';
+		}
+	}
+
+	// The stringstream reader ReadInputsFromFile had before CsvReader, kept to compare against
+	void ReadStreamCsv(const std::filesystem::path& path, InputTimeline& inputs)
+	{
+		std::ifstream is(path, std::ios::in);
+		std::string line, word;
+		inputs.clear();
+		std::getline(is, line);
+		while (std::getline(is, line))
+		{
+			ControllerInput i;
+			std::stringstream s(line);
+			std::getline(s, word, ',');
+			int tick = std::stoi(word);
+			std::getline(s, word, ',');
+			i.ActivateBoost = std::stoul(word);
+			std::getline(s, word, ',');
+			i.DodgeForward = std::stof(word);
+			std::getline(s, word, ',');
+			i.DodgeStrafe = std::stof(word);
+			std::getline(s, word, ',');
+			i.Handbrake = std::stoul(word);
+			std::getline(s, word, ',');
+			i.HoldingBoost = std::stoul(word);
+			std::getline(s, word, ',');
+			i.Jump = std::stoul(word);
+			std::getline(s, word, ',');
+			i.Jumped = std::stoul(word);
+			std::getline(s, word, ',');
+			i.Pitch = std::stof(word);
+			std::getline(s, word, ',');
+			i.Roll = std::stof(word);
+			std::getline(s, word, ',');
+			i.Steer = std::stof(word);
+			std::getline(s, word, ',');
+			i.Throttle = std::stof(word);
+			std::getline(s, word, ',');
+			i.Yaw = std::stof(word);
+			inputs.Record(tick, i);
+		}
+	}
+
+	// An attempt far longer than a kickoff with every axis full of digits, about 4 MB as csv
+	Attempt LargeAttempt()
+	{
+		Attempt attempt;
+		uint32_t state = 7;
+		auto next = [&state] {
+			state = state * 1664525u + 1013904223u;
+			return static_cast<float>(state >> 8) / 8388608.0f - 1.0f;
+		};
+		for (int tick = 0; tick < 40000; tick++)
+		{
+			ControllerInput input;
+			input.Throttle = next();
+			input.Steer = next();
+			input.Pitch = next();
+			input.Yaw = next();
+			input.Roll = next();
+			input.DodgeForward = next();
+			input.DodgeStrafe = next();
+			input.Jump = tick % 3 == 0;
+			input.ActivateBoost = tick % 5 == 0;
+			attempt.Record(tick, input);
+		}
+		return attempt;
+	}
+
+	// RotatorToOrientation as it was before RotatorSinCos, sinf/cosf of the angle in radians
+	Orientation LibmOrientation(const Rotator& rotation)
+	{
+		const float toRadians = CONST_PI_F / 32768.0f;
+		float sp = sinf(rotation.Pitch * toRadians), cp = cosf(rotation.Pitch * toRadians);
+		float sy = sinf(rotation.Yaw * toRadians), cy = cosf(rotation.Yaw * toRadians);
+		float sr = sinf(rotation.Roll * toRadians), cr = cosf(rotation.Roll * toRadians);
+
+		Orientation result;
+		result.forward = Vector(cp * cy, cp * sy, sp);
+		result.right = Vector(sr * sp * cy - cr * sy, sr * sp * sy + cr * cy, -sr * cp);
+		result.up = Vector(-(cr * sp * cy + sr * sy), cy * sr - cr * sp * sy, cr * cp);
+		return result;
+	}
+
+	MeterLayout AngleMeter(Vector2 screen, std::list<MeterRange>& ranges, std::list<MeterMarking>& markings)
+	{
+		int totalUnits = 180;
+		int center = totalUnits / 2;
+		ranges = {
+			{ CustomColor(50, 255, 50, 0.7f), center - 18, center + 18 },
+			{ CustomColor(255, 255, 50, 0.7f), center - 54, center - 18 },
+			{ CustomColor(255, 255, 50, 0.7f), center + 18, center + 54 },
+			{ CustomColor(255, 50, 50, 0.7f), 0, center - 54 },
+			{ CustomColor(255, 50, 50, 0.7f), center + 54, totalUnits },
+		};
+		markings = {
+			{ CustomColor(255, 255, 255, 1.0f), 1, center - 18 },
+			{ CustomColor(255, 255, 255, 1.0f), 1, center + 18 },
+			{ CustomColor(255, 255, 255, 1.0f), 1, center - 54 },
+			{ CustomColor(255, 255, 255, 1.0f), 1, center + 54 },
+		};
+		Vector2 size{ static_cast<int>(screen.X * 0.7f), static_cast<int>(screen.Y * 0.04f) };
+		Vector2 start{ screen.X / 2 - size.X / 2, static_cast<int>(screen.Y * 0.1f) };
+		return BuildMeterLayout(start, size, CustomColor(255, 255, 255, 1.0f), LineStyle(CustomColor(255, 255, 255, 1.0f), 2),
+			totalUnits, ranges, markings, false);
+	}
+
+	std::vector<BenchResult> RunAll(const BenchOptions& options)
+	{
+		std::vector<BenchResult> results;
+		auto wanted = [&](const char* name) { return options.filter.empty() || strstr(name, options.filter.c_str()); };
+
+		const std::vector<ControllerInput> inputs = BotInputs();
+		const int ticks = static_cast<int>(inputs.size());
+
+		if (wanted("attempt_record"))
+		{
+			Attempt attempt;
+			results.push_back(Run(options, "attempt_record", "tick", ticks, [&] {
+				attempt.Clear();
+				for (int tick = 0; tick < ticks; tick++)
+					attempt.Record(tick, inputs[tick]);
+			}));
+		}
+
+		Attempt recorded;
+		for (int tick = 0; tick < ticks; tick++)
+			recorded.Record(tick, inputs[tick]);
+		recorded.Freeze();
+
+		if (wanted("attempt_play"))
+		{
+			InputRuns::Cursor cursor;
+			ControllerInput ci;
+			results.push_back(Run(options, "attempt_play", "tick", ticks, [&] {
+				cursor.Reset();
+				for (int tick = 0; tick < ticks; tick++)
+					recorded.Play(&ci, tick, cursor);
+			}));
+		}
+
+		const std::vector<InputTimeline> flips = LoadRecordedFlips(options.flips);
+		int flipTicks = 0;
+		for (const InputTimeline& flip : flips)
+			flipTicks += flip.End();
+
+		if (wanted("recorded_flips") && flipTicks == 0)
+			fprintf(stderr, "no recorded attempts in %s, skipping recorded_flips\n", options.flips.string().c_str());
+		else if (wanted("recorded_flips"))
+		{
+			// Every RecordedFlips attempt recorded tick by tick and played back, as a session does
+			InputTimeline timeline;
+			ControllerInput ci;
+			results.push_back(Run(options, "recorded_flips", "tick", flipTicks, [&] {
+				for (const InputTimeline& flip : flips)
+				{
+					timeline.clear();
+					flip.ForEach([&](int tick, const ControllerInput& input) { timeline.Record(tick, input); });
+					for (int tick = 0; tick < flip.End(); tick++)
+						timeline.Play(&ci, tick);
+				}
+			}));
+
+			InputMap map;
+			results.push_back(Run(options, "recorded_flips_map", "tick", flipTicks, [&] {
+				for (const InputTimeline& flip : flips)
+				{
+					map.clear();
+					flip.ForEach([&](int tick, const ControllerInput& input) { map[tick] = input; });
+					for (int tick = 0; tick < flip.End(); tick++)
+					{
+						auto it = map.find(tick);
+						if (it != map.end())
+							CopyControllerInput(&ci, it->second);
+					}
+				}
+			}));
+		}
+
+		if (wanted("bot_play"))
+		{
+			BotAttempt bot;
+			bot.Become26Bot();
+			ControllerInput ci;
+			results.push_back(Run(options, "bot_play", "tick", ticks, [&] {
+				for (int tick = 0; tick < ticks; tick++)
+					bot.Play(&ci, tick);
+			}));
+		}
+
+		if (wanted("session_measure"))
+		{
+			// OnTick in manual mode, which runs Measure on every tick of the attempt
+			const std::vector<CarTickSnapshot> snaps = Snapshots(inputs);
+			TrainerSession session;
+			results.push_back(Run(options, "session_measure", "tick", ticks, [&] {
+				session.OnRestart(300.0f);
+				for (const CarTickSnapshot& snap : snaps)
+				{
+					ControllerInput ci = snap.input;
+					session.OnTick(snap, &ci);
+				}
+			}));
+		}
+
+		std::filesystem::path csv = std::filesystem::temp_directory_path() / "sf_bench_attempt.csv";
+		if (wanted("csv_write"))
+		{
+			results.push_back(Run(options, "csv_write", "tick", ticks, [&] {
+				recorded.WriteInputsToFile(csv);
+			}));
+			results.push_back(Run(options, "csv_write_stream", "tick", ticks, [&] {
+				WriteStreamCsv(csv, inputs);
+			}));
+		}
+
+		if (wanted("csv_read"))
+		{
+			recorded.WriteInputsToFile(csv);
+			Attempt attempt;
+			results.push_back(Run(options, "csv_read", "tick", ticks, [&] {
+				attempt.Clear();
+				attempt.ReadInputsFromFile(csv);
+			}));
+		}
+
+		if (wanted("csv_read_large"))
+		{
+			// Throughput on a multi-megabyte file, per KiB read
+			LargeAttempt().WriteInputsToFile(csv);
+			int kib = static_cast<int>(std::filesystem::file_size(csv) / 1024);
+			Attempt attempt;
+			results.push_back(Run(options, "csv_read_large", "KiB", kib, [&] {
+				attempt.Clear();
+				attempt.ReadInputsFromFile(csv);
+			}));
+			InputTimeline timeline;
+			results.push_back(Run(options, "csv_read_large_stream", "KiB", kib, [&] {
+				ReadStreamCsv(csv, timeline);
+			}));
+		}
+		std::error_code ignored;
+		std::filesystem::remove(csv, ignored);
+
+		// A camera behind the kickoff spot and a ring of points around the car
+		constexpr int Points = 256;
+		Vector world[Points];
+		Rotator rotations[Points];
+		for (int i = 0; i < Points; i++)
+		{
+			float angle = i * (2 * CONST_PI_F / Points);
+			world[i] = Vector(cosf(angle) * 300.0f, -2048.0f + sinf(angle) * 300.0f, 17.0f + (i % 8) * 20.0f);
+			rotations[i] = Rotator(i * 97 - 12000, i * 257, i * 131 - 16000);
+		}
+		Vector2 screen{ 1920, 1080 };
+
+		if (wanted("world_to_screen"))
+		{
+			ProjectionContext projection(ViewProjectionMatrix(Vector(0, -2900.0f, 120.0f), Rotator(-1200, 16384, 0), 110.0f, 16.0f / 9.0f), screen);
+			results.push_back(Run(options, "world_to_screen", "point", Points, [&] {
+				Vector2 out{ 0, 0 };
+				for (int i = 0; i < Points; i++)
+					projection.Project(world[i], out);
+				sink = static_cast<float>(out.X);
+			}));
+		}
+
+		if (wanted("rotator_to_orientation"))
+		{
+			results.push_back(Run(options, "rotator_to_orientation", "rotator", Points, [&] {
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+				{
+					// One component of each axis, so an inlined version cannot drop the roll terms
+					Orientation o = RotatorToOrientation(rotations[i]);
+					sum += o.forward.X + o.right.Y + o.up.Z;
+				}
+				sink = sum;
+			}));
+			results.push_back(Run(options, "rotator_to_orientation_libm", "rotator", Points, [&] {
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+				{
+					Orientation o = LibmOrientation(rotations[i]);
+					sum += o.forward.X + o.right.Y + o.up.Z;
+				}
+				sink = sum;
+			}));
+		}
+
+		if (wanted("rotator_sincos"))
+		{
+			int angles[Points];
+			for (int i = 0; i < Points; i++)
+				angles[i] = i * 4099 - 300000;
+			results.push_back(Run(options, "rotator_sincos", "angle", Points, [&] {
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+				{
+					float s, c;
+					RotatorSinCos(angles[i], s, c);
+					sum += s + c;
+				}
+				sink = sum;
+			}));
+			results.push_back(Run(options, "rotator_sincos_libm", "angle", Points, [&] {
+				const float toRadians = CONST_PI_F / 32768.0f;
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+					sum += sinf(angles[i] * toRadians) + cosf(angles[i] * toRadians);
+				sink = sum;
+			}));
+		}
+
+		// The _scalar cases run the reference code from ScalarMath.h on the same data
+		Matrix view = ViewProjectionMatrix(Vector(0, -2900.0f, 120.0f), Rotator(-1200, 16384, 0), 110.0f, 16.0f / 9.0f);
+		Matrix matrices[Points];
+		for (int i = 0; i < Points; i++)
+			matrices[i] = ViewProjectionMatrix(world[i], rotations[i], 90.0f + (i % 30), 16.0f / 9.0f);
+
+		if (wanted("matrix_multiply"))
+		{
+			results.push_back(Run(options, "matrix_multiply", "matrix", Points, [&] {
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+					sum += (view * matrices[i]).M[3][3];
+				sink = sum;
+			}));
+			results.push_back(Run(options, "matrix_multiply_scalar", "matrix", Points, [&] {
+				float sum = 0;
+				for (int i = 0; i < Points; i++)
+					sum += ScalarMath::Multiply(view, matrices[i]).M[3][3];
+				sink = sum;
+			}));
+		}
+
+		if (wanted("transform_points"))
+		{
+			Vector4 clip[Points];
+			results.push_back(Run(options, "transform_points", "point", Points, [&] {
+				TransformPoints(view, world, Points, clip);
+				sink = clip[Points - 1].W;
+			}));
+			results.push_back(Run(options, "transform_points_scalar", "point", Points, [&] {
+				ScalarMath::TransformPoints(view, world, Points, clip);
+				sink = clip[Points - 1].W;
+			}));
+		}
+
+		Headless::FakeCanvas fakeCanvas;
+		CanvasWrapper canvas(fakeCanvas);
+		std::list<MeterRange> ranges;
+		std::list<MeterMarking> markings;
+		MeterLayout layout = AngleMeter(screen, ranges, markings);
+
+		if (wanted("render_meter"))
+		{
+			// The one-off path, builds the layout and a draw list on every call
+			results.push_back(Run(options, "render_meter", "meter", 1, [&] {
+				RenderMeter(canvas, layout.startPos, layout.boxSize, CustomColor(255, 255, 255, 1.0f),
+					LineStyle(CustomColor(255, 255, 255, 1.0f), 2), layout.totalUnits, ranges, markings, false, 97.0f);
+			}));
+		}
+
+		if (wanted("meter_layout_draw"))
+		{
+			// The per-frame path, a kept layout recorded into a kept draw list
+			DrawList drawList;
+			float value = 0;
+			results.push_back(Run(options, "meter_layout_draw", "meter", 1, [&] {
+				DrawMeterLayout(drawList, layout, value);
+				drawList.Flush(canvas);
+				value = value < layout.totalUnits ? value + 1 : 0;
+			}));
+		}
+
+		if (wanted("latency_scope"))
+		{
+			// What SF_PROFILE_SCOPE adds to every hook: two clock reads, a histogram sample and a trace event
+			constexpr int Samples = 256;
+			LatencyHistogram histogram("bench");
+			results.push_back(Run(options, "latency_scope", "sample", Samples, [&] {
+				for (int i = 0; i < Samples; i++)
+					LatencyScope scope(histogram);
+			}));
+		}
+
+		return results;
+	}
+
+	struct BaselineEntry
+	{
+		double nsPerOp = 0;
+		double allocsPerOp = 0;
+		double limitNs = 0; // 0 without a limit
+	};
+	using Baseline = std::map<std::string, BaselineEntry>;
+
+	bool ReadBaseline(const std::filesystem::path& path, Baseline& baseline)
+	{
+		std::ifstream in(path);
+		if (!in)
+			return false;
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+			std::istringstream fields(line);
+			std::string name;
+			BaselineEntry entry;
+			if (!(fields >> name >> entry.nsPerOp >> entry.allocsPerOp))
+				continue;
+			if (!(fields >> entry.limitNs))
+				entry.limitNs = 0;
+			baseline[name] = entry;
+		}
+		return true;
+	}
+
+	// Limits are not measured, they are carried over from the baseline being replaced
+	bool WriteBaseline(const std::filesystem::path& path, const std::vector<BenchResult>& results, const Baseline& limits)
+	{
+		std::ofstream out(path);
+		if (!out)
+			return false;
+		out << "# name ns/op allocations/op [limit ns/op], written by sf_bench --write-baseline\n";
+		for (const BenchResult& r : results)
+		{
+			auto it = limits.find(r.name);
+			if (it != limits.end() && it->second.limitNs > 0)
+				out << fmt::format("{} {:.2f} {:.4f} {:.2f}\n", r.name, r.nsPerOp, r.allocsPerOp, it->second.limitNs);
+			else
+				out << fmt::format("{} {:.2f} {:.4f}\n", r.name, r.nsPerOp, r.allocsPerOp);
+		}
+		return static_cast<bool>(out);
+	}
+
+	bool WriteJson(const std::filesystem::path& path, const std::vector<BenchResult>& results)
+	{
+		std::ofstream out(path);
+		if (!out)
+			return false;
+		out << "{\n  \"allocationsCounted\": " << (AllocationCounter::Enabled ? "true" : "false") << ",\n  \"results\": [\n";
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const BenchResult& r = results[i];
+			out << fmt::format("    {{\"name\": \"{}\", \"unit\": \"{}\", \"ops\": {}, \"nsPerOp\": {:.3f}, \"allocsPerOp\": {:.4f}}}{}\n",
+				r.name, r.unit, r.ops, r.nsPerOp, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+		}
+		out << "  ]\n}\n";
+		return static_cast<bool>(out);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	std::filesystem::path jsonPath;
+	std::filesystem::path baselinePath;
+	std::filesystem::path writeBaselinePath;
+	double tolerance = 0.25;
+	bool ignoreTime = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--quick") == 0)
+			options.quick = true;
+		else if (strcmp(argv[i], "--ignore-time") == 0)
+			ignoreTime = true;
+		else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+			baselinePath = argv[++i];
+		else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc)
+			writeBaselinePath = argv[++i];
+		else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+			tolerance = atof(argv[++i]);
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			options.filter = argv[++i];
+		else if (strcmp(argv[i], "--flips") == 0 && i + 1 < argc)
+			options.flips = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: sf_bench [--quick] [--json <file>] [--baseline <file>] [--write-baseline <file>]\n"
+				"                [--tolerance <fraction>] [--ignore-time] [--filter <text>] [--flips <dir>]\n");
+			return 2;
+		}
+	}
+
+	Baseline baseline;
+	if (!baselinePath.empty() && !ReadBaseline(baselinePath, baseline))
+	{
+		fprintf(stderr, "cannot read baseline %s\n", baselinePath.string().c_str());
+		return 2;
+	}
+
+	// Measure logs through the ring, the lines themselves are not wanted here
+	AsyncLogger::Instance().Start([](LogLevel, const std::string&) {});
+	std::vector<BenchResult> results = RunAll(options);
+	AsyncLogger::Instance().Stop();
+
+	if (!AllocationCounter::Enabled)
+		printf("allocations are not counted, build with SF_COUNT_ALLOCATIONS\n");
+
+	int regressions = 0;
+	printf("%-24s %12s %14s\n", "case", "ns/op", "allocs/op");
+	for (const BenchResult& r : results)
+	{
+		std::string note;
+		if (!baselinePath.empty())
+		{
+			auto it = baseline.find(r.name);
+			if (it == baseline.end())
+				note = "  not in baseline";
+			else
+			{
+				const BaselineEntry& base = it->second;
+				if (r.allocsPerOp > base.allocsPerOp + 0.0005)
+					note += fmt::format("  ALLOCATIONS {:.4f} > {:.4f}", r.allocsPerOp, base.allocsPerOp);
+				if (!ignoreTime && r.nsPerOp > base.nsPerOp * (1 + tolerance))
+					note += fmt::format("  SLOWER {:.0f}% than {:.2f}", (r.nsPerOp / base.nsPerOp - 1) * 100, base.nsPerOp);
+				if (!ignoreTime && base.limitNs > 0 && r.nsPerOp > base.limitNs)
+					note += fmt::format("  OVER LIMIT {:.2f}", base.limitNs);
+				if (!note.empty())
+					regressions++;
+			}
+		}
+		printf("%-24s %9.2f/%-7s %9.4f%s\n", r.name.c_str(), r.nsPerOp, r.unit, r.allocsPerOp, note.c_str());
+	}
+
+	if (!jsonPath.empty() && !WriteJson(jsonPath, results))
+	{
+		fprintf(stderr, "cannot write %s\n", jsonPath.string().c_str());
+		return 2;
+	}
+	Baseline limits;
+	if (!writeBaselinePath.empty())
+		ReadBaseline(writeBaselinePath, limits);
+	if (!writeBaselinePath.empty() && !WriteBaseline(writeBaselinePath, results, limits))
+	{
+		fprintf(stderr, "cannot write baseline %s\n", writeBaselinePath.string().c_str());
+		return 2;
+	}
+	return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "DrawList.h"
+#include "RenderMeter.h"
+#include "TestCheck.h"
+
+#include <vector>
+
+// sf_draw_list_test
+// Checks that DrawList::Flush keeps the record order of overlapping primitives inside a
+// layer, and holds the canvas calls of an angle meter frame to the expected counts.
+
+namespace
+{
+	// Remembers the color and position of every fill in the order the canvas got them
+	struct RecordingCanvas : CountingCanvas
+	{
+		struct Fill
+		{
+			uint32_t color;
+			Vector2 position;
+		};
+
+		uint32_t color = 0;
+		Vector2 position{ 0, 0 };
+		std::vector<Fill> fills;
+
+		void SetColor(char r, char g, char b, char a)
+		{
+			CountingCanvas::SetColor(r, g, b, a);
+			color = (static_cast<uint32_t>(static_cast<unsigned char>(r)) << 24) | (static_cast<uint32_t>(static_cast<unsigned char>(g)) << 16)
+				| (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8) | static_cast<unsigned char>(a);
+		}
+		void SetPosition(Vector2 p)
+		{
+			CountingCanvas::SetPosition(p);
+			position = p;
+		}
+		void FillBox(Vector2 size)
+		{
+			CountingCanvas::FillBox(size);
+			fills.push_back({ color, position });
+		}
+	};
+
+	uint32_t Pack(const CustomColor& c)
+	{
+		return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) | (static_cast<uint32_t>(c.b) << 8) | c.GetAlphaChar();
+	}
+
+	void TestRecordOrder()
+	{
+		CustomColor red(255, 0, 0);
+		CustomColor green(0, 255, 0);
+		DrawList drawList;
+		// Recorded out of layer order, with overlapping fills of alternating colors
+		drawList.DrawString(red, Vector2{ 0, 0 }, "text");
+		drawList.FillBox(DrawLayer::Fill, red, Vector2{ 1, 0 }, Vector2{ 10, 10 });
+		drawList.FillBox(DrawLayer::Fill, green, Vector2{ 2, 0 }, Vector2{ 10, 10 });
+		drawList.FillBox(DrawLayer::Fill, red, Vector2{ 3, 0 }, Vector2{ 10, 10 });
+		drawList.FillBox(DrawLayer::Background, green, Vector2{ 0, 0 }, Vector2{ 20, 20 });
+
+		RecordingCanvas canvas;
+		DrawListStats stats = drawList.Flush(canvas);
+
+		SF_CHECK(canvas.fills.size() == 4, "%d fills", static_cast<int>(canvas.fills.size()));
+		if (canvas.fills.size() == 4)
+		{
+			SF_CHECK(canvas.fills[0].position.X == 0 && canvas.fills[0].color == Pack(green), "the background is not drawn first");
+			for (int i = 1; i < 4; i++)
+				SF_CHECK(canvas.fills[i].position.X == i && canvas.fills[i].color == Pack(i == 2 ? green : red),
+					"fill %d is the one recorded at x %d", i, canvas.fills[i].position.X);
+		}
+		// green background, red, green, red, and the text keeps the last red
+		SF_CHECK(canvas.setColor == 4, "%d SetColor calls instead of 4", canvas.setColor);
+		SF_CHECK(stats.colorChanges == canvas.setColor && stats.canvasCalls == canvas.Total(), "the stats do not match the calls made");
+	}
+
+	// The angle meter with sf_left_angle -10 and sf_right_angle 10, where the green range of
+	// each side overlaps a yellow range of the other. Same ranges as BuildAngleMeterLayout.
+	MeterLayout OverlappingAngleMeter(std::list<MeterRange>& ranges, std::list<MeterMarking>& markings)
+	{
+		int totalUnits = 180;
+		int left = -10 + 90;
+		int right = 10 + 90;
+		int green = 8;
+		int yellow = 15;
+		CustomColor gray(200, 200, 200, 1.0f);
+		for (int target : { left, right })
+		{
+			markings.push_back({ gray, 1, target - green });
+			markings.push_back({ gray, 1, target + green });
+			ranges.push_back({ CustomColor(50, 255, 50, 0.7f), target - green, target + green });
+			ranges.push_back({ CustomColor(255, 255, 50, 0.7f), target - yellow, target - green });
+			ranges.push_back({ CustomColor(255, 255, 50, 0.7f), target + green, target + yellow });
+		}
+		ranges.push_back({ CustomColor(255, 50, 50, 0.7f), 0, left - yellow });
+		ranges.push_back({ CustomColor(255, 50, 50, 0.7f), right + yellow, totalUnits });
+
+		return BuildMeterLayout(Vector2{ 326, 972 }, Vector2{ 1267, 43 }, CustomColor(255, 255, 255, 1.0f),
+			LineStyle(CustomColor(255, 255, 255, 1.0f), 2), totalUnits, ranges, markings, false);
+	}
+
+	void TestAngleMeterFrame()
+	{
+		std::list<MeterRange> ranges;
+		std::list<MeterMarking> markings;
+		MeterLayout layout = OverlappingAngleMeter(ranges, markings);
+		SF_CHECK(layout.boxes.size() == 9, "%d boxes", static_cast<int>(layout.boxes.size()));
+
+		DrawList drawList;
+		for (int frame = 0; frame < 3; frame++)
+		{
+			DrawMeterLayout(drawList, layout, 80.0f + frame);
+			drawList.DrawString(CustomColor(255, 255, 255, 1.0f), Vector2{ 326, 952 }, "Dodge Angle: -10 DEG");
+
+			RecordingCanvas canvas;
+			DrawListStats stats = drawList.Flush(canvas);
+
+			// Fills go out exactly in layout order, background then each range as recorded
+			SF_CHECK(canvas.fills.size() == layout.boxes.size(), "frame %d: %d fills", frame, static_cast<int>(canvas.fills.size()));
+			for (size_t i = 0; i < canvas.fills.size() && i < layout.boxes.size(); i++)
+			{
+				const MeterLayout::Box& box = layout.boxes[i];
+				SF_CHECK(canvas.fills[i].color == Pack(box.color) && canvas.fills[i].position.X == box.position.X,
+					"frame %d: fill %d is not box %d", frame, static_cast<int>(i), static_cast<int>(i));
+			}
+
+			// SetColor: white background, the fill runs green, yellow x2, green, yellow x2, red x2,
+			// gray markings, dark value marker, white border. The text keeps the border's white.
+			SF_CHECK(canvas.setColor == 9, "frame %d: %d SetColor calls instead of 9", frame, canvas.setColor);
+			SF_CHECK(canvas.fillBox == 9, "frame %d: %d FillBox calls instead of 9", frame, canvas.fillBox);
+			SF_CHECK(canvas.drawLine == 5, "frame %d: %d DrawLine calls instead of 5", frame, canvas.drawLine);
+			SF_CHECK(canvas.drawBox == 1, "frame %d: %d DrawBox calls instead of 1", frame, canvas.drawBox);
+			SF_CHECK(canvas.drawString == 1, "frame %d: %d DrawString calls instead of 1", frame, canvas.drawString);
+			SF_CHECK(canvas.setPosition == 11, "frame %d: %d SetPosition calls instead of 11", frame, canvas.setPosition);
+			SF_CHECK(canvas.Total() == 36, "frame %d: %d canvas calls instead of 36", frame, canvas.Total());
+			SF_CHECK(stats.commands == 16 && stats.colorChanges == canvas.setColor && stats.canvasCalls == canvas.Total(),
+				"frame %d: stats %d commands, %d color changes, %d calls", frame, stats.commands, stats.colorChanges, stats.canvasCalls);
+		}
+	}
+}
+
+int main()
+{
+	TestRecordOrder();
+	TestAngleMeterFrame();
+	return Headless::TestResult();
+}
@@ -0,0 +1,241 @@
+#include "pch.h"
+#include "FakeGame.h"
+
+#include <cstdio>
+
+using namespace Headless;
+
+// Defined by the plugin in game, the headless build has no console to register with
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
+
+void CVarManagerWrapper::log(std::string text)
+{
+	if (sink)
+		sink(text);
+	else
+		fprintf(stderr, "%s\n", text.c_str());
+}
+
+DodgeComponentWrapper::DodgeComponentWrapper(FakeWorld* world) : ObjectWrapper(world && world->car.hasDodge ? world : nullptr), world(world) {}
+
+Vector DodgeComponentWrapper::GetDodgeTorque()
+{
+	world->calls++;
+	return world->car.dodgeTorque;
+}
+
+Vector DodgeComponentWrapper::GetDodgeDirection()
+{
+	world->calls++;
+	return world->car.dodgeDirection;
+}
+
+BoostWrapper::BoostWrapper(FakeWorld* world) : ObjectWrapper(world && world->car.hasBoost ? world : nullptr), world(world) {}
+
+float BoostWrapper::GetCurrentBoostAmount()
+{
+	world->calls++;
+	return world->car.boost;
+}
+
+CarWrapper::CarWrapper(FakeWorld* world) : ObjectWrapper(world), world(world) {}
+
+PriWrapper CarWrapper::GetPRI()
+{
+	world->calls++;
+	return PriWrapper(world->car.hasPri ? world : nullptr);
+}
+
+ControllerInput CarWrapper::GetInput()
+{
+	world->calls++;
+	return world->car.input;
+}
+
+Vector CarWrapper::GetLocation()
+{
+	world->calls++;
+	return world->car.location;
+}
+
+Rotator CarWrapper::GetRotation()
+{
+	world->calls++;
+	return world->car.rotation;
+}
+
+Vector CarWrapper::GetVelocity()
+{
+	world->calls++;
+	return world->car.velocity;
+}
+
+Vector CarWrapper::GetAngularVelocity()
+{
+	world->calls++;
+	return world->car.angularVelocity;
+}
+
+bool CarWrapper::IsOnGround()
+{
+	world->calls++;
+	return world->car.onGround;
+}
+
+bool CarWrapper::GetbJumped()
+{
+	world->calls++;
+	return world->car.jumped;
+}
+
+bool CarWrapper::IsDodging()
+{
+	world->calls++;
+	return world->car.dodging;
+}
+
+DodgeComponentWrapper CarWrapper::GetDodgeComponent()
+{
+	world->calls++;
+	return DodgeComponentWrapper(world);
+}
+
+BoostWrapper CarWrapper::GetBoostComponent()
+{
+	world->calls++;
+	return BoostWrapper(world);
+}
+
+ServerWrapper::ServerWrapper(FakeWorld* world) : ObjectWrapper(world && world->hasServer ? world : nullptr), world(world) {}
+
+float ServerWrapper::GetGameTimeRemaining()
+{
+	world->calls++;
+	return world->timeRemaining;
+}
+
+EngineTAWrapper::EngineTAWrapper(FakeWorld* world) : ObjectWrapper(world), world(world) {}
+
+int EngineTAWrapper::GetPhysicsFrame()
+{
+	world->calls++;
+	return world->physicsFrame;
+}
+
+CameraWrapper::CameraWrapper(FakeWorld* world) : ObjectWrapper(world), world(world) {}
+
+Vector CameraWrapper::GetLocation()
+{
+	world->calls++;
+	return world->cameraLocation;
+}
+
+Rotator CameraWrapper::GetRotation()
+{
+	world->calls++;
+	return world->cameraRotation;
+}
+
+float CameraWrapper::GetFOV()
+{
+	world->calls++;
+	return world->cameraFov;
+}
+
+bool GameWrapper::IsInCustomTraining()
+{
+	world->calls++;
+	return world->inCustomTraining;
+}
+
+EngineTAWrapper GameWrapper::GetEngine()
+{
+	world->calls++;
+	return EngineTAWrapper(world);
+}
+
+ServerWrapper GameWrapper::GetCurrentGameState()
+{
+	world->calls++;
+	return ServerWrapper(world);
+}
+
+ServerWrapper GameWrapper::GetGameEventAsServer()
+{
+	world->calls++;
+	return ServerWrapper(world);
+}
+
+CarWrapper GameWrapper::GetLocalCar()
+{
+	world->calls++;
+	return CarWrapper(world);
+}
+
+CameraWrapper GameWrapper::GetCamera()
+{
+	world->calls++;
+	return CameraWrapper(world);
+}
+
+void GameWrapper::OverrideParams(void* src, size_t memsize)
+{
+	world->calls++;
+	world->overrides++;
+	if (memsize == sizeof(ControllerInput))
+		world->car.input = *static_cast<const ControllerInput*>(src);
+}
+
+Vector2 CanvasWrapper::GetSize()
+{
+	return canvas->size;
+}
+
+void CanvasWrapper::SetColor(char red, char green, char blue, char alpha)
+{
+	canvas->setColor++;
+	canvas->color = static_cast<uint32_t>(static_cast<unsigned char>(red)) << 24 | static_cast<uint32_t>(static_cast<unsigned char>(green)) << 16
+		| static_cast<uint32_t>(static_cast<unsigned char>(blue)) << 8 | static_cast<unsigned char>(alpha);
+}
+
+void CanvasWrapper::SetColor(LinearColor color)
+{
+	SetColor(static_cast<char>(color.R * 255.0f), static_cast<char>(color.G * 255.0f), static_cast<char>(color.B * 255.0f), static_cast<char>(color.A * 255.0f));
+}
+
+void CanvasWrapper::SetPosition(Vector2 pos)
+{
+	canvas->setPosition++;
+	canvas->position = pos;
+}
+
+void CanvasWrapper::SetPosition(Vector2F pos)
+{
+	SetPosition(Vector2{ static_cast<int>(pos.X), static_cast<int>(pos.Y) });
+}
+
+void CanvasWrapper::FillBox(Vector2)
+{
+	canvas->fillBox++;
+}
+
+void CanvasWrapper::DrawBox(Vector2)
+{
+	canvas->drawBox++;
+}
+
+void CanvasWrapper::DrawLine(Vector2, Vector2, float)
+{
+	canvas->drawLine++;
+}
+
+void CanvasWrapper::DrawString(std::string, float, float, bool, bool)
+{
+	canvas->drawString++;
+}
+
+Vector2F CanvasWrapper::GetStringSize(std::string text, float xScale, float yScale)
+{
+	canvas->getStringSize++;
+	return Vector2F{ static_cast<float>(text.size()) * canvas->charWidth * xScale, canvas->charHeight * yScale };
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+
+#include <cstdint>
+
+// State behind the headless SDK wrappers. Nothing here simulates the game, the owner
+// writes what the game would report for the current tick before calling into the trainer.
+namespace Headless
+{
+	struct FakeCar
+	{
+		bool hasPri = true;
+		ControllerInput input;
+		Vector location;
+		Rotator rotation;
+		Vector velocity;
+		Vector angularVelocity;
+		bool onGround = true;
+		bool jumped = false;
+		bool dodging = false;
+
+		bool hasDodge = true;
+		Vector dodgeTorque;
+		Vector dodgeDirection;
+
+		bool hasBoost = true;
+		float boost = 0.333f;
+	};
+
+	struct FakeWorld
+	{
+		bool inCustomTraining = true;
+		int physicsFrame = 0;
+		bool hasServer = true;
+		float timeRemaining = 0;
+
+		FakeCar car;
+
+		Vector cameraLocation;
+		Rotator cameraRotation;
+		float cameraFov = 110.0f;
+
+		// Wrapper calls made since the last reset, see CarTickSnapshot::wrapperCalls
+		int calls = 0;
+		int overrides = 0;
+	};
+
+	// Records nothing but the number of calls and the canvas state they leave behind
+	struct FakeCanvas
+	{
+		Vector2 size{ 1920, 1080 };
+		// Width of one character at scale 1, GetStringSize is proportional to the text length
+		int charWidth = 8;
+		int charHeight = 14;
+
+		Vector2 position{ 0, 0 };
+		uint32_t color = 0;
+
+		int setColor = 0;
+		int setPosition = 0;
+		int fillBox = 0;
+		int drawBox = 0;
+		int drawLine = 0;
+		int drawString = 0;
+		int getStringSize = 0;
+
+		int Total() const { return setColor + setPosition + fillBox + drawBox + drawLine + drawString + getStringSize; }
+		void ResetCounts() { setColor = setPosition = fillBox = drawBox = drawLine = drawString = getStringSize = 0; }
+	};
+}
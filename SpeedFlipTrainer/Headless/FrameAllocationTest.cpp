@@ -0,0 +1,126 @@
+#include "pch.h"
+#include "FakeGame.h"
+#include "AllocationCounter.h"
+#include "DrawList.h"
+#include "FixedString.h"
+#include "RenderMeter.h"
+#include "TextMeasureCache.h"
+#include "TestCheck.h"
+
+#include <string>
+
+// sf_frame_allocation_test
+// Renders the angle meter the way RenderMeters does every frame: a kept layout recorded
+// into a kept DrawList, labels formatted into FixedStrings and measured through the
+// TextMeasureCache, then one Flush on the canvas. Once the first frames have filled the
+// cache and sized the buffers, a frame must not allocate at all.
+
+namespace
+{
+	struct Frame
+	{
+		Headless::FakeCanvas fakeCanvas;
+		CanvasWrapper canvas{ fakeCanvas };
+		DrawList drawList;
+		TextMeasureCache textCache;
+		std::string measureScratch;
+		std::list<MeterRange> ranges;
+		std::list<MeterMarking> markings;
+		MeterLayout layout;
+
+		Frame()
+		{
+			measureScratch.reserve(TextMeasureCache::MaxTextLength + 1);
+			int center = 90;
+			ranges = {
+				{ CustomColor(50, 255, 50, 0.7f), center - 8, center + 8 },
+				{ CustomColor(255, 255, 50, 0.7f), center - 15, center - 8 },
+				{ CustomColor(255, 255, 50, 0.7f), center + 8, center + 15 },
+				{ CustomColor(255, 50, 50, 0.7f), 0, center - 15 },
+				{ CustomColor(255, 50, 50, 0.7f), center + 15, 180 },
+			};
+			markings = {
+				{ CustomColor(200, 200, 200, 1.0f), 1, center - 8 },
+				{ CustomColor(200, 200, 200, 1.0f), 1, center + 8 },
+			};
+			layout = BuildMeterLayout(Vector2{ 326, 972 }, Vector2{ 1267, 43 }, CustomColor(255, 255, 255, 1.0f),
+				LineStyle(CustomColor(255, 255, 255, 1.0f), 2), 180, ranges, markings, false);
+		}
+
+		// Same as SpeedFlipTrainer::MeasureText
+		Vector2 MeasureText(std::string_view text)
+		{
+			return textCache.Get(text, 1.0f, [&]() {
+				measureScratch.assign(text.data(), text.size());
+				AllocationCounter::Exclude sdkCopy;
+				Vector2F size = canvas.GetStringSize(measureScratch);
+				return Vector2{ static_cast<int>(size.X), static_cast<int>(size.Y) };
+			});
+		}
+
+		// The angle meter part of RenderAngleMeter, with the values a finished attempt shows
+		DrawListStats Render(int dodgeAngle, float pathLength)
+		{
+			textCache.BeginFrame(Vector2{ 1920, 1080 });
+			DrawMeterLayout(drawList, layout, static_cast<float>(dodgeAngle + 90));
+
+			CustomColor white(255, 255, 255, 1.0f);
+			FixedString<64> angleText("Dodge Angle: {} DEG", dodgeAngle);
+			drawList.DrawString(white, Vector2{ 326, 952 }, angleText.View());
+
+			FixedString<64> timeToBall("Time to Ball: {:.3f}s", 1.254f);
+			Vector2 ttbSize = MeasureText(timeToBall.View());
+			drawList.DrawString(white, Vector2{ 960 - ttbSize.X / 2, 952 }, timeToBall.View());
+
+			FixedString<64> distMsg("Path Length: {:.0f}uu", pathLength);
+			Vector2 distSize = MeasureText(distMsg.View());
+			drawList.DrawString(CustomColor(50, 255, 50, 1.0f), Vector2{ 1593 - distSize.X - 5, 952 }, distMsg.View());
+
+			std::string_view label = "Flip Cancel";
+			Vector2 labelSize = MeasureText(label);
+			drawList.DrawString(white, Vector2{ 960 - labelSize.X / 2, 1030 }, label);
+
+			return drawList.Flush(canvas);
+		}
+	};
+}
+
+int main()
+{
+	if (!AllocationCounter::Enabled)
+	{
+		printf("allocations are not counted, build with SF_COUNT_ALLOCATIONS\n");
+		return 1;
+	}
+
+	// The counter has to see an allocation, or the checks below could never fail
+	{
+		AllocationScope probe;
+		std::string* volatile allocated = new std::string(100, 'x');
+		SF_CHECK(probe.Allocations() > 0, "the allocation counter did not count a new");
+		delete allocated;
+	}
+
+	Frame frame;
+	frame.Render(-26, 2412.0f);
+
+	// The same text every frame, as on screen after an attempt
+	for (int i = 0; i < 100; i++)
+	{
+		AllocationScope allocations;
+		DrawListStats stats = frame.Render(-26, 2412.0f);
+		SF_CHECK(allocations.Allocations() == 0, "steady frame %d made %d allocation(s)", i, static_cast<int>(allocations.Allocations()));
+		SF_CHECK(stats.commands > 0, "frame %d drew nothing", i);
+	}
+	SF_CHECK(frame.textCache.Misses() == 3, "%d text measure misses instead of the 3 labels", static_cast<int>(frame.textCache.Misses()));
+
+	// Changing values while a dodge is measured, every new label is one cache insert
+	for (int i = 0; i < 60; i++)
+	{
+		AllocationScope allocations;
+		frame.Render(-40 + i, 2000.0f + i * 10);
+		SF_CHECK(allocations.Allocations() == 0, "frame %d with new labels made %d allocation(s)", i, static_cast<int>(allocations.Allocations()));
+	}
+
+	return Headless::TestResult();
+}
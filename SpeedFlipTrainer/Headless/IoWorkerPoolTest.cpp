@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "FileIO.h"
+#include "IoWorkerPool.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+// sf_io_worker_pool_test
+// Unloads the way SpeedFlipTrainer::onUnload does while saves are in flight, with a
+// dispatcher that queues completions like gameWrapper->Execute. Every completion has to
+// run exactly once on the unloading thread before RunRemaining returns, and the calls
+// still queued on the "game thread" afterwards must not run any of them again.
+
+namespace
+{
+	// Stands in for gameWrapper->Execute, jobs run when the test ticks the game thread
+	struct FakeGameThread
+	{
+		std::mutex mutex;
+		std::vector<IoWorkerPool::Job> queued;
+
+		void Execute(IoWorkerPool::Job job)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			queued.push_back(std::move(job));
+		}
+
+		void Tick()
+		{
+			std::vector<IoWorkerPool::Job> jobs;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs.swap(queued);
+			}
+			for (IoWorkerPool::Job& job : jobs)
+				job();
+		}
+	};
+
+	// What the completions of the plugin touch, destroyed with the plugin
+	struct PluginState
+	{
+		std::thread::id gameThread = std::this_thread::get_id();
+		int completed = 0;
+		int offGameThread = 0;
+	};
+
+	std::atomic<int> completions{ 0 };
+
+	std::string ReadBytes(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::ostringstream bytes;
+		bytes << in.rdbuf();
+		return bytes.str();
+	}
+
+	void TestUnloadWithSavesInFlight(const std::filesystem::path& work)
+	{
+		FakeGameThread game;
+		completions = 0;
+		constexpr int Saves = 6;
+		{
+			auto plugin = std::make_unique<PluginState>();
+			IoWorkerPool pool;
+			pool.SetDispatcher([&game](IoWorkerPool::Job job) { game.Execute(std::move(job)); });
+
+			auto save = [&](int i, int delayMs) {
+				std::filesystem::path path = work / ("save" + std::to_string(i) + ".csv");
+				PluginState* state = plugin.get();
+				bool queued = pool.Submit([path, i, delayMs] {
+					std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+					std::string text = "attempt " + std::to_string(i) + "\n";
+					WriteWholeFile(path, text.data(), text.size());
+				}, [state] {
+					completions++;
+					state->completed++;
+					if (std::this_thread::get_id() != state->gameThread)
+						state->offGameThread++;
+				});
+				SF_CHECK(queued, "save %d was not queued", i);
+			};
+
+			// Finished and already handed to the game thread, but the game thread has not ticked
+			save(0, 0);
+			save(1, 0);
+			pool.Flush();
+			SF_CHECK(plugin->completed == 0, "%d completions ran before the game thread ticked", plugin->completed);
+
+			// Still being written when the plugin unloads
+			for (int i = 2; i < Saves; i++)
+				save(i, 20);
+
+			// onUnload
+			pool.RunRemaining();
+
+			SF_CHECK(plugin->completed == Saves, "%d of %d completions ran before unload returned", plugin->completed, Saves);
+			SF_CHECK(plugin->offGameThread == 0, "%d completions ran off the unloading thread", plugin->offGameThread);
+			for (int i = 0; i < Saves; i++)
+			{
+				std::filesystem::path path = work / ("save" + std::to_string(i) + ".csv");
+				SF_CHECK(ReadBytes(path) == "attempt " + std::to_string(i) + "\n", "%s was not written", path.string().c_str());
+			}
+
+			// Whatever is submitted after unload began completes on its worker
+			pool.Submit(nullptr, [] { completions++; });
+			pool.Flush();
+			SF_CHECK(completions == Saves + 1, "a completion submitted after RunRemaining did not run");
+		}
+
+		// The plugin and its pool are gone, the game thread still holds the dispatched calls
+		SF_CHECK(!game.queued.empty(), "nothing was dispatched, the test did not exercise the race");
+		game.Tick();
+		SF_CHECK(completions == Saves + 1, "%d completions ran after the pool was destroyed", completions.load() - Saves - 1);
+	}
+
+	// In normal play each completion runs once, on the game thread tick after its job
+	void TestDispatchedCompletions()
+	{
+		FakeGameThread game;
+		PluginState state;
+		IoWorkerPool pool;
+		pool.SetDispatcher([&game](IoWorkerPool::Job job) { game.Execute(std::move(job)); });
+		for (int i = 0; i < 10; i++)
+			pool.Submit(nullptr, [&state] { state.completed++; });
+		pool.Flush();
+		SF_CHECK(state.completed == 0, "completions ran before the game thread ticked");
+		game.Tick();
+		SF_CHECK(state.completed == 10, "%d of 10 completions ran on the tick", state.completed);
+		game.Tick();
+		SF_CHECK(state.completed == 10, "completions ran twice");
+	}
+}
+
+int main()
+{
+	std::filesystem::path work = std::filesystem::temp_directory_path() / "sf_io_worker_pool_test";
+	std::filesystem::create_directories(work);
+
+	TestDispatchedCompletions();
+	TestUnloadWithSavesInFlight(work);
+
+	std::error_code ignored;
+	std::filesystem::remove_all(work, ignored);
+	return Headless::TestResult();
+}
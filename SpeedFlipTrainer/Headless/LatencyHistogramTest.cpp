@@ -0,0 +1,160 @@
+#include "pch.h"
+#include "LatencyHistogram.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+// sf_latency_histogram_test
+// Checks that every duration lands in a bucket whose limit bounds it within 12.5%, the
+// percentile ranks Summarize reads, and which samples survive each window rotation.
+
+namespace
+{
+	using Clock = Profiling::Clock;
+
+	void CheckBucket(uint64_t ns)
+	{
+		int bucket = LatencyHistogram::Bucket(ns);
+		uint64_t limit = LatencyHistogram::BucketLimit(bucket);
+		// The previous bucket ends below ns, so the bucket's range is (lower, limit]
+		uint64_t lower = bucket > 0 ? LatencyHistogram::BucketLimit(bucket - 1) : 0;
+		bool inRange = ns <= limit && (bucket == 0 || ns > lower);
+		if (!inRange)
+			SF_CHECK(false, "%" PRIu64 "ns is in bucket %d, (%" PRIu64 ", %" PRIu64 "]", ns, bucket, lower, limit);
+	}
+
+	void TestBuckets()
+	{
+		// Exact below 16ns
+		for (uint64_t ns = 0; ns < 16; ns++)
+		{
+			SF_CHECK(LatencyHistogram::Bucket(ns) == static_cast<int>(ns), "%" PRIu64 "ns is not in its own bucket", ns);
+			SF_CHECK(LatencyHistogram::BucketLimit(static_cast<int>(ns)) == ns, "limit of bucket %" PRIu64, ns);
+		}
+
+		// Every value up to 64us, then around every power of two the buckets cover
+		for (uint64_t ns = 0; ns < (1u << 16); ns++)
+			CheckBucket(ns);
+		for (int exponent = 16; exponent < 44; exponent++)
+		{
+			uint64_t power = uint64_t(1) << exponent;
+			for (uint64_t ns : { power - 1, power, power + 1, power + power / 3, 2 * power - 1 })
+				CheckBucket(ns);
+		}
+
+		// Limits only grow, and each bucket is at most an eighth of the values below it
+		for (int bucket = 1; bucket < LatencyHistogram::BucketCount; bucket++)
+		{
+			uint64_t lower = LatencyHistogram::BucketLimit(bucket - 1);
+			uint64_t limit = LatencyHistogram::BucketLimit(bucket);
+			SF_CHECK(limit > lower, "bucket %d ends at %" PRIu64 ", not above %" PRIu64, bucket, limit, lower);
+			SF_CHECK(bucket < 16 || (limit - lower) * 8 <= lower + 1, "bucket %d spans (%" PRIu64 ", %" PRIu64 "], more than 12.5%%", bucket, lower, limit);
+		}
+
+		// Anything longer than the last bucket is counted in it instead of past the array
+		SF_CHECK(LatencyHistogram::Bucket(UINT64_MAX) == LatencyHistogram::BucketCount - 1, "UINT64_MAX is in bucket %d", LatencyHistogram::Bucket(UINT64_MAX));
+		uint64_t last = LatencyHistogram::BucketLimit(LatencyHistogram::BucketCount - 1);
+		SF_CHECK(LatencyHistogram::Bucket(last + 1) == LatencyHistogram::BucketCount - 1, "the value past the last limit is in bucket %d", LatencyHistogram::Bucket(last + 1));
+	}
+
+	// What Summarize reports for the sample of rank n: its bucket limit, capped at the maximum
+	uint64_t Reported(uint64_t ns, uint64_t max)
+	{
+		return std::min(LatencyHistogram::BucketLimit(LatencyHistogram::Bucket(ns)), max);
+	}
+
+	void TestPercentiles()
+	{
+		Clock::time_point now = Clock::time_point{} + std::chrono::seconds(10);
+
+		LatencyHistogram histogram;
+		SF_CHECK(histogram.Summarize().samples == 0 && histogram.Summarize().p99 == 0, "an empty histogram has samples");
+
+		// 1..100ns: p50 is the 50th sample, p99 the 99th
+		for (uint64_t ns = 100; ns >= 1; ns--)
+			histogram.Record(ns, now);
+		LatencySummary summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 100 && summary.max == 100, "%" PRIu64 " samples, max %" PRIu64, summary.samples, summary.max);
+		SF_CHECK(summary.p50 == Reported(50, 100) && summary.p50 >= 50, "p50 of 1..100 is %" PRIu64, summary.p50);
+		SF_CHECK(summary.p99 == Reported(99, 100) && summary.p99 >= 99, "p99 of 1..100 is %" PRIu64, summary.p99);
+
+		// Nine fast samples and one slow one: the rank of p99 is the 10th sample, p50 the 5th
+		histogram.Reset();
+		for (int i = 0; i < 9; i++)
+			histogram.Record(10, now);
+		histogram.Record(5000, now);
+		summary = histogram.Summarize();
+		SF_CHECK(summary.p50 == 10, "p50 with one outlier is %" PRIu64, summary.p50);
+		SF_CHECK(summary.p99 == Reported(5000, 5000) && summary.p99 == 5000, "p99 with one outlier in ten is %" PRIu64, summary.p99);
+
+		// With 200 samples one slow sample is below the 99th percentile
+		histogram.Reset();
+		for (int i = 0; i < 199; i++)
+			histogram.Record(10, now);
+		histogram.Record(5000, now);
+		summary = histogram.Summarize();
+		SF_CHECK(summary.p99 == 10 && summary.max == 5000, "p99 with one outlier in 200 is %" PRIu64 ", max %" PRIu64, summary.p99, summary.max);
+
+		// A single sample is every percentile, and never reported above itself
+		histogram.Reset();
+		histogram.Record(1000, now);
+		summary = histogram.Summarize();
+		SF_CHECK(summary.p50 == 1000 && summary.p99 == 1000 && summary.max == 1000, "one sample of 1000ns reads p50 %" PRIu64 ", p99 %" PRIu64, summary.p50, summary.p99);
+
+		// An end before the start is a zero sample, not a wrapped unsigned one
+		histogram.Reset();
+		histogram.Record(now, now - std::chrono::microseconds(5));
+		summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 1 && summary.max == 0, "a negative duration recorded as %" PRIu64 "ns", summary.max);
+	}
+
+	void TestWindows()
+	{
+		using std::chrono::milliseconds;
+		Clock::time_point t0 = Clock::time_point{} + std::chrono::seconds(10);
+
+		LatencyHistogram histogram;
+		for (int i = 0; i < 5; i++)
+			histogram.Record(100, t0);
+		SF_CHECK(histogram.Summarize().samples == 5, "first window has %" PRIu64 " samples", histogram.Summarize().samples);
+
+		// Still within the first window
+		histogram.Record(100, t0 + milliseconds(999));
+		SF_CHECK(histogram.Summarize().samples == 6, "a sample before WindowLength started a new window");
+
+		// One second on, the first window becomes the previous one and still counts
+		for (int i = 0; i < 3; i++)
+			histogram.Record(200, t0 + milliseconds(1000));
+		LatencySummary summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 9 && summary.max == 200, "after one rotation %" PRIu64 " samples, max %" PRIu64, summary.samples, summary.max);
+
+		// Another second on, the first window has expired and only the 200ns ones remain
+		histogram.Record(50, t0 + milliseconds(2500));
+		summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 4 && summary.max == 200, "after two rotations %" PRIu64 " samples, max %" PRIu64, summary.samples, summary.max);
+		SF_CHECK(summary.p50 == Reported(200, 200), "p50 after two rotations is %" PRIu64, summary.p50);
+
+		// Two idle windows: the last samples are more than a window old and both are dropped
+		histogram.Record(70, t0 + milliseconds(4500));
+		summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 1 && summary.max == 70, "after an idle gap %" PRIu64 " samples, max %" PRIu64, summary.samples, summary.max);
+
+		// Between one and two windows idle, the last window is kept
+		histogram.Record(90, t0 + milliseconds(6499));
+		summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 2 && summary.max == 90, "after 1999ms idle %" PRIu64 " samples, max %" PRIu64, summary.samples, summary.max);
+
+		histogram.Reset();
+		summary = histogram.Summarize();
+		SF_CHECK(summary.samples == 0 && summary.max == 0, "Reset kept %" PRIu64 " samples", summary.samples);
+	}
+}
+
+int main()
+{
+	TestBuckets();
+	TestPercentiles();
+	TestWindows();
+	return Headless::TestResult();
+}
@@ -0,0 +1,214 @@
+#include "pch.h"
+#include "Projection.h"
+#include "TrainerMath.h"
+#include "ScalarMath.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+
+// sf_math_test
+// Checks RotatorToOrientation against Unreal's axes and projects known points through
+// ViewProjectionMatrix, so a mirrored or flipped axis fails here instead of on screen.
+// Segments are clipped at the near plane and the screen edges by ProjectSegment.
+// Also checks the error of RotatorSinCos and that the SSE products give exactly the scalar results.
+
+namespace
+{
+	bool Near(const Vector& a, const Vector& b, float tolerance = 1e-5f)
+	{
+		return fabsf(a.X - b.X) <= tolerance && fabsf(a.Y - b.Y) <= tolerance && fabsf(a.Z - b.Z) <= tolerance;
+	}
+
+	void CheckAxes(const Rotator& rotation, const Vector& forward, const Vector& right, const Vector& up)
+	{
+		Orientation o = RotatorToOrientation(rotation);
+		SF_CHECK(Near(o.forward, forward), "forward of (%d, %d, %d) is (%g, %g, %g)", rotation.Pitch, rotation.Yaw, rotation.Roll, o.forward.X, o.forward.Y, o.forward.Z);
+		SF_CHECK(Near(o.right, right), "right of (%d, %d, %d) is (%g, %g, %g)", rotation.Pitch, rotation.Yaw, rotation.Roll, o.right.X, o.right.Y, o.right.Z);
+		SF_CHECK(Near(o.up, up), "up of (%d, %d, %d) is (%g, %g, %g)", rotation.Pitch, rotation.Yaw, rotation.Roll, o.up.X, o.up.Y, o.up.Z);
+	}
+
+	void TestOrientation()
+	{
+		CheckAxes(Rotator(0, 0, 0), Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1));
+		// Quarter turn to the right
+		CheckAxes(Rotator(0, 16384, 0), Vector(0, 1, 0), Vector(-1, 0, 0), Vector(0, 0, 1));
+		// Nose up
+		CheckAxes(Rotator(16384, 0, 0), Vector(0, 0, 1), Vector(0, 1, 0), Vector(-1, 0, 0));
+		// Rolled right, the right side points down
+		CheckAxes(Rotator(0, 0, 16384), Vector(1, 0, 0), Vector(0, 0, -1), Vector(0, 1, 0));
+
+		// Unreal is left-handed, forward x right = up with the usual cross product
+		for (int i = 0; i < 64; i++)
+		{
+			Rotator rotation(i * 1021 - 16000, i * 2039, i * 3001 - 30000);
+			Orientation o = RotatorToOrientation(rotation);
+			SF_CHECK(Near(Vector::cross(o.forward, o.right), o.up, 1e-5f), "axes of (%d, %d, %d) are not forward x right = up", rotation.Pitch, rotation.Yaw, rotation.Roll);
+		}
+	}
+
+	void CheckProjection(const ProjectionContext& projection, const Vector& world, bool visible, int x = 0, int y = 0)
+	{
+		Vector2 screen{ -1, -1 };
+		bool projected = projection.Project(world, screen);
+		SF_CHECK(projected == visible, "(%g, %g, %g) visible is %d", world.X, world.Y, world.Z, projected);
+		if (projected && visible)
+			SF_CHECK(abs(screen.X - x) <= 1 && abs(screen.Y - y) <= 1, "(%g, %g, %g) projects to (%d, %d) instead of (%d, %d)",
+				world.X, world.Y, world.Z, screen.X, screen.Y, x, y);
+	}
+
+	void CheckSegment(const ProjectionContext& projection, const Vector& a, const Vector& b, bool visible, Vector2 expectedA = {}, Vector2 expectedB = {})
+	{
+		Vector2 screenA{ -1, -1 };
+		Vector2 screenB{ -1, -1 };
+		bool projected = projection.ProjectSegment(a, b, screenA, screenB);
+		SF_CHECK(projected == visible, "segment (%g, %g, %g)-(%g, %g, %g) visible is %d", a.X, a.Y, a.Z, b.X, b.Y, b.Z, projected);
+		if (projected && visible)
+			SF_CHECK(abs(screenA.X - expectedA.X) <= 1 && abs(screenA.Y - expectedA.Y) <= 1 && abs(screenB.X - expectedB.X) <= 1 && abs(screenB.Y - expectedB.Y) <= 1,
+				"segment (%g, %g, %g)-(%g, %g, %g) projects to (%d, %d)-(%d, %d) instead of (%d, %d)-(%d, %d)", a.X, a.Y, a.Z, b.X, b.Y, b.Z,
+				screenA.X, screenA.Y, screenB.X, screenB.Y, expectedA.X, expectedA.Y, expectedB.X, expectedB.Y);
+	}
+
+	// ProjectSegment keeps the visible part of a segment whose end points Project rejects
+	void TestSegmentClipping()
+	{
+		Vector2 screen{ 1920, 1080 };
+		ProjectionContext projection(ViewProjectionMatrix(Vector(0, 0, 0), Rotator(0, 0, 0), 90.0f, 1920.0f / 1080.0f), screen);
+
+		// Crosses the near plane at X = 10, where Z = 5 is half way up the screen
+		Vector2 ignored;
+		SF_CHECK(!projection.Project(Vector(-500, 0, 5), ignored), "a point behind the camera is visible");
+		CheckSegment(projection, Vector(-500, 0, 5), Vector(1000, 0, 5), true, Vector2{ 960, 270 }, Vector2{ 960, 537 });
+		CheckSegment(projection, Vector(1000, 0, 5), Vector(-500, 0, 5), true, Vector2{ 960, 537 }, Vector2{ 960, 270 });
+
+		// Entirely behind the camera, and behind it on both sides of the view
+		CheckSegment(projection, Vector(-1000, 0, 0), Vector(-50, 200, 100), false);
+		CheckSegment(projection, Vector(-100, -5000, 0), Vector(-100, 5000, 0), false);
+
+		// Leaves the screen through the right edge at Y / X = 16 / 9, and through the top at Z / X = 1
+		CheckSegment(projection, Vector(1000, 0, 0), Vector(1000, 5000, 0), true, Vector2{ 960, 540 }, Vector2{ 1920, 540 });
+		CheckSegment(projection, Vector(1000, 0, 0), Vector(1000, 0, 3000), true, Vector2{ 960, 540 }, Vector2{ 960, 0 });
+		// Both ends off screen, left and right, the middle still crosses it
+		CheckSegment(projection, Vector(1000, -5000, 0), Vector(1000, 5000, 0), true, Vector2{ 0, 540 }, Vector2{ 1920, 540 });
+
+		// Fully inside, the ends are the projected points
+		CheckSegment(projection, Vector(1000, 500, 0), Vector(1000, 0, 300), true, Vector2{ 1230, 540 }, Vector2{ 960, 378 });
+	}
+
+	void TestProjection()
+	{
+		Vector2 screen{ 1920, 1080 };
+		float aspect = 1920.0f / 1080.0f;
+
+		// Camera at the origin looking down +X with a 90 degree FOV: x = 960 + 540 * Y / X, y = 540 - 540 * Z / X
+		ProjectionContext projection(ViewProjectionMatrix(Vector(0, 0, 0), Rotator(0, 0, 0), 90.0f, aspect), screen);
+		CheckProjection(projection, Vector(1000, 0, 0), true, 960, 540);
+		CheckProjection(projection, Vector(1000, 500, 0), true, 1230, 540);
+		CheckProjection(projection, Vector(1000, -500, 0), true, 690, 540);
+		CheckProjection(projection, Vector(1000, 0, 300), true, 960, 378);
+		CheckProjection(projection, Vector(-1000, 0, 0), false);
+		CheckProjection(projection, Vector(1000, 5000, 0), false);
+
+		// Turned a quarter to the right, +X is now on the left
+		ProjectionContext turned(ViewProjectionMatrix(Vector(0, 0, 0), Rotator(0, 16384, 0), 90.0f, aspect), screen);
+		CheckProjection(turned, Vector(-500, 1000, 0), true, 1230, 540);
+		CheckProjection(turned, Vector(500, 1000, 0), true, 690, 540);
+
+		// ProjectBatch has to agree with Project, including the lanes of its SSE path
+		Vector points[7] = { Vector(1000, 500, 0), Vector(1000, -500, 0), Vector(-1000, 0, 0), Vector(1000, 0, 300),
+			Vector(2000, 100, -50), Vector(5, 0, 0), Vector(1000, 5000, 0) };
+		Vector2 batch[7];
+		bool visible[7];
+		projection.ProjectBatch(points, 7, batch, visible);
+		for (int i = 0; i < 7; i++)
+		{
+			Vector2 single{ 0, 0 };
+			bool projected = projection.Project(points[i], single);
+			SF_CHECK(visible[i] == projected, "ProjectBatch visibility of point %d", i);
+			if (projected && visible[i])
+				SF_CHECK(batch[i].X == single.X && batch[i].Y == single.Y, "ProjectBatch position of point %d", i);
+		}
+	}
+
+	// The table error documented for RotatorSinCos, against double precision sin/cos
+	void TestRotatorSinCos()
+	{
+		double maxError = 0;
+		for (int units = -65536; units < 131072; units++)
+		{
+			float s, c;
+			RotatorSinCos(units, s, c);
+			double radians = units * (3.14159265358979323846 / 32768.0);
+			maxError = std::max(maxError, std::max(fabs(s - sin(radians)), fabs(c - cos(radians))));
+		}
+		SF_CHECK(maxError < 1.5e-7, "RotatorSinCos is off by up to %g", maxError);
+	}
+
+	// Deterministic values over several magnitudes, with both signs
+	float NextValue(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		float unit = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+		static const float Scales[] = { 1e-3f, 1.0f, 37.0f, 3e4f };
+		return unit * Scales[state & 3];
+	}
+
+	Matrix NextMatrix(uint32_t& state)
+	{
+		Matrix m;
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				m.M[i][j] = NextValue(state);
+		return m;
+	}
+
+	// == so the sign of a zero sum may differ, everything else has to match exactly
+	bool Same(const Vector4& a, const Vector4& b)
+	{
+		return a.X == b.X && a.Y == b.Y && a.Z == b.Z && a.W == b.W;
+	}
+
+	void TestSseMatchesScalar()
+	{
+		uint32_t state = 12345;
+		for (int round = 0; round < 200; round++)
+		{
+			Matrix a = NextMatrix(state);
+			Matrix b = NextMatrix(state);
+
+			Matrix product = a * b;
+			Matrix expected = ScalarMath::Multiply(a, b);
+			for (int i = 0; i < 4; i++)
+				for (int j = 0; j < 4; j++)
+					SF_CHECK(product.M[i][j] == expected.M[i][j], "round %d: (a * b)[%d][%d] is %.9g instead of %.9g", round, i, j, product.M[i][j], expected.M[i][j]);
+
+			Vector4 v(NextValue(state), NextValue(state), NextValue(state), NextValue(state));
+			SF_CHECK(Same(a * v, ScalarMath::Multiply(a, v)), "round %d: matrix * Vector4", round);
+		}
+
+		// Every count up to three full blocks, so each count % 4 tail goes through the scalar loop
+		Matrix m = NextMatrix(state);
+		Vector points[15];
+		for (Vector& p : points)
+			p = Vector(NextValue(state), NextValue(state), NextValue(state));
+		for (int count = 0; count <= 15; count++)
+		{
+			Vector4 out[15];
+			Vector4 expected[15];
+			TransformPoints(m, points, count, out);
+			ScalarMath::TransformPoints(m, points, count, expected);
+			for (int i = 0; i < count; i++)
+				SF_CHECK(Same(out[i], expected[i]), "TransformPoints of %d points differs at point %d", count, i);
+		}
+	}
+}
+
+int main()
+{
+	TestOrientation();
+	TestProjection();
+	TestSegmentClipping();
+	TestRotatorSinCos();
+	TestSseMatchesScalar();
+	return Headless::TestResult();
+}
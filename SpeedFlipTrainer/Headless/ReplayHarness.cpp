@@ -0,0 +1,194 @@
+#include "pch.h"
+#include "ReplayHarness.h"
+#include "FakeGame.h"
+#include "TrainerSession.h"
+#include "FileIO.h"
+
+#include <algorithm>
+
+namespace
+{
+	uint32_t ChecksumInput(int tick, const ControllerInput& input, uint32_t crc)
+	{
+		float axes[] = { input.Throttle, input.Steer, input.Pitch, input.Yaw, input.Roll, input.DodgeForward, input.DodgeStrafe };
+		uint8_t buttons = static_cast<uint8_t>(input.Handbrake | input.Jump << 1 | input.ActivateBoost << 2 | input.HoldingBoost << 3 | input.Jumped << 4);
+		crc = Crc32(&tick, sizeof(tick), crc);
+		crc = Crc32(axes, sizeof(axes), crc);
+		return Crc32(&buttons, sizeof(buttons), crc);
+	}
+
+	// What the game would report on this tick if the car had driven the recording.
+	// Without a physics track the car state follows the inputs: Jumped is set on the tick
+	// a jump starts, the first one leaves the ground and a second one with a stick
+	// direction is the dodge, which fills the dodge component from the dodge inputs.
+	void SetTick(Headless::FakeWorld& world, int tick, const ControllerInput& input, const PhysicsTrack& physics)
+	{
+		world.physicsFrame = ReplayHarness::FirstPhysicsFrame + tick;
+		world.timeRemaining = ReplayHarness::RoundTime - (tick + 1) / ReplayHarness::TickRate;
+
+		Headless::FakeCar& car = world.car;
+		car.input = input;
+
+		bool wasDodging = car.dodging;
+		PhysicsState state;
+		if (physics.Get(tick, state))
+		{
+			car.location = state.location;
+			car.rotation = state.rotation;
+			car.velocity = state.velocity;
+			car.angularVelocity = state.angularVelocity;
+			car.boost = state.boost;
+			car.onGround = state.onGround;
+			car.jumped = state.jumped;
+			car.dodging = state.dodging;
+		}
+		else if (input.Jumped)
+		{
+			bool hasDirection = input.DodgeForward != 0 || input.DodgeStrafe != 0;
+			car.dodging = car.jumped && hasDirection;
+			car.jumped = true;
+			car.onGround = false;
+		}
+
+		if (car.dodging && !wasDodging)
+		{
+			car.dodgeDirection = Vector(input.DodgeForward, input.DodgeStrafe, 0);
+			car.dodgeTorque = Vector(1.0f, 0, 0);
+		}
+	}
+}
+
+std::string ReplayReport::ToString() const
+{
+	std::string text = fmt::format("{} ({} ticks, {} replayed, {} replay mismatches, {} record mismatches, {} wrapper calls max",
+		Passed() ? "passed" : "FAILED", ticks, replayedTicks, replayMismatches, recordMismatches, maxWrapperCalls);
+	if (wrapperCallMismatches > 0)
+		text += fmt::format(", {} ticks miscounted", wrapperCallMismatches);
+	if (overBudgetTicks > 0)
+		text += fmt::format(", {} ticks over budget", overBudgetTicks);
+	text += ")";
+	if (jumped)
+		text += fmt::format(", jump {}", jumpTick);
+	if (dodged)
+		text += fmt::format(", dodge {} deg at {}", dodgeAngle, dodgedTick);
+	if (flipCanceled)
+		text += fmt::format(", cancel {}", flipCancelTick);
+	text += fmt::format(", no boost {}, no throttle {}, checksum {:08x}", ticksNotPressingBoost, ticksNotPressingThrottle, checksum);
+	return text;
+}
+
+ReplayReport ReplayHarness::Run(const std::shared_ptr<const Attempt>& recording)
+{
+	ReplayReport report;
+	if (!recording || !recording->HasInputs())
+		return report;
+
+	// Mapped .sfa files keep their physics in the file
+	PhysicsTrack mappedPhysics;
+	const PhysicsTrack* physics = &recording->physics;
+	if (recording->mapped && recording->mapped->HasPhysics())
+	{
+		recording->mapped->CopyPhysicsTo(mappedPhysics);
+		physics = &mappedPhysics;
+	}
+
+	Headless::FakeWorld world;
+	GameWrapper game(world);
+	CarWrapper car(&world); // Passed to the hook as the caller, not through a wrapper call
+	bool capturePhysics = !physics->empty();
+
+	TrainerSession session;
+	session.mode = SpeedFlipTrainerMode::Replay;
+	session.replayAttempt = recording;
+	session.OnRestart(RoundTime);
+
+	InputRuns::Cursor cursor;
+	int end = recording->End();
+	for (int tick = 0; tick < end; tick++)
+	{
+		ControllerInput expected = {};
+		if (!recording->Play(&expected, tick, cursor))
+			continue;
+
+		SetTick(world, tick, expected, *physics);
+		world.calls = 0;
+		report.ticks++;
+
+		// Same steps as the SetVehicleInput hook
+		if (!game.IsInCustomTraining())
+			continue;
+		CarTickSnapshot snap = CarTickSnapshot::Capture(game, car, session.NeedsDodge(), capturePhysics);
+		snap.wrapperCalls++; // IsInCustomTraining
+
+		ControllerInput ci = expected;
+		if (session.OnTick(snap, &ci))
+		{
+			game.OverrideParams(&ci, sizeof(ControllerInput));
+			snap.wrapperCalls++;
+
+			report.replayedTicks++;
+			if (!SameControllerInput(world.car.input, expected))
+				report.replayMismatches++;
+		}
+
+		if (snap.wrapperCalls != world.calls)
+			report.wrapperCallMismatches++;
+		if (snap.wrapperCalls > snap.WrapperCallLimit())
+			report.overBudgetTicks++;
+		report.maxWrapperCalls = std::max(report.maxWrapperCalls, world.calls);
+	}
+
+	RoundResult round = session.OnRestart(RoundTime);
+	const Attempt* measured = round.attempt.get();
+	if (!measured)
+	{
+		report.recordMismatches = report.ticks;
+		return report;
+	}
+
+	// The session started recording on the first tick, so ticks line up with the file
+	uint32_t crc = 0;
+	cursor.Reset();
+	for (int tick = 0; tick < end; tick++)
+	{
+		ControllerInput expected = {};
+		if (!recording->Play(&expected, tick, cursor))
+			continue;
+
+		const ControllerInput* recorded = measured->inputs.Find(tick);
+		if (!recorded || !SameControllerInput(*recorded, expected))
+			report.recordMismatches++;
+		if (recorded)
+			crc = ChecksumInput(tick, *recorded, crc);
+	}
+
+	report.jumped = measured->jumped;
+	report.jumpTick = measured->jumpTick;
+	report.dodged = measured->dodged;
+	report.dodgedTick = measured->dodgedTick;
+	report.dodgeAngle = measured->dodgeAngle;
+	report.flipCanceled = measured->flipCanceled;
+	report.flipCancelTick = measured->flipCancelTick;
+	report.ticksNotPressingBoost = measured->ticksNotPressingBoost;
+	report.ticksNotPressingThrottle = measured->ticksNotPressingThrottle;
+
+	int metrics[] = { report.jumped, report.jumpTick, report.dodged, report.dodgedTick, report.dodgeAngle,
+		report.flipCanceled, report.flipCancelTick, report.ticksNotPressingBoost, report.ticksNotPressingThrottle };
+	report.checksum = Crc32(metrics, sizeof(metrics), crc);
+	return report;
+}
+
+bool ReplayHarness::RunFile(const std::filesystem::path& path, ReplayReport& report, std::string* error)
+{
+	auto recording = std::make_shared<Attempt>();
+	ParseError parseError;
+	if (!recording->ReadInputsFromFile(path, &parseError))
+	{
+		if (error) *error = parseError.ToString();
+		return false;
+	}
+
+	recording->Freeze();
+	report = Run(recording);
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Attempt.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Outcome of one recorded attempt played through the SetVehicleInput hook
+struct ReplayReport
+{
+	int ticks = 0;            // Recorded ticks fed to the hook
+	int replayedTicks = 0;    // Ticks the session overrode with the replay
+	int replayMismatches = 0; // Overridden inputs that differ from the recording
+	int recordMismatches = 0; // Ticks the session recorded differently from the file
+	int wrapperCallMismatches = 0; // Ticks where CarTickSnapshot::wrapperCalls missed a call
+	int overBudgetTicks = 0;       // Ticks over CarTickSnapshot::WrapperCallLimit
+	int maxWrapperCalls = 0;
+
+	// What the session measured
+	bool jumped = false;
+	int jumpTick = 0;
+	bool dodged = false;
+	int dodgedTick = 0;
+	int dodgeAngle = 0;
+	bool flipCanceled = false;
+	int flipCancelTick = 0;
+	int ticksNotPressingBoost = 0;
+	int ticksNotPressingThrottle = 0;
+
+	// CRC-32 of the recorded inputs and the measurements, equal runs give equal checksums
+	uint32_t checksum = 0;
+
+	bool Passed() const
+	{
+		return ticks > 0 && replayMismatches == 0 && recordMismatches == 0 && wrapperCallMismatches == 0 && overBudgetTicks == 0;
+	}
+	std::string ToString() const;
+};
+
+// Feeds a recorded attempt through the trainer the way the game does: a restart starts the
+// round clock, then every recorded tick is written to a Headless::FakeWorld and goes through
+// the same steps as the SetVehicleInput hook (CarTickSnapshot::Capture, TrainerSession::OnTick
+// in replay mode with the recording as the player's input, OverrideParams), and a final
+// restart hands the attempt back.
+// The car state comes from the recording (its physics track when it has one) and the clock
+// from the tick number, so a run only depends on the file and is deterministic.
+class ReplayHarness
+{
+public:
+	static constexpr int FirstPhysicsFrame = 1000;
+	static constexpr float RoundTime = 300.0f;
+	static constexpr float TickRate = 120.0f;
+
+	static ReplayReport Run(const std::shared_ptr<const Attempt>& recording);
+	// Reads a .csv or .sfa attempt and runs it
+	static bool RunFile(const std::filesystem::path& path, ReplayReport& report, std::string* error = nullptr);
+};
@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "ReplayHarness.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// sf_replay [--verbose] [--baseline <file>] [--write-baseline <file>] <attempt.csv|attempt.sfa>...
+// Plays every attempt through the hook pipeline and prints one report per file. With
+// --baseline the checksums have to match the ones recorded by --write-baseline.
+// Exits with 1 if any attempt fails or differs from the baseline.
+
+namespace
+{
+	using Baseline = std::map<std::string, uint32_t>;
+
+	bool ReadBaseline(const std::filesystem::path& path, Baseline& baseline)
+	{
+		std::ifstream in(path);
+		if (!in)
+			return false;
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+			std::istringstream fields(line);
+			std::string name;
+			std::string checksum;
+			if (fields >> name >> checksum)
+				baseline[name] = static_cast<uint32_t>(std::stoul(checksum, nullptr, 16));
+		}
+		return true;
+	}
+
+	bool WriteBaseline(const std::filesystem::path& path, const Baseline& baseline)
+	{
+		std::ofstream out(path);
+		if (!out)
+			return false;
+		out << "# Replay checksums written by sf_replay --write-baseline\n";
+		for (const auto& [name, checksum] : baseline)
+			out << name << ' ' << fmt::format("{:08x}", checksum) << '\n';
+		return static_cast<bool>(out);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool verbose = false;
+	std::filesystem::path baselinePath;
+	std::filesystem::path writeBaselinePath;
+	std::vector<std::filesystem::path> files;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--verbose") == 0)
+			verbose = true;
+		else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+			baselinePath = argv[++i];
+		else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc)
+			writeBaselinePath = argv[++i];
+		else
+			files.push_back(argv[i]);
+	}
+	if (files.empty())
+	{
+		fprintf(stderr, "usage: sf_replay [--verbose] [--baseline <file>] [--write-baseline <file>] <attempt>...\n");
+		return 2;
+	}
+
+	AsyncLogger::Instance().Start([verbose](LogLevel, const std::string& line) {
+		if (verbose)
+			fprintf(stderr, "  %s\n", line.c_str());
+	});
+
+	Baseline expected;
+	if (!baselinePath.empty() && !ReadBaseline(baselinePath, expected))
+	{
+		fprintf(stderr, "cannot read baseline %s\n", baselinePath.string().c_str());
+		return 2;
+	}
+
+	Baseline results;
+	int failed = 0;
+	for (const auto& file : files)
+	{
+		std::string name = file.filename().string();
+		ReplayReport report;
+		std::string error;
+		if (!ReplayHarness::RunFile(file, report, &error))
+		{
+			printf("%s: cannot read (%s)\n", name.c_str(), error.c_str());
+			failed++;
+			continue;
+		}
+
+		bool passed = report.Passed();
+		std::string note;
+		if (!baselinePath.empty())
+		{
+			auto it = expected.find(name);
+			if (it == expected.end())
+				note = ", not in baseline";
+			else if (it->second != report.checksum)
+				note = fmt::format(", baseline {:08x}", it->second);
+			passed = passed && note.empty();
+		}
+		printf("%s: %s%s\n", name.c_str(), report.ToString().c_str(), note.c_str());
+		if (!passed)
+			failed++;
+		results[name] = report.checksum;
+	}
+	AsyncLogger::Instance().Stop();
+
+	if (!writeBaselinePath.empty() && !WriteBaseline(writeBaselinePath, results))
+	{
+		fprintf(stderr, "cannot write baseline %s\n", writeBaselinePath.string().c_str());
+		return 2;
+	}
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "TrainerMath.h"
+
+// Plain scalar versions of the TrainerMath products, in the same order of operations as
+// the SSE paths. sf_math_test checks the SSE results against them, sf_bench times both.
+namespace ScalarMath
+{
+	inline Vector4 Multiply(const Matrix& m, const Vector4& v)
+	{
+		return Vector4(
+			m.M[0][0] * v.X + m.M[0][1] * v.Y + m.M[0][2] * v.Z + m.M[0][3] * v.W,
+			m.M[1][0] * v.X + m.M[1][1] * v.Y + m.M[1][2] * v.Z + m.M[1][3] * v.W,
+			m.M[2][0] * v.X + m.M[2][1] * v.Y + m.M[2][2] * v.Z + m.M[2][3] * v.W,
+			m.M[3][0] * v.X + m.M[3][1] * v.Y + m.M[3][2] * v.Z + m.M[3][3] * v.W);
+	}
+
+	inline Matrix Multiply(const Matrix& a, const Matrix& b)
+	{
+		Matrix result;
+		for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
+				result.M[i][j] = a.M[i][0] * b.M[0][j] + a.M[i][1] * b.M[1][j] + a.M[i][2] * b.M[2][j] + a.M[i][3] * b.M[3][j];
+		return result;
+	}
+
+	inline void TransformPoints(const Matrix& m, const Vector* points, int count, Vector4* out)
+	{
+		for (int i = 0; i < count; i++)
+			out[i] = Multiply(m, Vector4(points[i], 1.0f));
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the headless test executables. A failed check is printed and
+// counted, the executable returns TestResult() from main so ctest sees the failure.
+namespace Headless
+{
+	inline int& FailedChecks()
+	{
+		static int failed = 0;
+		return failed;
+	}
+
+	inline int TestResult()
+	{
+		if (FailedChecks() > 0)
+			printf("%d check(s) failed\n", FailedChecks());
+		return FailedChecks() > 0 ? 1 : 0;
+	}
+}
+
+#define SF_CHECK(condition, ...) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			Headless::FailedChecks()++; \
+			printf("%s:%d: %s failed: ", __FILE__, __LINE__, #condition); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+		} \
+	} while (0)
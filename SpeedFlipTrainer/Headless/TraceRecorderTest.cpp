@@ -0,0 +1,369 @@
+#include "pch.h"
+#include "TraceRecorder.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// sf_trace_recorder_test
+// Records from several threads while the main thread takes snapshots, past the end of each
+// ring and past MaxThreads. Every snapshot has to be ordered by start and hold no torn event,
+// and its FormatJson output has to parse as JSON with the same events in the same order.
+
+namespace
+{
+	using Clock = TraceRecorder::Clock;
+
+	constexpr int RecordingThreads = 6;
+	constexpr int EventsPerRecordingThread = 3 * static_cast<int>(TraceRecorder::EventsPerThread) + 123;
+	const char* const ThreadNames[RecordingThreads] = { "one", "two", "three", "four", "five", "six" };
+	const char* const EventNames[RecordingThreads] = { "e1", "e2", "e3", "e4", "e5", "e6" };
+
+	// Event i of a thread starts at base + i us and lasts i ns, so start - 1000 * duration is the
+	// same for every event of the thread. A slot read while it was rewritten breaks that.
+	void Record(TraceRecorder& recorder, Clock::time_point base, int thread)
+	{
+		recorder.NameThread(ThreadNames[thread]);
+		for (int i = 0; i < EventsPerRecordingThread; i++)
+		{
+			Clock::time_point start = base + std::chrono::microseconds(i);
+			recorder.Complete(EventNames[thread], start, start + std::chrono::nanoseconds(i));
+		}
+	}
+
+	// Returns the number of events checked, per recorded thread id
+	std::map<uint32_t, int> CheckSnapshot(const TraceSnapshot& snapshot, const char* when)
+	{
+		std::map<uint32_t, int> counts;
+		std::map<uint32_t, int64_t> origins;
+		std::map<uint32_t, int64_t> lastDuration;
+		std::map<uint32_t, const char*> names;
+		for (size_t i = 0; i < snapshot.events.size(); i++)
+		{
+			const TraceEvent& event = snapshot.events[i];
+			if (i > 0 && event.start < snapshot.events[i - 1].start)
+			{
+				SF_CHECK(false, "%s: event %zu starts before the one ahead of it", when, i);
+				break;
+			}
+
+			int64_t origin = event.start - 1000 * event.duration;
+			auto known = origins.emplace(event.thread, origin);
+			auto name = names.emplace(event.thread, event.name);
+			bool torn = known.first->second != origin || name.first->second != event.name || event.argName != nullptr;
+			bool reordered = !known.second && event.duration <= lastDuration[event.thread];
+			if (torn || reordered)
+			{
+				SF_CHECK(false, "%s: event %zu of thread %u is %s", when, i, event.thread, torn ? "torn" : "out of order");
+				break;
+			}
+			lastDuration[event.thread] = event.duration;
+			counts[event.thread]++;
+		}
+		return counts;
+	}
+
+	// Just enough of a JSON parser to tell whether FormatJson wrote valid JSON, and to read it back
+	struct Json
+	{
+		enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+		double number = 0;
+		std::string text;
+		std::vector<Json> items;
+		std::vector<std::pair<std::string, Json>> members;
+
+		const Json* Find(const char* key) const
+		{
+			for (const auto& member : members)
+				if (member.first == key)
+					return &member.second;
+			return nullptr;
+		}
+	};
+
+	class JsonParser
+	{
+	public:
+		explicit JsonParser(const std::string& input) : input(input) {}
+
+		bool Parse(Json& out)
+		{
+			if (!Value(out))
+				return false;
+			Skip();
+			return pos == input.size();
+		}
+
+	private:
+		void Skip()
+		{
+			while (pos < input.size() && isspace(static_cast<unsigned char>(input[pos])))
+				pos++;
+		}
+
+		bool Eat(char c)
+		{
+			Skip();
+			if (pos < input.size() && input[pos] == c)
+			{
+				pos++;
+				return true;
+			}
+			return false;
+		}
+
+		bool Literal(const char* word)
+		{
+			size_t length = strlen(word);
+			if (input.compare(pos, length, word) != 0)
+				return false;
+			pos += length;
+			return true;
+		}
+
+		bool Str(std::string& out)
+		{
+			if (!Eat('"'))
+				return false;
+			while (pos < input.size() && input[pos] != '"')
+			{
+				// The recorder writes no escapes, a control character or backslash is an error
+				if (input[pos] == '\\' || static_cast<unsigned char>(input[pos]) < 0x20)
+					return false;
+				out += input[pos++];
+			}
+			return Eat('"');
+		}
+
+		bool Value(Json& out)
+		{
+			Skip();
+			if (pos >= input.size())
+				return false;
+
+			char c = input[pos];
+			if (c == '{')
+			{
+				pos++;
+				out.type = Json::Object;
+				if (Eat('}'))
+					return true;
+				do
+				{
+					std::string key;
+					Json value;
+					if (!Str(key) || !Eat(':') || !Value(value))
+						return false;
+					out.members.emplace_back(std::move(key), std::move(value));
+				} while (Eat(','));
+				return Eat('}');
+			}
+			if (c == '[')
+			{
+				pos++;
+				out.type = Json::Array;
+				if (Eat(']'))
+					return true;
+				do
+				{
+					out.items.emplace_back();
+					if (!Value(out.items.back()))
+						return false;
+				} while (Eat(','));
+				return Eat(']');
+			}
+			if (c == '"')
+			{
+				out.type = Json::String;
+				return Str(out.text);
+			}
+			if (c == '-' || isdigit(static_cast<unsigned char>(c)))
+			{
+				// Strict JSON numbers: no leading zeros, digits on both sides of the point
+				size_t start = pos;
+				if (input[pos] == '-')
+					pos++;
+				size_t digits = pos;
+				while (pos < input.size() && isdigit(static_cast<unsigned char>(input[pos])))
+					pos++;
+				if (pos == digits || (input[digits] == '0' && pos - digits > 1))
+					return false;
+				if (pos < input.size() && input[pos] == '.')
+				{
+					size_t fraction = ++pos;
+					while (pos < input.size() && isdigit(static_cast<unsigned char>(input[pos])))
+						pos++;
+					if (pos == fraction)
+						return false;
+				}
+				out.type = Json::Number;
+				out.number = strtod(input.c_str() + start, nullptr);
+				return true;
+			}
+			if (Literal("true") || Literal("false"))
+			{
+				out.type = Json::Bool;
+				return true;
+			}
+			if (Literal("null"))
+				return true;
+			return false;
+		}
+
+		const std::string& input;
+		size_t pos = 0;
+	};
+
+	void CheckJson(const TraceSnapshot& snapshot)
+	{
+		fmt::memory_buffer buffer;
+		snapshot.FormatJson(buffer);
+		std::string text(buffer.data(), buffer.size());
+
+		Json root;
+		if (!JsonParser(text).Parse(root))
+		{
+			SF_CHECK(false, "FormatJson output is not valid JSON");
+			return;
+		}
+
+		const Json* events = root.Find("traceEvents");
+		if (!events || events->type != Json::Array)
+		{
+			SF_CHECK(false, "FormatJson output has no traceEvents array");
+			return;
+		}
+		SF_CHECK(events->items.size() == snapshot.threads.size() + snapshot.events.size(),
+			"%zu trace events for %zu threads and %zu events", events->items.size(), snapshot.threads.size(), snapshot.events.size());
+
+		// Thread names come first, then the events in snapshot order with ts in microseconds
+		size_t next = 0;
+		double lastTs = -1;
+		for (const Json& item : events->items)
+		{
+			const Json* ph = item.Find("ph");
+			const Json* name = item.Find("name");
+			const Json* tid = item.Find("tid");
+			if (!ph || !name || !tid || ph->type != Json::String)
+			{
+				SF_CHECK(false, "trace event without ph, name or tid");
+				return;
+			}
+			if (ph->text == "M")
+				continue;
+
+			const Json* ts = item.Find("ts");
+			if (next >= snapshot.events.size() || !ts || ts->type != Json::Number)
+			{
+				SF_CHECK(false, "trace event %zu has no ts or is one too many", next);
+				return;
+			}
+			const TraceEvent& event = snapshot.events[next++];
+			SF_CHECK(ts->number >= lastTs, "ts %.3f comes after %.3f", ts->number, lastTs);
+			SF_CHECK(fabs(ts->number - event.start / 1000.0) < 1e-6, "ts %.3f for a start of %lldns", ts->number, static_cast<long long>(event.start));
+			SF_CHECK(name->text == event.name && static_cast<uint32_t>(tid->number) == event.thread, "event %zu is %s on %g", next - 1, name->text.c_str(), tid->number);
+			SF_CHECK(ph->text == (event.duration >= 0 ? "X" : "i"), "event %zu has ph %s", next - 1, ph->text.c_str());
+			if (event.argName)
+			{
+				const Json* args = item.Find("args");
+				const Json* arg = args ? args->Find(event.argName) : nullptr;
+				SF_CHECK(arg && arg->type == Json::Number && arg->number == static_cast<double>(event.arg), "event %zu lost its argument", next - 1);
+			}
+			lastTs = ts->number;
+		}
+		SF_CHECK(next == snapshot.events.size(), "%zu of %zu events in the JSON", next, snapshot.events.size());
+	}
+
+	void TestConcurrentRecording()
+	{
+		TraceRecorder recorder;
+		Clock::time_point base = Clock::now();
+
+		std::atomic<int> running{ RecordingThreads };
+		std::vector<std::thread> threads;
+		for (int t = 0; t < RecordingThreads; t++)
+			threads.emplace_back([&, t] {
+				Record(recorder, base + std::chrono::nanoseconds(t), t);
+				running--;
+			});
+
+		// Snapshots while the rings are written and wrap
+		int snapshots = 0;
+		while (running > 0 || snapshots < 3)
+		{
+			TraceSnapshot snapshot = recorder.Snapshot();
+			CheckSnapshot(snapshot, "while recording");
+			if (snapshots++ % 8 == 0)
+				CheckJson(snapshot);
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Each ring holds the last EventsPerThread events of its thread
+		TraceSnapshot snapshot = recorder.Snapshot();
+		std::map<uint32_t, int> counts = CheckSnapshot(snapshot, "after recording");
+		SF_CHECK(snapshot.threads.size() == RecordingThreads, "%zu threads recorded", snapshot.threads.size());
+		for (const auto& count : counts)
+			SF_CHECK(count.second == static_cast<int>(TraceRecorder::EventsPerThread), "thread %u kept %d events", count.first, count.second);
+		SF_CHECK(counts.size() == RecordingThreads, "events of %zu threads", counts.size());
+
+		// The oldest kept event of a thread is the first one not overwritten
+		std::map<uint32_t, int64_t> shortest;
+		for (const TraceEvent& event : snapshot.events)
+			if (!shortest.count(event.thread) || event.duration < shortest[event.thread])
+				shortest[event.thread] = event.duration;
+		for (const auto& oldest : shortest)
+			SF_CHECK(oldest.second == EventsPerRecordingThread - static_cast<int64_t>(TraceRecorder::EventsPerThread),
+				"the oldest event of thread %u is %lld", oldest.first, static_cast<long long>(oldest.second));
+
+		for (const TraceThread& thread : snapshot.threads)
+		{
+			bool named = false;
+			for (const char* name : ThreadNames)
+				named = named || (thread.name && strcmp(thread.name, name) == 0);
+			SF_CHECK(named, "thread %u is not named", thread.id);
+		}
+		CheckJson(snapshot);
+	}
+
+	void TestThreadLimit()
+	{
+		TraceRecorder recorder;
+		constexpr uint32_t Threads = TraceRecorder::MaxThreads + 4;
+
+		// One after the other, so the first MaxThreads get the buffers
+		for (uint32_t t = 0; t < Threads; t++)
+		{
+			std::thread([&recorder, t] {
+				recorder.Instant("started", "thread", t);
+				recorder.Instant("done");
+			}).join();
+		}
+
+		// An instant event and a thread without a name still format as valid JSON
+		TraceSnapshot snapshot = recorder.Snapshot();
+		SF_CHECK(snapshot.threads.size() == TraceRecorder::MaxThreads, "%zu threads recorded, MaxThreads is %u", snapshot.threads.size(), TraceRecorder::MaxThreads);
+		SF_CHECK(snapshot.events.size() == 2 * TraceRecorder::MaxThreads, "%zu events from %u threads", snapshot.events.size(), TraceRecorder::MaxThreads);
+		for (const TraceEvent& event : snapshot.events)
+		{
+			if (event.argName)
+				SF_CHECK(event.arg < TraceRecorder::MaxThreads, "thread %lld past MaxThreads was recorded", static_cast<long long>(event.arg));
+			SF_CHECK(event.duration < 0, "an instant event has a duration");
+		}
+		CheckJson(snapshot);
+	}
+}
+
+int main()
+{
+	TestConcurrentRecording();
+	TestThreadLimit();
+	return Headless::TestResult();
+}
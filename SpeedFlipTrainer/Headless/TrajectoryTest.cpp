@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "Trajectory.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <vector>
+
+// sf_trajectory_test
+// Checks the ring of stored points across the wrap at Capacity, and that the statistics
+// updated on every Push match the same values recomputed from every point pushed.
+
+namespace
+{
+	constexpr int PathTicks = 3000; // Wraps the ring almost three times
+
+	// A kickoff-like path: forward along Y with a sideways wobble and a jump. Built once, so
+	// a point recomputed in a check cannot differ from the pushed one by a folded sinf.
+	Vector PathPoint(int tick)
+	{
+		static const std::vector<Vector> points = [] {
+			std::vector<Vector> built;
+			for (int i = 0; i < PathTicks; i++)
+				built.push_back(Vector(40.0f * sinf(i * 0.05f), -2048.0f + i * 12.0f, 17.0f + (i % 200 < 60 ? i % 200 : 0) * 1.5f));
+			return built;
+		}();
+		return points[tick];
+	}
+
+	bool Same(const Vector& a, const Vector& b)
+	{
+		return a.X == b.X && a.Y == b.Y && a.Z == b.Z;
+	}
+
+	void TestRingWrap()
+	{
+		static Trajectory trajectory;
+		trajectory.Reset();
+		SF_CHECK(trajectory.IsEmpty() && trajectory.Size() == 0, "a reset trajectory is not empty");
+
+		for (int pushed = 1; pushed <= Trajectory::Capacity + 300; pushed++)
+		{
+			trajectory.Push(PathPoint(pushed - 1));
+
+			int expectedSize = pushed < Trajectory::Capacity ? pushed : Trajectory::Capacity;
+			if (trajectory.Size() != expectedSize || trajectory.TotalPoints() != pushed)
+			{
+				SF_CHECK(false, "after %d pushes Size is %d and TotalPoints %d", pushed, trajectory.Size(), trajectory.TotalPoints());
+				return;
+			}
+
+			// Just before, at and just after the wrap, and well past it, every slot is checked
+			if (pushed == Trajectory::Capacity - 1 || pushed == Trajectory::Capacity || pushed == Trajectory::Capacity + 1
+				|| pushed == Trajectory::Capacity + 300)
+			{
+				int oldest = pushed - expectedSize;
+				for (int i = 0; i < expectedSize; i++)
+					SF_CHECK(Same(trajectory.At(i), PathPoint(oldest + i)), "after %d pushes At(%d) is not tick %d", pushed, i, oldest + i);
+			}
+		}
+
+		SF_CHECK(Same(trajectory.Start(), PathPoint(0)), "Start is not the first point after the ring wrapped");
+		SF_CHECK(Same(trajectory.Current(), PathPoint(Trajectory::Capacity + 299)), "Current is not the last point");
+
+		trajectory.Reset();
+		SF_CHECK(trajectory.IsEmpty() && trajectory.PathLength() == 0 && trajectory.MaxLateralDeviation() == 0, "Reset kept state");
+	}
+
+	void TestStatistics()
+	{
+		static Trajectory trajectory;
+		trajectory.Reset();
+
+		constexpr int Ticks = PathTicks;
+		double length = 0;
+		double maxLateral = 0;
+		Vector start = PathPoint(0);
+		for (int tick = 0; tick < Ticks; tick++)
+		{
+			Vector p = PathPoint(tick);
+			trajectory.Push(p);
+			if (tick > 0)
+			{
+				Vector q = PathPoint(tick - 1);
+				double dx = p.X - q.X, dy = p.Y - q.Y, dz = p.Z - q.Z;
+				length += std::sqrt(dx * dx + dy * dy + dz * dz);
+			}
+			// The default lateral axis is world Y
+			maxLateral = std::fmax(maxLateral, std::fabs(static_cast<double>(p.Y) - start.Y));
+
+			double lateral = static_cast<double>(p.Y) - start.Y;
+			if (std::fabs(trajectory.LateralOffset() - lateral) > 1e-3)
+			{
+				SF_CHECK(false, "tick %d: LateralOffset is %g instead of %g", tick, trajectory.LateralOffset(), lateral);
+				return;
+			}
+		}
+
+		// Summed in float over 3000 ticks, a relative error of 1e-5 is far above the rounding
+		SF_CHECK(std::fabs(trajectory.PathLength() - length) <= length * 1e-5,
+			"incremental path length %.3f, recomputed %.3f", trajectory.PathLength(), length);
+		SF_CHECK(std::fabs(trajectory.MaxLateralDeviation() - maxLateral) <= 1e-3,
+			"MaxLateralDeviation %.3f, recomputed %.3f", trajectory.MaxLateralDeviation(), maxLateral);
+
+		Vector end = PathPoint(Ticks - 1);
+		double dx = end.X - start.X, dy = end.Y - start.Y, dz = end.Z - start.Z;
+		double straightness = std::sqrt(dx * dx + dy * dy + dz * dz) / length;
+		SF_CHECK(std::fabs(trajectory.Straightness() - straightness) <= 1e-5, "Straightness %.6f, recomputed %.6f", trajectory.Straightness(), straightness);
+	}
+
+	void TestStraightnessAndAxis()
+	{
+		static Trajectory trajectory;
+
+		// 3 along X, then 4 along Y: 7 travelled, 5 apart
+		trajectory.Reset();
+		trajectory.Push(Vector(0, 0, 0));
+		trajectory.Push(Vector(3, 0, 0));
+		trajectory.Push(Vector(3, 4, 0));
+		SF_CHECK(trajectory.PathLength() == 7.0f, "path length %g instead of 7", trajectory.PathLength());
+		SF_CHECK(std::fabs(trajectory.Straightness() - 5.0f / 7.0f) < 1e-6f, "straightness %g instead of 5/7", trajectory.Straightness());
+
+		// A single point and a straight line
+		trajectory.Reset();
+		trajectory.Push(Vector(10, 10, 10));
+		SF_CHECK(trajectory.Straightness() == 1.0f, "straightness of one point is %g", trajectory.Straightness());
+		trajectory.Push(Vector(10, 110, 10));
+		SF_CHECK(std::fabs(trajectory.Straightness() - 1.0f) < 1e-6f, "straightness of a line is %g", trajectory.Straightness());
+
+		// The lateral axis is normalized, and the offset is signed while the maximum is not
+		trajectory.Reset(Vector(10, 0, 0));
+		trajectory.Push(Vector(0, 0, 0));
+		trajectory.Push(Vector(-30, 5, 0));
+		trajectory.Push(Vector(-10, 9, 0));
+		SF_CHECK(std::fabs(trajectory.LateralOffset() + 10.0f) < 1e-5f, "offset along X is %g instead of -10", trajectory.LateralOffset());
+		SF_CHECK(std::fabs(trajectory.MaxLateralDeviation() - 30.0f) < 1e-5f, "max deviation along X is %g instead of 30", trajectory.MaxLateralDeviation());
+	}
+}
+
+int main()
+{
+	TestRingWrap();
+	TestStatistics();
+	TestStraightnessAndAxis();
+	return Headless::TestResult();
+}
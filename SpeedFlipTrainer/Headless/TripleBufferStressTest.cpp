@@ -0,0 +1,102 @@
+#include "pch.h"
+#include "LiveMetrics.h"
+#include "TripleBuffer.h"
+#include "TestCheck.h"
+
+#include <cstdlib>
+#include <thread>
+
+// sf_triple_buffer_stress [publishes]
+// One thread publishes LiveMetrics as fast as it can while another reads them, the way
+// the game thread and the render thread share them. Every field of a published copy holds
+// the same sequence number, so a torn read shows up as fields that disagree. The reads
+// also have to be in publish order and end on the last value published.
+// Build with -DSF_SANITIZER=thread to run it under ThreadSanitizer.
+
+namespace
+{
+	// Floats hold integers exactly up to 2^24, the sequence stays below that
+	LiveMetrics Snapshot(int sequence)
+	{
+		bool odd = sequence % 2 == 1;
+		float value = static_cast<float>(sequence);
+
+		LiveMetrics m;
+		m.startedInAir = odd;
+		m.startedNoBoost = odd;
+		m.jumped = odd;
+		m.jumpTick = sequence;
+		m.dodged = odd;
+		m.dodgeAngle = sequence;
+		m.dodgedTick = sequence;
+		m.flipCanceled = odd;
+		m.flipCancelTick = sequence;
+		m.hit = odd;
+		m.ticksToBall = sequence;
+		m.timeToBall = value;
+		m.ticksNotPressingBoost = sequence;
+		m.ticksNotPressingThrottle = sequence;
+		m.lateralOffset = value;
+		m.pathLength = value;
+		return m;
+	}
+
+	bool Same(const LiveMetrics& a, const LiveMetrics& b)
+	{
+		return a.startedInAir == b.startedInAir && a.startedNoBoost == b.startedNoBoost
+			&& a.jumped == b.jumped && a.jumpTick == b.jumpTick
+			&& a.dodged == b.dodged && a.dodgeAngle == b.dodgeAngle && a.dodgedTick == b.dodgedTick
+			&& a.flipCanceled == b.flipCanceled && a.flipCancelTick == b.flipCancelTick
+			&& a.hit == b.hit && a.ticksToBall == b.ticksToBall && a.timeToBall == b.timeToBall
+			&& a.ticksNotPressingBoost == b.ticksNotPressingBoost && a.ticksNotPressingThrottle == b.ticksNotPressingThrottle
+			&& a.lateralOffset == b.lateralOffset && a.pathLength == b.pathLength;
+	}
+
+	bool Consistent(const LiveMetrics& m)
+	{
+		return Same(Snapshot(m.jumpTick), m);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int publishes = argc > 1 ? atoi(argv[1]) : 2000000;
+	if (publishes < 1 || publishes >= (1 << 24))
+	{
+		fprintf(stderr, "usage: sf_triple_buffer_stress [publishes, 1 to 16777215]\n");
+		return 2;
+	}
+
+	TripleBuffer<LiveMetrics> buffer;
+	std::thread producer([&] {
+		for (int sequence = 1; sequence <= publishes; sequence++)
+		{
+			buffer.Publish(Snapshot(sequence));
+			// On few cores the threads would otherwise only switch a few times per run
+			if (sequence % 64 == 0)
+				std::this_thread::yield();
+		}
+	});
+
+	// Stops at the first bad read, one is enough and the rest would only repeat it
+	int last = 0;
+	int reads = 0;
+	int changes = 0;
+	while (last < publishes && Headless::FailedChecks() == 0)
+	{
+		const LiveMetrics& m = buffer.Read();
+		reads++;
+		SF_CHECK(Consistent(m), "read %d is torn, jumpTick %d dodgeAngle %d pathLength %g", reads, m.jumpTick, m.dodgeAngle, m.pathLength);
+		SF_CHECK(m.jumpTick >= last, "read %d went back from %d to %d", reads, last, m.jumpTick);
+		if (m.jumpTick != last)
+			changes++;
+		last = m.jumpTick;
+		if (reads % 64 == 0)
+			std::this_thread::yield();
+	}
+	producer.join();
+
+	SF_CHECK(buffer.Read().jumpTick == publishes, "the last read is %d instead of %d", buffer.Read().jumpTick, publishes);
+	printf("%d publishes, %d reads, %d distinct values seen\n", publishes, reads, changes);
+	return Headless::TestResult();
+}
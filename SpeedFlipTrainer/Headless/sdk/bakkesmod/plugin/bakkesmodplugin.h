@@ -0,0 +1,164 @@
+#pragma once
+
+// Headless stand-in for the BakkesMod SDK wrappers the trainer core uses.
+// Wrappers are handles to the plain state in FakeGame.h instead of game memory: tests and
+// benchmarks fill the state, the trainer code reads it through the same calls as in game.
+// Every call made on a wrapper is counted in FakeWorld::calls.
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Headless
+{
+	struct FakeWorld;
+	struct FakeCanvas;
+}
+
+class CVarManagerWrapper
+{
+public:
+	// Receives every logged line, prints to stderr when empty
+	std::function<void(const std::string&)> sink;
+
+	void log(std::string text);
+};
+
+class ObjectWrapper
+{
+public:
+	explicit ObjectWrapper(const void* address = nullptr) : address(address) {}
+	bool IsNull() const { return address == nullptr; }
+	explicit operator bool() const { return !IsNull(); }
+
+protected:
+	const void* address;
+};
+
+class PriWrapper : public ObjectWrapper
+{
+public:
+	using ObjectWrapper::ObjectWrapper;
+};
+
+class DodgeComponentWrapper : public ObjectWrapper
+{
+public:
+	explicit DodgeComponentWrapper(Headless::FakeWorld* world = nullptr);
+	Vector GetDodgeTorque();
+	Vector GetDodgeDirection();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class BoostWrapper : public ObjectWrapper
+{
+public:
+	explicit BoostWrapper(Headless::FakeWorld* world = nullptr);
+	float GetCurrentBoostAmount();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class CarWrapper : public ObjectWrapper
+{
+public:
+	explicit CarWrapper(Headless::FakeWorld* world = nullptr);
+
+	PriWrapper GetPRI();
+	ControllerInput GetInput();
+	Vector GetLocation();
+	Rotator GetRotation();
+	Vector GetVelocity();
+	Vector GetAngularVelocity();
+	bool IsOnGround();
+	bool GetbJumped();
+	bool IsDodging();
+	DodgeComponentWrapper GetDodgeComponent();
+	BoostWrapper GetBoostComponent();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class BallWrapper : public ObjectWrapper
+{
+public:
+	using ObjectWrapper::ObjectWrapper;
+};
+
+class ServerWrapper : public ObjectWrapper
+{
+public:
+	explicit ServerWrapper(Headless::FakeWorld* world = nullptr);
+	float GetGameTimeRemaining();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class EngineTAWrapper : public ObjectWrapper
+{
+public:
+	explicit EngineTAWrapper(Headless::FakeWorld* world = nullptr);
+	int GetPhysicsFrame();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class CameraWrapper : public ObjectWrapper
+{
+public:
+	explicit CameraWrapper(Headless::FakeWorld* world = nullptr);
+	Vector GetLocation();
+	Rotator GetRotation();
+	float GetFOV();
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class GameWrapper
+{
+public:
+	explicit GameWrapper(Headless::FakeWorld& world) : world(&world) {}
+
+	bool IsInCustomTraining();
+	EngineTAWrapper GetEngine();
+	ServerWrapper GetCurrentGameState();
+	ServerWrapper GetGameEventAsServer();
+	CarWrapper GetLocalCar();
+	CameraWrapper GetCamera();
+	// Copies the overridden parameters back, for ControllerInput that is the car's input
+	void OverrideParams(void* src, size_t memsize);
+
+private:
+	Headless::FakeWorld* world;
+};
+
+class CanvasWrapper
+{
+public:
+	explicit CanvasWrapper(Headless::FakeCanvas& canvas) : canvas(&canvas) {}
+
+	Vector2 GetSize();
+	void SetColor(char red, char green, char blue, char alpha);
+	void SetColor(LinearColor color);
+	void SetPosition(Vector2 pos);
+	void SetPosition(Vector2F pos);
+	void FillBox(Vector2 size);
+	void DrawBox(Vector2 size);
+	void DrawLine(Vector2 start, Vector2 end, float width = 1.0f);
+	void DrawString(std::string text, float xScale = 1.0f, float yScale = 1.0f, bool dropShadow = false, bool wrapText = false);
+	Vector2F GetStringSize(std::string text, float xScale = 1.0f, float yScale = 1.0f);
+
+private:
+	Headless::FakeCanvas* canvas;
+};
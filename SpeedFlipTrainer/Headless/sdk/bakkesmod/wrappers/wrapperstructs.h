@@ -0,0 +1,100 @@
+#pragma once
+
+// Headless stand-in for the BakkesMod SDK value types.
+// Only the members the trainer uses are declared, with the same layout and semantics as the SDK.
+
+#include <cmath>
+
+#define CONST_PI_F 3.14159265358979323846f
+
+struct Vector
+{
+	float X, Y, Z;
+
+	Vector(float x, float y, float z) : X(x), Y(y), Z(z) {}
+	Vector(float f = 0) : X(f), Y(f), Z(f) {}
+
+	Vector operator+(const Vector& v) const { return Vector(X + v.X, Y + v.Y, Z + v.Z); }
+	Vector operator-(const Vector& v) const { return Vector(X - v.X, Y - v.Y, Z - v.Z); }
+	Vector operator*(const Vector& v) const { return Vector(X * v.X, Y * v.Y, Z * v.Z); }
+	Vector operator/(const Vector& v) const { return Vector(X / v.X, Y / v.Y, Z / v.Z); }
+	Vector operator*(float f) const { return Vector(X * f, Y * f, Z * f); }
+	Vector operator/(float f) const { return Vector(X / f, Y / f, Z / f); }
+	Vector operator-() const { return Vector(-X, -Y, -Z); }
+	Vector& operator+=(const Vector& v) { X += v.X; Y += v.Y; Z += v.Z; return *this; }
+	Vector& operator-=(const Vector& v) { X -= v.X; Y -= v.Y; Z -= v.Z; return *this; }
+	Vector& operator*=(float f) { X *= f; Y *= f; Z *= f; return *this; }
+	Vector& operator/=(float f) { X /= f; Y /= f; Z /= f; return *this; }
+
+	float magnitude() const { return sqrtf(X * X + Y * Y + Z * Z); }
+	void normalize()
+	{
+		float len = magnitude();
+		if (len > 0)
+			*this /= len;
+	}
+	Vector getNormalized() const
+	{
+		Vector v = *this;
+		v.normalize();
+		return v;
+	}
+	Vector clone() const { return *this; }
+
+	static float dot(const Vector& a, const Vector& b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+	static Vector cross(const Vector& a, const Vector& b)
+	{
+		return Vector(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X);
+	}
+};
+
+struct Vector2
+{
+	int X, Y;
+
+	Vector2 operator+(const Vector2& v) const { return Vector2{ X + v.X, Y + v.Y }; }
+	Vector2 operator-(const Vector2& v) const { return Vector2{ X - v.X, Y - v.Y }; }
+	Vector2 minus(const Vector2& v) const { return *this - v; }
+};
+
+struct Vector2F
+{
+	float X, Y;
+
+	Vector2F operator+(const Vector2F& v) const { return Vector2F{ X + v.X, Y + v.Y }; }
+	Vector2F operator-(const Vector2F& v) const { return Vector2F{ X - v.X, Y - v.Y }; }
+};
+
+struct Rotator
+{
+	int Pitch, Yaw, Roll;
+
+	Rotator(int pitch, int yaw, int roll) : Pitch(pitch), Yaw(yaw), Roll(roll) {}
+	Rotator(int def = 0) : Pitch(def), Yaw(def), Roll(def) {}
+
+	Rotator operator+(const Rotator& r) const { return Rotator(Pitch + r.Pitch, Yaw + r.Yaw, Roll + r.Roll); }
+	Rotator operator-(const Rotator& r) const { return Rotator(Pitch - r.Pitch, Yaw - r.Yaw, Roll - r.Roll); }
+};
+
+struct LinearColor
+{
+	float R, G, B, A;
+};
+
+struct ControllerInput
+{
+	float Throttle = 0;
+	float Steer = 0;
+	float Pitch = 0;
+	float Yaw = 0;
+	float Roll = 0;
+	float DodgeForward = 0;
+	float DodgeStrafe = 0;
+	unsigned long Handbrake : 1;
+	unsigned long Jump : 1;
+	unsigned long ActivateBoost : 1;
+	unsigned long HoldingBoost : 1;
+	unsigned long Jumped : 1;
+
+	ControllerInput() : Handbrake(0), Jump(0), ActivateBoost(0), HoldingBoost(0), Jumped(0) {}
+};
@@ -0,0 +1,115 @@
+#include "pch.h"
+#include "InputRuns.h"
+
+#include <algorithm>
+#include <cstring>
+
+static bool SameBits(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+bool SameControllerInput(const ControllerInput& a, const ControllerInput& b)
+{
+	return a.ActivateBoost == b.ActivateBoost
+		&& a.Handbrake == b.Handbrake
+		&& a.HoldingBoost == b.HoldingBoost
+		&& a.Jump == b.Jump
+		&& a.Jumped == b.Jumped
+		&& SameBits(a.DodgeForward, b.DodgeForward)
+		&& SameBits(a.DodgeStrafe, b.DodgeStrafe)
+		&& SameBits(a.Pitch, b.Pitch)
+		&& SameBits(a.Roll, b.Roll)
+		&& SameBits(a.Steer, b.Steer)
+		&& SameBits(a.Throttle, b.Throttle)
+		&& SameBits(a.Yaw, b.Yaw);
+}
+
+void InputRuns::Build(const InputTimeline& timeline)
+{
+	clear();
+	timeline.ForEach([this](int tick, const ControllerInput& input) {
+		Append(tick, input);
+	});
+}
+
+void InputRuns::Append(int tick, const ControllerInput& input)
+{
+	if (tick < End())
+		return; // Runs are only ever extended forward
+
+	if (!runs.empty())
+	{
+		Run& last = runs.back();
+		if (last.End() == tick && SameControllerInput(last.input, input))
+		{
+			last.length++;
+			tickCount++;
+			return;
+		}
+	}
+
+	runs.push_back(Run{ tick, 1, input });
+	tickCount++;
+}
+
+void InputRuns::clear()
+{
+	runs.clear();
+	tickCount = 0;
+}
+
+const ControllerInput* InputRuns::Find(int tick) const
+{
+	auto it = std::upper_bound(runs.begin(), runs.end(), tick, [](int t, const Run& r) { return t < r.start; });
+	if (it == runs.begin())
+		return nullptr;
+
+	--it;
+	return tick < it->End() ? &it->input : nullptr;
+}
+
+void InputRuns::CopyTo(InputTimeline& timeline) const
+{
+	timeline.clear();
+	timeline.Reserve(End());
+	for (const Run& r : runs)
+	{
+		for (int tick = r.start; tick < r.End(); tick++)
+			timeline.Record(tick, r.input);
+	}
+}
+
+const ControllerInput* InputRuns::Cursor::Seek(const InputRuns& runs, int tick)
+{
+	const std::vector<Run>& r = runs.Runs();
+	lastTick = tick;
+
+	auto it = std::upper_bound(r.begin(), r.end(), tick, [](int t, const Run& run) { return t < run.start; });
+	if (it == r.begin())
+	{
+		run = 0;
+		return nullptr;
+	}
+
+	--it;
+	run = static_cast<size_t>(it - r.begin());
+	return tick < it->End() ? &it->input : nullptr;
+}
+
+const ControllerInput* InputRuns::Cursor::Next(const InputRuns& runs, int tick)
+{
+	if (tick != lastTick + 1)
+		return Seek(runs, tick);
+
+	const std::vector<Run>& r = runs.Runs();
+	lastTick = tick;
+
+	while (run < r.size() && tick >= r[run].End())
+		run++;
+
+	if (run >= r.size() || tick < r[run].start)
+		return nullptr;
+
+	return &r[run].input;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include "InputTimeline.h"
+#include <vector>
+
+// Run-length encoded controller inputs.
+// Consecutive ticks with bit-identical inputs share one run, so a kickoff that
+// holds full throttle and boost for its first second is a single entry.
+// Ticks between runs were never recorded.
+class InputRuns
+{
+public:
+	struct Run
+	{
+		int start;
+		int length;
+		ControllerInput input;
+
+		int End() const { return start + length; }
+	};
+
+	// Forward-only playback position. Consecutive ticks advance in O(1),
+	// any other tick falls back to a binary search over the runs.
+	class Cursor
+	{
+	public:
+		const ControllerInput* Seek(const InputRuns& runs, int tick);
+		const ControllerInput* Next(const InputRuns& runs, int tick);
+		void Reset() { run = 0; lastTick = -1; }
+
+	private:
+		size_t run = 0;
+		int lastTick = -1;
+	};
+
+	void Build(const InputTimeline& timeline);
+	void Append(int tick, const ControllerInput& input);
+	void clear();
+
+	bool empty() const { return runs.empty(); }
+	size_t RunCount() const { return runs.size(); }
+
+	// Number of recorded ticks across all runs
+	size_t size() const { return tickCount; }
+	int End() const { return runs.empty() ? 0 : runs.back().End(); }
+
+	const ControllerInput* Find(int tick) const;
+	void CopyTo(InputTimeline& timeline) const;
+
+	const std::vector<Run>& Runs() const { return runs; }
+
+private:
+	std::vector<Run> runs;
+	size_t tickCount = 0;
+};
+
+// Bitwise comparison, so -0 and 0 stay distinct and encoding stays lossless
+bool SameControllerInput(const ControllerInput& a, const ControllerInput& b);
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "InputTimeline.h"
+
+InputTimeline::InputTimeline() : InputTimeline(DefaultCapacity)
+{
+}
+
+InputTimeline::InputTimeline(int capacity)
+{
+	Reserve(capacity);
+}
+
+void InputTimeline::Reserve(int capacity)
+{
+	if (capacity <= 0)
+		return;
+
+	ticks.reserve(capacity);
+	present.reserve(capacity);
+}
+
+void InputTimeline::Record(int tick, const ControllerInput& input)
+{
+	if (tick < 0)
+		return;
+
+	if (tick >= End())
+	{
+		// Only allocates when an attempt outlives the reserved capacity
+		ticks.resize(tick + 1);
+		present.resize(tick + 1, 0);
+	}
+
+	ticks[tick] = input;
+	revision++;
+	if (!present[tick])
+	{
+		present[tick] = 1;
+		count++;
+	}
+}
+
+const ControllerInput* InputTimeline::Find(int tick) const
+{
+	if (tick < 0 || tick >= End() || !present[tick])
+		return nullptr;
+
+	return &ticks[tick];
+}
+
+bool InputTimeline::Contains(int tick) const
+{
+	return Find(tick) != nullptr;
+}
+
+bool InputTimeline::Play(ControllerInput* ci, int tick) const
+{
+	const ControllerInput* input = Find(tick);
+	if (input == nullptr)
+		return false;
+
+	CopyControllerInput(ci, *input);
+	return true;
+}
+
+void InputTimeline::clear()
+{
+	ticks.clear();
+	present.clear();
+	count = 0;
+	revision++;
+}
+
+void CopyControllerInput(ControllerInput* dst, const ControllerInput& src)
+{
+	dst->ActivateBoost = src.ActivateBoost;
+	dst->DodgeForward = src.DodgeForward;
+	dst->DodgeStrafe = src.DodgeStrafe;
+	dst->Handbrake = src.Handbrake;
+	dst->HoldingBoost = src.HoldingBoost;
+	dst->Jump = src.Jump;
+	dst->Jumped = src.Jumped;
+	dst->Pitch = src.Pitch;
+	dst->Roll = src.Roll;
+	dst->Steer = src.Steer;
+	dst->Throttle = src.Throttle;
+	dst->Yaw = src.Yaw;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include <vector>
+
+// Contiguous tick-indexed storage for recorded controller inputs.
+// Index i holds the input for tick i, so Record and Find are O(1). Storage is
+// preallocated for a full kickoff and only grows if an attempt runs longer.
+// Ticks that were never recorded are tracked explicitly and are skipped on playback.
+class InputTimeline
+{
+public:
+	// 2048 ticks is ~17 seconds at 120Hz, well past the end of any kickoff
+	static constexpr int DefaultCapacity = 2048;
+
+	InputTimeline();
+	explicit InputTimeline(int capacity);
+
+	void Reserve(int capacity);
+	void Record(int tick, const ControllerInput& input);
+
+	// Returns nullptr if nothing was recorded for this tick
+	const ControllerInput* Find(int tick) const;
+	bool Contains(int tick) const;
+
+	// Copies the input recorded at tick into ci, returns false if the tick is missing
+	bool Play(ControllerInput* ci, int tick) const;
+
+	// Number of recorded ticks
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	// Forgets every tick but keeps the allocated storage
+	void clear();
+
+	// Changes on every Record or clear, lets derived data detect that it is stale
+	unsigned int Revision() const { return revision; }
+
+	// One past the highest recorded tick
+	int End() const { return static_cast<int>(ticks.size()); }
+
+	// Calls f(tick, input) for every recorded tick in ascending order
+	template <typename F>
+	void ForEach(F&& f) const
+	{
+		for (int tick = 0; tick < End(); tick++)
+		{
+			if (present[tick])
+				f(tick, ticks[tick]);
+		}
+	}
+
+private:
+	std::vector<ControllerInput> ticks;
+	std::vector<unsigned char> present;
+	size_t count = 0;
+	unsigned int revision = 0;
+};
+
+// Copies every controller field from src to dst
+void CopyControllerInput(ControllerInput* dst, const ControllerInput& src);
@@ -0,0 +1,147 @@
+#include "pch.h"
+#include "IoWorkerPool.h"
+#include "TraceRecorder.h"
+
+IoWorkerPool::IoWorkerPool(int threads, size_t capacity) : capacity(capacity)
+{
+	workers.reserve(threads);
+	for (int i = 0; i < threads; i++)
+		workers.emplace_back(&IoWorkerPool::WorkerLoop, this);
+}
+
+IoWorkerPool::~IoWorkerPool()
+{
+	Stop();
+	alive.reset();
+}
+
+void IoWorkerPool::SetDispatcher(Dispatcher dispatcher)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	dispatch = std::move(dispatcher);
+}
+
+bool IoWorkerPool::Submit(Job work, Job done)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping || queue.size() >= capacity)
+			return false;
+		queue.push_back(Entry{ std::move(work), std::move(done) });
+		SF_TRACE_INSTANT("I/O job queued", "pending", static_cast<int64_t>(queue.size() + running));
+	}
+	jobAvailable.notify_one();
+	return true;
+}
+
+void IoWorkerPool::Flush()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this] { return queue.empty() && running == 0; });
+}
+
+void IoWorkerPool::RunRemaining()
+{
+	// Every completion is queued once Flush returns, and without a dispatcher later
+	// ones run on their worker instead of being handed to the game thread
+	Flush();
+	SetDispatcher(nullptr);
+	RunCompletions();
+}
+
+void IoWorkerPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping)
+			return;
+		stopping = true;
+	}
+	jobAvailable.notify_all();
+
+	// The workers only exit once the queue is empty, so nothing submitted is lost
+	for (std::thread& worker : workers)
+		worker.join();
+	workers.clear();
+}
+
+size_t IoWorkerPool::Pending() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return queue.size() + running;
+}
+
+void IoWorkerPool::WorkerLoop()
+{
+	SF_TRACE_THREAD_NAME("I/O worker");
+
+	while (true)
+	{
+		Entry entry;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+			if (queue.empty())
+				return;
+			entry = std::move(queue.front());
+			queue.pop_front();
+			running++;
+		}
+
+		if (entry.work)
+		{
+			SF_TRACE_SCOPE("I/O job");
+			entry.work();
+		}
+		if (entry.done)
+			Complete(std::move(entry.done));
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running--;
+			if (!queue.empty() || running != 0)
+				continue;
+		}
+		idle.notify_all();
+	}
+}
+
+void IoWorkerPool::Complete(Job done)
+{
+	Dispatcher dispatcher;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		dispatcher = dispatch;
+		if (dispatcher)
+			completions.push_back(std::move(done));
+	}
+
+	if (!dispatcher)
+	{
+		done();
+		return;
+	}
+
+	std::weak_ptr<int> pool = alive;
+	dispatcher([this, pool]() {
+		if (!pool.expired())
+			RunCompletions();
+	});
+}
+
+void IoWorkerPool::RunCompletions()
+{
+	while (true)
+	{
+		Job done;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (completions.empty())
+				return;
+			done = std::move(completions.front());
+			completions.pop_front();
+		}
+		SF_TRACE_SCOPE("I/O completion");
+		done();
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small thread pool for the plugin's file I/O, so saving and loading attempts never
+// blocks the game or the UI thread. Jobs are picked up in submission order by the first
+// free worker and their completion callbacks are handed to the dispatcher, which runs
+// them on the game thread (gameWrapper->Execute in game). Finished completions wait in
+// the pool, each dispatched call runs the ones waiting. RunRemaining runs them before the
+// plugin unloads, so none is left for the game thread to call into a destroyed plugin.
+class IoWorkerPool
+{
+public:
+	using Job = std::function<void()>;
+	using Dispatcher = std::function<void(Job)>;
+
+	static constexpr int DefaultThreads = 2;
+	static constexpr size_t DefaultCapacity = 32;
+
+	IoWorkerPool(int threads = DefaultThreads, size_t capacity = DefaultCapacity);
+	// Runs the jobs still queued, then joins the workers
+	~IoWorkerPool();
+
+	IoWorkerPool(const IoWorkerPool&) = delete;
+	IoWorkerPool& operator=(const IoWorkerPool&) = delete;
+
+	// Without a dispatcher completions run right after their job, on the worker
+	void SetDispatcher(Dispatcher dispatch);
+
+	// Queues work, done runs on the game thread once work returned.
+	// Returns false without queueing anything when the queue is full or the pool stopped.
+	bool Submit(Job work, Job done = nullptr);
+
+	// Blocks until every queued job has run, the completions may still be pending
+	void Flush();
+	// Flushes, stops dispatching and runs every completion still waiting on the calling
+	// thread. Call it from the game thread before the plugin goes away.
+	void RunRemaining();
+	// Flushes and joins the workers, Submit fails afterwards
+	void Stop();
+
+	// Jobs queued or running
+	size_t Pending() const;
+	size_t Capacity() const { return capacity; }
+
+private:
+	struct Entry
+	{
+		Job work;
+		Job done;
+	};
+
+	void WorkerLoop();
+	void Complete(Job done);
+	// Runs the completions waiting for the game thread
+	void RunCompletions();
+
+	const size_t capacity;
+	std::vector<std::thread> workers;
+	Dispatcher dispatch;
+
+	mutable std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::condition_variable idle;
+	std::deque<Entry> queue;
+	std::deque<Job> completions; // Finished jobs waiting for the game thread
+	size_t running = 0;
+	bool stopping = false;
+
+	// Dispatched calls hold a weak reference, they do nothing once the pool is gone
+	std::shared_ptr<int> alive = std::make_shared<int>(0);
+};
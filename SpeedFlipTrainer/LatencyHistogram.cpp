@@ -0,0 +1,108 @@
+#include "pch.h"
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cstring>
+
+int LatencyHistogram::Bucket(uint64_t nanoseconds)
+{
+	if (nanoseconds < 16)
+		return static_cast<int>(nanoseconds);
+
+	// Position of the highest set bit, then the next three bits pick the sub-bucket.
+	// Hook timings are short, counting up from 16ns takes a handful of steps. The bound
+	// keeps the shift below 64 for durations past 2^63ns.
+	int exponent = 4;
+	while (exponent < 63 && nanoseconds >> (exponent + 1))
+		exponent++;
+	int sub = static_cast<int>((nanoseconds >> (exponent - 3)) & 7);
+	return std::min(BucketCount - 1, 16 + (exponent - 4) * 8 + sub);
+}
+
+uint64_t LatencyHistogram::BucketLimit(int bucket)
+{
+	if (bucket < 16)
+		return static_cast<uint64_t>(bucket);
+
+	int exponent = (bucket - 16) / 8 + 4;
+	uint64_t sub = static_cast<uint64_t>((bucket - 16) % 8);
+	return ((8 + sub + 1) << (exponent - 3)) - 1;
+}
+
+void LatencyHistogram::Record(Profiling::Clock::time_point start, Profiling::Clock::time_point end)
+{
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	Record(static_cast<uint64_t>(std::max<int64_t>(0, elapsed)), end);
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds, Profiling::Clock::time_point now)
+{
+	if (now - windowStart >= WindowLength)
+		Rotate(now);
+
+	current[Bucket(nanoseconds)]++;
+	currentMax = std::max(currentMax, nanoseconds);
+}
+
+void LatencyHistogram::Rotate(Profiling::Clock::time_point now)
+{
+	// A window that ended long ago has nothing to say about the last second
+	if (now - windowStart >= 2 * WindowLength)
+	{
+		memset(previous, 0, sizeof(previous));
+		previousMax = 0;
+	}
+	else
+	{
+		memcpy(previous, current, sizeof(previous));
+		previousMax = currentMax;
+	}
+
+	memset(current, 0, sizeof(current));
+	currentMax = 0;
+	windowStart = now;
+}
+
+LatencySummary LatencyHistogram::Summarize() const
+{
+	LatencySummary summary;
+	for (int i = 0; i < BucketCount; i++)
+		summary.samples += current[i] + previous[i];
+	if (summary.samples == 0)
+		return summary;
+
+	summary.max = std::max(currentMax, previousMax);
+
+	uint64_t p50Rank = (summary.samples * 50 + 99) / 100;
+	uint64_t p99Rank = (summary.samples * 99 + 99) / 100;
+	uint64_t seen = 0;
+	bool hasP50 = false;
+	for (int i = 0; i < BucketCount; i++)
+	{
+		uint64_t count = current[i] + previous[i];
+		if (count == 0)
+			continue;
+
+		seen += count;
+		if (!hasP50 && seen >= p50Rank)
+		{
+			summary.p50 = std::min(BucketLimit(i), summary.max);
+			hasP50 = true;
+		}
+		if (seen >= p99Rank)
+		{
+			summary.p99 = std::min(BucketLimit(i), summary.max);
+			break;
+		}
+	}
+	return summary;
+}
+
+void LatencyHistogram::Reset()
+{
+	memset(current, 0, sizeof(current));
+	memset(previous, 0, sizeof(previous));
+	currentMax = 0;
+	previousMax = 0;
+	windowStart = {};
+}
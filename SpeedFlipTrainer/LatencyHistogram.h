@@ -0,0 +1,92 @@
+#pragma once
+
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <cstdint>
+
+// Timing of the hooks and the render callback. Only compiled in with SF_ENABLE_PROFILING,
+// otherwise SF_PROFILE_SCOPE expands to nothing and the histograms stay empty.
+namespace Profiling
+{
+#ifdef SF_ENABLE_PROFILING
+	constexpr bool Enabled = true;
+#else
+	constexpr bool Enabled = false;
+#endif
+
+	using Clock = std::chrono::steady_clock;
+}
+
+struct LatencySummary
+{
+	uint64_t samples = 0;
+	uint64_t p50 = 0; // Nanoseconds
+	uint64_t p99 = 0;
+	uint64_t max = 0;
+};
+
+// Rolling latency distribution in log-linear buckets: exact below 16ns, then eight
+// buckets per power of two, so percentiles are within 12.5%. Samples go into the current
+// window, which becomes the previous one after WindowLength. Summaries cover both
+// windows, that is the last one to two seconds. Recording is a few integer operations.
+class LatencyHistogram
+{
+public:
+	static constexpr int BucketCount = 16 + 8 * 40;
+	static constexpr auto WindowLength = std::chrono::seconds(1);
+
+	// The name is a string literal, it also names the section in traces
+	LatencyHistogram(const char* name = "") : name(name) {}
+
+	const char* Name() const { return name; }
+
+	void Record(Profiling::Clock::time_point start, Profiling::Clock::time_point end);
+	void Record(uint64_t nanoseconds, Profiling::Clock::time_point now);
+
+	LatencySummary Summarize() const;
+	void Reset();
+
+	static int Bucket(uint64_t nanoseconds);
+	// Upper bound of a bucket, so percentiles never read low
+	static uint64_t BucketLimit(int bucket);
+
+private:
+	void Rotate(Profiling::Clock::time_point now);
+
+	const char* name;
+	uint32_t current[BucketCount] = {};
+	uint32_t previous[BucketCount] = {};
+	uint64_t currentMax = 0;
+	uint64_t previousMax = 0;
+	Profiling::Clock::time_point windowStart{};
+};
+
+// Records the time until the end of the enclosing scope, in the histogram and as a trace event
+class LatencyScope
+{
+public:
+	explicit LatencyScope(LatencyHistogram& histogram) : histogram(histogram), start(Profiling::Clock::now()) {}
+	~LatencyScope()
+	{
+		auto end = Profiling::Clock::now();
+		histogram.Record(start, end);
+		TraceRecorder::Instance().Complete(histogram.Name(), start, end);
+	}
+
+	LatencyScope(const LatencyScope&) = delete;
+	LatencyScope& operator=(const LatencyScope&) = delete;
+
+private:
+	LatencyHistogram& histogram;
+	Profiling::Clock::time_point start;
+};
+
+#define SF_PROFILE_CONCAT_INNER(a, b) a##b
+#define SF_PROFILE_CONCAT(a, b) SF_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SF_ENABLE_PROFILING
+#define SF_PROFILE_SCOPE(histogram) LatencyScope SF_PROFILE_CONCAT(profileScope, __LINE__)(histogram)
+#else
+#define SF_PROFILE_SCOPE(histogram) ((void)0)
+#endif
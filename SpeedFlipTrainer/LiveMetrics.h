@@ -0,0 +1,29 @@
+#pragma once
+
+// What the meters show about the current attempt. Measure and the hit and explode hooks
+// publish a copy after every change, RenderMeters only reads the latest published copy.
+struct LiveMetrics
+{
+	bool startedInAir = false;
+	bool startedNoBoost = false;
+
+	bool jumped = false;
+	int jumpTick = 0;
+
+	bool dodged = false;
+	int dodgeAngle = 0;
+	int dodgedTick = 0;
+
+	bool flipCanceled = false;
+	int flipCancelTick = 0;
+
+	bool hit = false;
+	int ticksToBall = 0;
+	float timeToBall = 0.0f;
+
+	int ticksNotPressingBoost = 0;
+	int ticksNotPressingThrottle = 0;
+
+	float lateralOffset = 0.0f;
+	float pathLength = 0.0f;
+};
@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "PhysicsTrack.h"
+
+#include <cmath>
+
+void PhysicsTrack::Reserve(int capacity)
+{
+	if (capacity <= 0)
+		return;
+
+	for (auto& channel : channels)
+		channel.reserve(capacity);
+	boost.reserve(capacity);
+	flags.reserve(capacity);
+	present.reserve(capacity);
+}
+
+int16_t PhysicsTrack::Quantize(float value, int scale)
+{
+	float q = std::round(value * scale);
+	if (!(q >= INT16_MIN)) return INT16_MIN; // Also catches NaN
+	if (q > INT16_MAX) return INT16_MAX;
+	return static_cast<int16_t>(q);
+}
+
+void PhysicsTrack::Grow(int tick)
+{
+	if (tick < End())
+		return;
+
+	for (auto& channel : channels)
+		channel.resize(tick + 1, 0);
+	boost.resize(tick + 1, 0);
+	flags.resize(tick + 1, 0);
+	present.resize(tick + 1, 0);
+}
+
+void PhysicsTrack::Record(int tick, const PhysicsState& state)
+{
+	if (tick < 0)
+		return;
+
+	int16_t values[Phys_Count];
+	values[Phys_LocationX] = Quantize(state.location.X, LocationScale);
+	values[Phys_LocationY] = Quantize(state.location.Y, LocationScale);
+	values[Phys_LocationZ] = Quantize(state.location.Z, LocationScale);
+	// Rotators are 16 bit angles, wrapping keeps them exact
+	values[Phys_Pitch] = static_cast<int16_t>(state.rotation.Pitch);
+	values[Phys_Yaw] = static_cast<int16_t>(state.rotation.Yaw);
+	values[Phys_Roll] = static_cast<int16_t>(state.rotation.Roll);
+	values[Phys_VelocityX] = Quantize(state.velocity.X, VelocityScale);
+	values[Phys_VelocityY] = Quantize(state.velocity.Y, VelocityScale);
+	values[Phys_VelocityZ] = Quantize(state.velocity.Z, VelocityScale);
+	values[Phys_AngularX] = Quantize(state.angularVelocity.X, AngularScale);
+	values[Phys_AngularY] = Quantize(state.angularVelocity.Y, AngularScale);
+	values[Phys_AngularZ] = Quantize(state.angularVelocity.Z, AngularScale);
+
+	float b = std::round(state.boost * BoostScale);
+	uint8_t boostValue = static_cast<uint8_t>(b < 0 ? 0 : b > BoostScale ? BoostScale : b);
+
+	uint8_t flagBits = 0;
+	if (state.onGround) flagBits |= PhysicsFlag_OnGround;
+	if (state.jumped) flagBits |= PhysicsFlag_Jumped;
+	if (state.dodging) flagBits |= PhysicsFlag_Dodging;
+
+	RecordRaw(tick, values, boostValue, flagBits);
+}
+
+void PhysicsTrack::RecordRaw(int tick, const int16_t* values, uint8_t boostValue, uint8_t flagBits)
+{
+	if (tick < 0)
+		return;
+
+	Grow(tick);
+	for (int c = 0; c < Phys_Count; c++)
+		channels[c][tick] = values[c];
+	boost[tick] = boostValue;
+	flags[tick] = flagBits;
+	if (!present[tick])
+	{
+		present[tick] = 1;
+		count++;
+	}
+}
+
+bool PhysicsTrack::Contains(int tick) const
+{
+	return tick >= 0 && tick < End() && present[tick];
+}
+
+bool PhysicsTrack::Get(int tick, PhysicsState& state) const
+{
+	if (!Contains(tick))
+		return false;
+
+	state.location.X = Dequantize(channels[Phys_LocationX][tick], LocationScale);
+	state.location.Y = Dequantize(channels[Phys_LocationY][tick], LocationScale);
+	state.location.Z = Dequantize(channels[Phys_LocationZ][tick], LocationScale);
+	state.rotation.Pitch = channels[Phys_Pitch][tick];
+	state.rotation.Yaw = channels[Phys_Yaw][tick];
+	state.rotation.Roll = channels[Phys_Roll][tick];
+	state.velocity.X = Dequantize(channels[Phys_VelocityX][tick], VelocityScale);
+	state.velocity.Y = Dequantize(channels[Phys_VelocityY][tick], VelocityScale);
+	state.velocity.Z = Dequantize(channels[Phys_VelocityZ][tick], VelocityScale);
+	state.angularVelocity.X = Dequantize(channels[Phys_AngularX][tick], AngularScale);
+	state.angularVelocity.Y = Dequantize(channels[Phys_AngularY][tick], AngularScale);
+	state.angularVelocity.Z = Dequantize(channels[Phys_AngularZ][tick], AngularScale);
+	state.boost = static_cast<float>(boost[tick]) / BoostScale;
+	state.onGround = (flags[tick] & PhysicsFlag_OnGround) != 0;
+	state.jumped = (flags[tick] & PhysicsFlag_Jumped) != 0;
+	state.dodging = (flags[tick] & PhysicsFlag_Dodging) != 0;
+	return true;
+}
+
+void PhysicsTrack::clear()
+{
+	for (auto& channel : channels)
+		channel.clear();
+	boost.clear();
+	flags.clear();
+	present.clear();
+	count = 0;
+}
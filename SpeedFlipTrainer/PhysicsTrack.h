@@ -0,0 +1,93 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+
+#include <cstdint>
+#include <vector>
+
+// Car state read on one tick
+struct PhysicsState
+{
+	Vector location;
+	Rotator rotation;
+	Vector velocity;
+	Vector angularVelocity;
+	float boost = 0; // 0 to 1
+	bool onGround = false;
+	bool jumped = false;
+	bool dodging = false;
+};
+
+// Channels stored as int16, value = q / scale
+enum PhysicsChannel
+{
+	Phys_LocationX,
+	Phys_LocationY,
+	Phys_LocationZ,
+	Phys_Pitch,
+	Phys_Yaw,
+	Phys_Roll,
+	Phys_VelocityX,
+	Phys_VelocityY,
+	Phys_VelocityZ,
+	Phys_AngularX,
+	Phys_AngularY,
+	Phys_AngularZ,
+	Phys_Count
+};
+
+enum PhysicsFlag : uint8_t
+{
+	PhysicsFlag_OnGround = 1 << 0,
+	PhysicsFlag_Jumped = 1 << 1,
+	PhysicsFlag_Dodging = 1 << 2
+};
+
+// Tick-indexed car physics stored quantized, one array per channel.
+// Quantization steps are 0.5uu for locations (range +-16383uu), 0.1uu/s for velocities,
+// 0.001rad/s for angular velocities and 1/255 for boost. Rotations are stored exactly.
+// Values outside a channel's range are clamped.
+class PhysicsTrack
+{
+public:
+	// Capture is optional, so nothing is reserved until Reserve is called
+	static constexpr int DefaultCapacity = 2048;
+
+	static constexpr int LocationScale = 2;
+	static constexpr int VelocityScale = 10;
+	static constexpr int AngularScale = 1000;
+	static constexpr int BoostScale = 255;
+
+	void Reserve(int capacity);
+	void Record(int tick, const PhysicsState& state);
+	// Returns false if nothing was recorded for this tick
+	bool Get(int tick, PhysicsState& state) const;
+	bool Contains(int tick) const;
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	int End() const { return static_cast<int>(present.size()); }
+
+	// Forgets every tick but keeps the allocated storage
+	void clear();
+
+	// Raw channels for serialization, End() entries each
+	const int16_t* Channel(int channel) const { return channels[channel].data(); }
+	const uint8_t* Boost() const { return boost.data(); }
+	const uint8_t* Flags() const { return flags.data(); }
+
+	// Stores an already quantized tick, used when reading files
+	void RecordRaw(int tick, const int16_t* values, uint8_t boostValue, uint8_t flagBits);
+
+	static int16_t Quantize(float value, int scale);
+	static float Dequantize(int16_t q, int scale) { return static_cast<float>(q) / scale; }
+
+private:
+	void Grow(int tick);
+
+	std::vector<int16_t> channels[Phys_Count];
+	std::vector<uint8_t> boost;
+	std::vector<uint8_t> flags;
+	std::vector<uint8_t> present;
+	size_t count = 0;
+};
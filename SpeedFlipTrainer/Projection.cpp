@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "Projection.h"
+
+#include <algorithm>
+
+#ifdef SF_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+ProjectionContext::ProjectionContext(const Matrix& viewProjection, Vector2 screenSize)
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			m[i][j] = viewProjection.M[i][j];
+
+	width = static_cast<float>(screenSize.X);
+	height = static_cast<float>(screenSize.Y);
+	valid = screenSize.X > 0 && screenSize.Y > 0;
+}
+
+ProjectionContext::Clip ProjectionContext::ToClip(const Vector& world) const
+{
+	Clip c;
+	c.X = m[0][0] * world.X + m[0][1] * world.Y + m[0][2] * world.Z + m[0][3];
+	c.Y = m[1][0] * world.X + m[1][1] * world.Y + m[1][2] * world.Z + m[1][3];
+	c.Z = m[2][0] * world.X + m[2][1] * world.Y + m[2][2] * world.Z + m[2][3];
+	c.W = m[3][0] * world.X + m[3][1] * world.Y + m[3][2] * world.Z + m[3][3];
+	return c;
+}
+
+Vector2 ProjectionContext::ToScreen(const Clip& clip) const
+{
+	float ndcX = clip.X / clip.W;
+	float ndcY = clip.Y / clip.W;
+	return Vector2{ static_cast<int>((ndcX * 0.5f + 0.5f) * width), static_cast<int>((-ndcY * 0.5f + 0.5f) * height) };
+}
+
+bool ProjectionContext::InsideFrustum(const Clip& clip)
+{
+	return clip.Z >= 0 && clip.Z <= clip.W
+		&& clip.X >= -clip.W && clip.X <= clip.W
+		&& clip.Y >= -clip.W && clip.Y <= clip.W;
+}
+
+bool ProjectionContext::Project(const Vector& world, Vector2& screen) const
+{
+	if (!valid)
+		return false;
+
+	Clip clip = ToClip(world);
+	if (!InsideFrustum(clip))
+		return false;
+
+	screen = ToScreen(clip);
+	return true;
+}
+
+int ProjectionContext::ProjectBatch(const Vector* world, int count, Vector2* screen, bool* visible) const
+{
+	if (!valid)
+	{
+		std::fill(visible, visible + count, false);
+		return 0;
+	}
+
+	int numVisible = 0;
+	int i = 0;
+
+#ifdef SF_MATH_SSE
+	// Four points per iteration, one lane per point
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 w = _mm_set1_ps(width);
+	const __m128 h = _mm_set1_ps(height);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	__m128 row[4][4];
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 4; c++)
+			row[r][c] = _mm_set1_ps(m[r][c]);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const Vector* p = world + i;
+		__m128 x = _mm_setr_ps(p[0].X, p[1].X, p[2].X, p[3].X);
+		__m128 y = _mm_setr_ps(p[0].Y, p[1].Y, p[2].Y, p[3].Y);
+		__m128 z = _mm_setr_ps(p[0].Z, p[1].Z, p[2].Z, p[3].Z);
+
+		__m128 clip[4];
+		for (int r = 0; r < 4; r++)
+		{
+			__m128 v = _mm_mul_ps(row[r][0], x);
+			v = _mm_add_ps(v, _mm_mul_ps(row[r][1], y));
+			v = _mm_add_ps(v, _mm_mul_ps(row[r][2], z));
+			clip[r] = _mm_add_ps(v, row[r][3]);
+		}
+
+		__m128 negW = _mm_xor_ps(clip[3], signBit);
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(clip[2], zero), _mm_cmple_ps(clip[2], clip[3]));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(clip[0], negW), _mm_cmple_ps(clip[0], clip[3])));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(clip[1], negW), _mm_cmple_ps(clip[1], clip[3])));
+		int mask = _mm_movemask_ps(inside);
+
+		// Lanes outside the frustum may divide by zero, their results are discarded below
+		__m128 ndcX = _mm_div_ps(clip[0], clip[3]);
+		__m128 ndcY = _mm_div_ps(clip[1], clip[3]);
+		__m128 sx = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndcX, half), half), w);
+		__m128 sy = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(ndcY, half)), h);
+
+		alignas(16) int ix[4];
+		alignas(16) int iy[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(ix), _mm_cvttps_epi32(sx));
+		_mm_store_si128(reinterpret_cast<__m128i*>(iy), _mm_cvttps_epi32(sy));
+
+		for (int lane = 0; lane < 4; lane++)
+		{
+			bool in = (mask >> lane) & 1;
+			visible[i + lane] = in;
+			if (in)
+			{
+				screen[i + lane] = Vector2{ ix[lane], iy[lane] };
+				numVisible++;
+			}
+		}
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		visible[i] = Project(world[i], screen[i]);
+		if (visible[i])
+			numVisible++;
+	}
+
+	return numVisible;
+}
+
+bool ProjectionContext::ProjectSegment(const Vector& a, const Vector& b, Vector2& screenA, Vector2& screenB) const
+{
+	if (!valid)
+		return false;
+
+	Clip ca = ToClip(a);
+	Clip cb = ToClip(b);
+
+	// Liang-Barsky against the six frustum planes, each distance is >= 0 inside
+	float da[6] = { ca.W + ca.X, ca.W - ca.X, ca.W + ca.Y, ca.W - ca.Y, ca.Z, ca.W - ca.Z };
+	float db[6] = { cb.W + cb.X, cb.W - cb.X, cb.W + cb.Y, cb.W - cb.Y, cb.Z, cb.W - cb.Z };
+
+	float t0 = 0;
+	float t1 = 1;
+	for (int p = 0; p < 6; p++)
+	{
+		if (da[p] < 0 && db[p] < 0)
+			return false;
+
+		if (da[p] < 0)
+			t0 = std::max(t0, da[p] / (da[p] - db[p]));
+		else if (db[p] < 0)
+			t1 = std::min(t1, da[p] / (da[p] - db[p]));
+
+		if (t0 > t1)
+			return false;
+	}
+
+	auto lerp = [&](float t) {
+		return Clip{ ca.X + (cb.X - ca.X) * t, ca.Y + (cb.Y - ca.Y) * t, ca.Z + (cb.Z - ca.Z) * t, ca.W + (cb.W - ca.W) * t };
+	};
+
+	screenA = ToScreen(t0 > 0 ? lerp(t0) : ca);
+	screenB = ToScreen(t1 < 1 ? lerp(t1) : cb);
+	return true;
+}
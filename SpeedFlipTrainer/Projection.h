@@ -0,0 +1,49 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "TrainerMath.h"
+
+// World to screen projection for one rendered frame.
+// The view-projection matrix and the screen mapping are computed once when the frame
+// starts, every point drawn during the frame then only costs a matrix-vector product.
+// Points are tested against the whole view frustum in clip space, so anything behind
+// the camera or outside the view is reported as not visible instead of being mapped
+// to a sentinel position.
+class ProjectionContext
+{
+public:
+	// An invalid context, every point is reported as not visible
+	ProjectionContext() = default;
+
+	// viewProjection maps world space to clip space with 0 <= Z <= W inside the frustum
+	ProjectionContext(const Matrix& viewProjection, Vector2 screenSize);
+
+	bool IsValid() const { return valid; }
+	Vector2 ScreenSize() const { return Vector2{ static_cast<int>(width), static_cast<int>(height) }; }
+
+	// Returns false if the point is outside the view frustum, screen is left untouched
+	bool Project(const Vector& world, Vector2& screen) const;
+
+	// Projects count points, visible[i] tells whether screen[i] was written.
+	// Returns the number of visible points.
+	int ProjectBatch(const Vector* world, int count, Vector2* screen, bool* visible) const;
+
+	// Clips the segment a-b to the view frustum and projects what is left of it.
+	// Returns false if no part of the segment is visible.
+	bool ProjectSegment(const Vector& a, const Vector& b, Vector2& screenA, Vector2& screenB) const;
+
+private:
+	struct Clip
+	{
+		float X, Y, Z, W;
+	};
+
+	Clip ToClip(const Vector& world) const;
+	Vector2 ToScreen(const Clip& clip) const;
+	static bool InsideFrustum(const Clip& clip);
+
+	float m[4][4] = {};
+	float width = 0;
+	float height = 0;
+	bool valid = false;
+};
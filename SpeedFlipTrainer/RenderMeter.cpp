@@ -1,13 +1,21 @@
 #include "pch.h"
-#include "RenderMeter.h" // Includes SpeedFlipTrainer.h for CustomColor, Vector2, CanvasWrapper
+#include "RenderMeter.h"
 
-// Implementation of RenderMeter function
-Vector2 RenderMeter(CanvasWrapper canvas, Vector2 startPos, Vector2 reqBoxSize, CustomColor baseColor,
-    LineStyle borderStyle, int totalUnits, const std::list<MeterRange>& ranges,
-    const std::list<MeterMarking>& markings, bool vertical, float currentValue) {
+#include <algorithm>
+
+// Builds the geometry RenderMeter used to compute on every call
+MeterLayout BuildMeterLayout(Vector2 startPos, Vector2 reqBoxSize, CustomColor baseColor, LineStyle borderStyle,
+    int totalUnits, const std::list<MeterRange>& ranges, const std::list<MeterMarking>& markings, bool vertical) {
+
+    MeterLayout layout;
+    layout.startPos = startPos;
+    layout.totalUnits = totalUnits;
+    layout.vertical = vertical;
+    layout.border = borderStyle;
 
     // Calculate actual box size based on totalUnits and requested size (aspect ratio might change)
     Vector2 actualBoxSize = reqBoxSize;
+    layout.boxSize = actualBoxSize;
     float unitPixelSize;
 
     if (vertical) {
@@ -18,17 +26,17 @@ Vector2 RenderMeter(CanvasWrapper canvas, Vector2 startPos, Vector2 reqBoxSize,
         unitPixelSize = (totalUnits > 0) ? static_cast<float>(actualBoxSize.X) / static_cast<float>(totalUnits) : 0;
         // actualBoxSize.X = unitPixelSize * totalUnits; // Optional: adjust box X
     }
-    if (unitPixelSize <= 0.001f && totalUnits > 0) return startPos + actualBoxSize; // Avoid division by zero or tiny units
+    layout.unitPixelSize = unitPixelSize;
+    if (unitPixelSize <= 0.001f && totalUnits > 0) return layout; // Avoid division by zero or tiny units, nothing is drawn
 
+    layout.boxes.reserve(ranges.size() + 1);
+    layout.lines.reserve(markings.size());
 
-    // Draw background
-    canvas.SetColor(baseColor.r, baseColor.g, baseColor.b, baseColor.GetAlphaChar());
-    canvas.SetPosition(startPos);
-    canvas.FillBox(actualBoxSize);
+    // Background
+    layout.boxes.push_back({ baseColor, startPos, actualBoxSize });
 
-    // Draw ranges
+    // Ranges
     for (const auto& range : ranges) {
-        canvas.SetColor(range.color.r, range.color.g, range.color.b, range.color.GetAlphaChar());
         Vector2 rangePos = startPos;
         Vector2 rangeSize = actualBoxSize;
         int rLow = std::max(0, std::min(totalUnits, range.low));
@@ -48,13 +56,11 @@ Vector2 RenderMeter(CanvasWrapper canvas, Vector2 startPos, Vector2 reqBoxSize,
             rangePos.X += static_cast<int>(rLow * unitPixelSize);
             rangeSize.X = static_cast<int>((rHigh - rLow) * unitPixelSize);
         }
-        canvas.SetPosition(rangePos);
-        canvas.FillBox(rangeSize);
+        layout.boxes.push_back({ range.color, rangePos, rangeSize });
     }
 
-    // Draw markings
+    // Markings
     for (const auto& mark : markings) {
-        canvas.SetColor(mark.lineStyle.color.r, mark.lineStyle.color.g, mark.lineStyle.color.b, mark.lineStyle.color.GetAlphaChar());
         int mVal = std::max(0, std::min(totalUnits, mark.value));
         Vector2 markStart, markEnd;
 
@@ -69,48 +75,69 @@ Vector2 RenderMeter(CanvasWrapper canvas, Vector2 startPos, Vector2 reqBoxSize,
             markStart = { static_cast<int>(xPos), startPos.Y };
             markEnd = { static_cast<int>(xPos), startPos.Y + actualBoxSize.Y };
         }
-        canvas.DrawLine(markStart, markEnd, mark.lineStyle.width);
+        layout.lines.push_back({ mark.lineStyle.color, markStart, markEnd, mark.lineStyle.width });
+    }
+
+    return layout;
+}
+
+MeterLayout::Line MeterLayout::ValueMarker(float value) const {
+    int currentValUnit = static_cast<int>(value);
+    currentValUnit = std::max(0, std::min(totalUnits, currentValUnit));
+    // A thicker, darker line for the current value
+    CustomColor currentValueColor = CustomColor(10, 10, 10, 0.8f);
+    int currentValueMarkWidth = border.width > 0 ? border.width : 2; // Use border width or default
+
+    Vector2 cvMarkStart, cvMarkEnd;
+    if (vertical) {
+        float yPos = startPos.Y + static_cast<int>((totalUnits - currentValUnit) * unitPixelSize);
+        cvMarkStart = { startPos.X, static_cast<int>(yPos) };
+        cvMarkEnd = { startPos.X + boxSize.X, static_cast<int>(yPos) };
+    }
+    else {
+        float xPos = startPos.X + static_cast<int>(currentValUnit * unitPixelSize);
+        cvMarkStart = { static_cast<int>(xPos), startPos.Y };
+        cvMarkEnd = { static_cast<int>(xPos), startPos.Y + boxSize.Y };
+    }
+    return Line{ currentValueColor, cvMarkStart, cvMarkEnd, currentValueMarkWidth + 1 }; // Slightly thicker
+}
+
+void DrawMeterLayout(DrawList& drawList, const MeterLayout& layout, float currentValue) {
+    if (!layout.IsDrawable()) return;
+
+    // The ranges are drawn over the background, so it gets its own layer
+    drawList.FillBox(DrawLayer::Background, layout.boxes[0].color, layout.boxes[0].position, layout.boxes[0].size);
+    for (size_t i = 1; i < layout.boxes.size(); i++) {
+        const MeterLayout::Box& box = layout.boxes[i];
+        drawList.FillBox(DrawLayer::Fill, box.color, box.position, box.size);
+    }
+
+    for (const auto& line : layout.lines) {
+        drawList.DrawLine(DrawLayer::Lines, line.color, line.start, line.end, static_cast<float>(line.width));
     }
 
     // Draw current value if provided (currentValue is in terms of units from 0 to totalUnits)
     if (currentValue >= 0.0f) {
-        int currentValUnit = static_cast<int>(currentValue);
-        currentValUnit = std::max(0, std::min(totalUnits, currentValUnit));
-        // Example: Draw a thicker, darker line for currentValue
-        CustomColor currentValueColor = CustomColor(10, 10, 10, 0.8f); // Darker marker
-        int currentValueMarkWidth = borderStyle.width > 0 ? borderStyle.width : 2; // Use border width or default
-        canvas.SetColor(currentValueColor.r, currentValueColor.g, currentValueColor.b, currentValueColor.GetAlphaChar());
-
-        Vector2 cvMarkStart, cvMarkEnd;
-        if (vertical) {
-            float yPos = startPos.Y + static_cast<int>((totalUnits - currentValUnit) * unitPixelSize);
-            cvMarkStart = { startPos.X, static_cast<int>(yPos) };
-            cvMarkEnd = { startPos.X + actualBoxSize.X, static_cast<int>(yPos) };
-        }
-        else {
-            float xPos = startPos.X + static_cast<int>(currentValUnit * unitPixelSize);
-            cvMarkStart = { static_cast<int>(xPos), startPos.Y };
-            cvMarkEnd = { static_cast<int>(xPos), startPos.Y + actualBoxSize.Y };
-        }
-        canvas.DrawLine(cvMarkStart, cvMarkEnd, currentValueMarkWidth + 1); // Slightly thicker
+        MeterLayout::Line marker = layout.ValueMarker(currentValue);
+        drawList.DrawLine(DrawLayer::Overlay, marker.color, marker.start, marker.end, static_cast<float>(marker.width));
     }
 
-
     // Draw border
+    const LineStyle& borderStyle = layout.border;
     if (borderStyle.width > 0) {
-        canvas.SetColor(borderStyle.color.r, borderStyle.color.g, borderStyle.color.b, borderStyle.color.GetAlphaChar());
-        canvas.SetPosition(startPos);
-        // Assuming DrawBox(Vector2 size, int thickness) exists or DrawBox(Vector2 size) draws a 1px border
-        // If DrawBox only takes size, borderStyle.width might be conceptually used or needs manual line drawing for thickness
-        // For now, trying to use it as a thickness parameter.
-        // If your BakkesMod version DrawBox(Vector2) is a 1px outline, and you want thicker,
-        // you'd need to draw 4 lines or filled rects.
-        // Let's assume an overload canvas.DrawBox(size, thickness) might exist or be intended.
-        // If not, change to canvas.DrawBox(actualBoxSize); and the thickness is 1px.
-        canvas.DrawBox(actualBoxSize); // Fallback to 1px border if thickness param is not supported
-        // Or if canvas.DrawBox(actualBoxSize, borderStyle.width) is the correct API:
-        // canvas.DrawBox(actualBoxSize, borderStyle.width);
+        // DrawBox(Vector2) draws a 1px outline, borderStyle.width is not used for thickness
+        drawList.DrawBox(DrawLayer::Overlay, borderStyle.color, layout.startPos, layout.boxSize);
     }
+}
+
+// Implementation of RenderMeter function, for meters that are not kept between frames
+Vector2 RenderMeter(CanvasWrapper canvas, Vector2 startPos, Vector2 reqBoxSize, CustomColor baseColor,
+    LineStyle borderStyle, int totalUnits, const std::list<MeterRange>& ranges,
+    const std::list<MeterMarking>& markings, bool vertical, float currentValue) {
 
-    return startPos + actualBoxSize; // Return bottom-right corner or similar
-}
\ No newline at end of file
+    MeterLayout layout = BuildMeterLayout(startPos, reqBoxSize, baseColor, borderStyle, totalUnits, ranges, markings, vertical);
+    DrawList drawList;
+    DrawMeterLayout(drawList, layout, currentValue);
+    drawList.Flush(canvas);
+    return startPos + layout.boxSize; // Return bottom-right corner or similar
+}
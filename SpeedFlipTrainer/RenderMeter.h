@@ -1,10 +1,9 @@
 #pragma once
 
-#include "SpeedFlipTrainer.h" // For CustomColor, Vector2 (via SpeedFlipTrainer.h -> wrapperstructs.h), and CanvasWrapper (via SpeedFlipTrainer.h -> bakkesmodplugin.h)
+#include "bakkesmod/plugin/bakkesmodplugin.h" // For Vector2, LinearColor and CanvasWrapper
+#include "DrawList.h"
 #include <list>               // For std::list
-
-// Note: The original 'Color' struct here caused redefinition errors.
-// We will use 'CustomColor' from SpeedFlipTrainer.h or pass LinearColor directly.
+#include <vector>             // For std::vector
 
 struct LineStyle {
     CustomColor color;
@@ -28,6 +27,53 @@ struct MeterMarking {
     MeterMarking(CustomColor color, int width, int val) : lineStyle(LineStyle{ color, width }), value(val) {}
 };
 
+// Pixel geometry of a meter, computed once from the same inputs RenderMeter takes.
+// Only the current value marker changes between frames, so a layout is kept until
+// the screen size or the meter thresholds change and drawn as is every frame.
+struct MeterLayout {
+    struct Box {
+        CustomColor color;
+        Vector2 position;
+        Vector2 size;
+    };
+
+    struct Line {
+        CustomColor color;
+        Vector2 start;
+        Vector2 end;
+        int width;
+    };
+
+    Vector2 startPos;
+    Vector2 boxSize;
+    int totalUnits = 0;
+    bool vertical = false;
+    float unitPixelSize = 0;
+    LineStyle border;
+
+    std::vector<Box> boxes;  // Background first, then the ranges
+    std::vector<Line> lines; // Markings
+
+    // False when the meter is too small to draw anything
+    bool IsDrawable() const { return !boxes.empty(); }
+
+    // Marker for a value in meter units
+    Line ValueMarker(float value) const;
+};
+
+MeterLayout BuildMeterLayout(
+    Vector2 startPos,
+    Vector2 reqBoxSize,
+    CustomColor baseColor,
+    LineStyle borderStyle,
+    int totalUnits,
+    const std::list<MeterRange>& ranges,
+    const std::list<MeterMarking>& markings,
+    bool vertical
+);
+
+// Records a layout into drawList, currentValue is drawn as a marker when >= 0
+void DrawMeterLayout(DrawList& drawList, const MeterLayout& layout, float currentValue = -1.0f);
 
 // Renders a generic meter (horizontal or vertical)
 // Returns the bottom-right Vector2 of the drawn meter box (can be used for positioning related elements)
@@ -43,4 +89,4 @@ Vector2 RenderMeter(
     bool vertical,            // True if the meter is vertical, false for horizontal
     float currentValue = -1.0f // Optional: a specific value to highlight with a special marker (e.g. current player value)
     // If >= 0, it will be drawn. Interpretation depends on implementation.
-);
\ No newline at end of file
+);
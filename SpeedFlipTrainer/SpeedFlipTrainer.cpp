@@ -7,138 +7,30 @@ BAKKESMOD_PLUGIN(SpeedFlipTrainer, "Speedflip Trainer", plugin_version, PLUGINTY
 std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
 
 
-// Helper struct for clock time
-struct clock_time {
-    int hour_hand;
-    int min_hand;
-};
-
 // --- SpeedFlipTrainer Member Function Implementations ---
 
-SpeedFlipTrainer::SpeedFlipTrainer() {
-    // Initialize shared_ptr members for CVars
-    showCarAxes = std::make_shared<bool>(true);
-    axisLength = std::make_shared<float>(150.0f);
-    enabled = std::make_shared<bool>(true);
-    showAngleMeter = std::make_shared<bool>(true);
-    showPositionMeter = std::make_shared<bool>(true);
-    showFlipMeter = std::make_shared<bool>(true);
-    showJumpMeter = std::make_shared<bool>(true);
-    changeSpeed = std::make_shared<bool>(false);
-    speed = std::make_shared<float>(1.0f);
-    rememberSpeed = std::make_shared<bool>(true);
-    numHitsChangedSpeed = std::make_shared<int>(3);
-    speedIncrement = std::make_shared<float>(0.05f);
-    optimalLeftAngle = std::make_shared<int>(-30);
-    optimalRightAngle = std::make_shared<int>(30);
-    flipCancelThreshold = std::make_shared<int>(13);
-    jumpLow = std::make_shared<int>(40);
-    jumpHigh = std::make_shared<int>(90);
-    saveToFile = std::make_shared<bool>(false);
-}
-
-
-SpeedFlipTrainer::Orientation SpeedFlipTrainer::RotatorToOrientation(const Rotator& rotation) {
-    Orientation result;
-
-    float pitch = rotation.Pitch * CONST_PI_F / 32768.0f;
-    float yaw = rotation.Yaw * CONST_PI_F / 32768.0f;
-    float roll = rotation.Roll * CONST_PI_F / 32768.0f;
-
-    float sp = sinf(pitch);
-    float cp = cosf(pitch);
-    float sy = sinf(yaw);
-    float cy = cosf(yaw);
-    float sr = sinf(roll);
-    float cr = cosf(roll);
-
-    result.forward.X = cp * cy;
-    result.forward.Y = cp * sy;
-    result.forward.Z = sp;
-
-    result.right.X = cy * sr * sp + cr * sy;
-    result.right.Y = sy * sr * sp - cr * cy;
-    result.right.Z = -cp * sr;
-
-    result.up.X = -cr * sp * cy + sr * sy;
-    result.up.Y = -cr * sp * sy - sr * cy;
-    result.up.Z = cp * cr;
-
-    return result;
-}
-
-
-Matrix SpeedFlipTrainer::GetViewProjectionMatrix(CameraWrapper camera) {
+Matrix SpeedFlipTrainer::GetViewProjectionMatrix(CameraWrapper camera, Vector2 screenSize) {
     if (camera.IsNull()) return Matrix();
 
-    Vector camLocation = camera.GetLocation();
-    Rotator camRotation = camera.GetRotation();
-    float FOV = camera.GetFOV();
-    Vector2 screenSize = gameWrapper->GetScreenSize();
     float aspect = (screenSize.Y > 0) ? static_cast<float>(screenSize.X) / screenSize.Y : 16.0f / 9.0f;
-
-
-    Orientation camOrientation = RotatorToOrientation(camRotation);
-    Vector f = camOrientation.forward;
-    Vector r = camOrientation.right;
-    Vector u = camOrientation.up;
-
-    Matrix viewMatrix;
-    viewMatrix.M[0][0] = r.X; viewMatrix.M[0][1] = r.Y; viewMatrix.M[0][2] = r.Z; viewMatrix.M[0][3] = -Vector::dot(r, camLocation);
-    viewMatrix.M[1][0] = u.X; viewMatrix.M[1][1] = u.Y; viewMatrix.M[1][2] = u.Z; viewMatrix.M[1][3] = -Vector::dot(u, camLocation);
-    viewMatrix.M[2][0] = -f.X;viewMatrix.M[2][1] = -f.Y;viewMatrix.M[2][2] = -f.Z;viewMatrix.M[2][3] = Vector::dot(f, camLocation);
-    viewMatrix.M[3][0] = 0;   viewMatrix.M[3][1] = 0;   viewMatrix.M[3][2] = 0;   viewMatrix.M[3][3] = 1;
-
-
-    Matrix projMatrix;
-    float nearPlane = 10.0f;
-    float farPlane = 30000.0f;
-    float fovRadians = FOV * (CONST_PI_F / 180.0f);
-    float yScale = 1.0f / tanf(fovRadians / 2.0f);
-    float xScale = yScale / aspect;
-
-    projMatrix.M[0][0] = xScale; projMatrix.M[0][1] = 0;      projMatrix.M[0][2] = 0;                            projMatrix.M[0][3] = 0;
-    projMatrix.M[1][0] = 0;      projMatrix.M[1][1] = yScale; projMatrix.M[1][2] = 0;                            projMatrix.M[1][3] = 0;
-    projMatrix.M[2][0] = 0;      projMatrix.M[2][1] = 0;      projMatrix.M[2][2] = farPlane / (farPlane - nearPlane); projMatrix.M[2][3] = -(farPlane * nearPlane) / (farPlane - nearPlane);
-    projMatrix.M[3][0] = 0;      projMatrix.M[3][1] = 0;      projMatrix.M[3][2] = 1;                            projMatrix.M[3][3] = 0;
-
-    return projMatrix * viewMatrix;
+    return ViewProjectionMatrix(camera.GetLocation(), camera.GetRotation(), camera.GetFOV(), aspect);
 }
 
 
-Vector2 SpeedFlipTrainer::WorldToScreen(CanvasWrapper canvas, Vector location) {
-    if (!gameWrapper) return Vector2{ 0,0 };
+ProjectionContext SpeedFlipTrainer::BeginProjection(CanvasWrapper canvas) {
+    if (!gameWrapper) return ProjectionContext();
     CameraWrapper camera = gameWrapper->GetCamera();
-    if (camera.IsNull()) return Vector2{ 0, 0 };
+    if (camera.IsNull()) return ProjectionContext();
 
     Vector2 screenSize = canvas.GetSize();
-    if (screenSize.X == 0 || screenSize.Y == 0) return Vector2{ 0,0 };
-
-    Matrix viewProjMatrix = GetViewProjectionMatrix(camera);
-    Vector4 locationVec4(location, 1.0f);
-    Vector4 clipSpaceLocation = viewProjMatrix * locationVec4;
-
-    if (clipSpaceLocation.W == 0.0f || clipSpaceLocation.W < 0.0f) {
-        return Vector2{ -1, -1 };
-    }
-
-    float ndcX = clipSpaceLocation.X / clipSpaceLocation.W;
-    float ndcY = clipSpaceLocation.Y / clipSpaceLocation.W;
+    if (screenSize.X == 0 || screenSize.Y == 0) return ProjectionContext();
 
-    int screenX = static_cast<int>((ndcX * 0.5f + 0.5f) * screenSize.X);
-    int screenY = static_cast<int>((-ndcY * 0.5f + 0.5f) * screenSize.Y);
-
-    return Vector2{ screenX, screenY };
-}
-
-bool SpeedFlipTrainer::IsPointOnScreen(const Vector2& point, float screenWidth, float screenHeight) {
-    return point.X >= 0 && point.X <= screenWidth &&
-        point.Y >= 0 && point.Y <= screenHeight;
+    return ProjectionContext(GetViewProjectionMatrix(camera, screenSize), screenSize);
 }
 
-void SpeedFlipTrainer::DrawArrow(CanvasWrapper& canvas, Vector2 start, Vector2 end, const CustomColor& color, int thickness) {
-    canvas.SetColor(color.r, color.g, color.b, color.GetAlphaChar());
-    canvas.DrawLine(start, end, thickness);
+void SpeedFlipTrainer::DrawArrow(Vector2 start, Vector2 end, const CustomColor& color, int thickness) {
+    float width = static_cast<float>(thickness);
+    drawList.DrawLine(DrawLayer::Lines, color, start, end, width);
 
     float dx = static_cast<float>(end.X - start.X);
     float dy = static_cast<float>(end.Y - start.Y);
@@ -155,15 +47,15 @@ void SpeedFlipTrainer::DrawArrow(CanvasWrapper& canvas, Vector2 start, Vector2 e
 
     float x1 = end.X - arrowSize * (dx * cosf(arrowAngleRadians) - dy * sinf(arrowAngleRadians));
     float y1 = end.Y - arrowSize * (dy * cosf(arrowAngleRadians) + dx * sinf(arrowAngleRadians));
-    canvas.DrawLine(end, Vector2{ static_cast<int>(x1), static_cast<int>(y1) }, thickness);
+    drawList.DrawLine(DrawLayer::Lines, color, end, Vector2{ static_cast<int>(x1), static_cast<int>(y1) }, width);
 
     float x2 = end.X - arrowSize * (dx * cosf(-arrowAngleRadians) - dy * sinf(-arrowAngleRadians));
     float y2 = end.Y - arrowSize * (dy * cosf(-arrowAngleRadians) + dx * sinf(-arrowAngleRadians));
-    canvas.DrawLine(end, Vector2{ static_cast<int>(x2), static_cast<int>(y2) }, thickness);
+    drawList.DrawLine(DrawLayer::Lines, color, end, Vector2{ static_cast<int>(x2), static_cast<int>(y2) }, width);
 }
 
-void SpeedFlipTrainer::RenderCarAxes(CanvasWrapper canvas) {
-    if (!gameWrapper || !*enabled || !loaded || !*showCarAxes || !gameWrapper->IsInCustomTraining())
+void SpeedFlipTrainer::RenderCarAxes(CanvasWrapper canvas, const TrainerConfig& config, const ProjectionContext& projection) {
+    if (!gameWrapper || !config.enabled || !loaded || !config.showCarAxes || !projection.IsValid() || !gameWrapper->IsInCustomTraining())
         return;
 
     CarWrapper car = gameWrapper->GetLocalCar();
@@ -180,129 +72,152 @@ void SpeedFlipTrainer::RenderCarAxes(CanvasWrapper canvas) {
     CustomColor purpleColor(128, 0, 128);
     CustomColor whiteColor(255, 255, 255);
 
-    Vector2 screenSize = canvas.GetSize();
-    Vector2 carPos2D = WorldToScreen(canvas, carLocation);
-
-    if (!IsPointOnScreen(carPos2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) return;
+    float diagonalLength = config.axisLength * 0.6f;
+    Vector frontLeftDir = orientation.forward - orientation.right;
+    frontLeftDir.normalize();
+    Vector frontRightDir = orientation.forward + orientation.right;
+    frontRightDir.normalize();
+
+    enum { Car, Forward, Right, Up, FrontLeft, FrontRight, PointCount };
+    Vector points[PointCount] = {
+        carLocation,
+        carLocation + orientation.forward * config.axisLength,
+        carLocation + orientation.right * config.axisLength,
+        carLocation + orientation.up * config.axisLength,
+        carLocation + frontLeftDir * diagonalLength,
+        carLocation + frontRightDir * diagonalLength,
+    };
+    Vector2 screen[PointCount];
+    bool visible[PointCount];
+    projection.ProjectBatch(points, PointCount, screen, visible);
+
+    if (visible[Car])
+        drawList.FillBox(DrawLayer::Overlay, whiteColor, screen[Car] - Vector2{ 2,2 }, Vector2{ 5, 5 });
+
+    // Each axis is clipped to the view, so it stays drawn up to the screen edge or near plane
+    // when the car or the tip is off screen. The head is only drawn on a tip that is visible.
+    auto drawAxis = [&](int tip, const CustomColor& color) {
+        Vector2 from, to;
+        if (!projection.ProjectSegment(points[Car], points[tip], from, to)) return;
+        if (visible[tip]) DrawArrow(from, to, color);
+        else drawList.DrawLine(DrawLayer::Lines, color, from, to, 2.0f);
+    };
+    drawAxis(Forward, greenColor);
+    drawAxis(Right, redColor);
+    drawAxis(Up, blueColor);
+    drawAxis(FrontLeft, orangeColor);
+    drawAxis(FrontRight, purpleColor);
+
+    Vector2 screenSize = projection.ScreenSize();
+    int textY = screenSize.Y - 60;
+    drawList.DrawString(whiteColor, Vector2{ 10, textY }, "Rouge (X): Droite | Vert (Y): Avant | Bleu (Z): Haut");
+    textY += 20;
+    drawList.DrawString(whiteColor, Vector2{ 10, textY }, "Orange: Avant-Gauche | Violet: Avant-Droit");
+}
 
-    canvas.SetColor(whiteColor.r, whiteColor.g, whiteColor.b, whiteColor.GetAlphaChar());
-    canvas.SetPosition(carPos2D - Vector2{ 2,2 });
-    canvas.FillBox(Vector2{ 5, 5 });
 
-    Vector forwardEnd = carLocation + orientation.forward * (*axisLength);
-    Vector rightEnd = carLocation + orientation.right * (*axisLength);
-    Vector upEnd = carLocation + orientation.up * (*axisLength);
+Vector2 SpeedFlipTrainer::MeasureText(CanvasWrapper& canvas, std::string_view text) {
+    return textMeasureCache.Get(text, 1.0f, [&]() {
+        measureScratch.assign(text.data(), text.size());
+        AllocationCounter::Exclude sdkCopy;
+        Vector2F size = canvas.GetStringSize(measureScratch);
+        return Vector2{ static_cast<int>(size.X), static_cast<int>(size.Y) };
+        });
+}
 
-    Vector2 forwardEnd2D = WorldToScreen(canvas, forwardEnd);
-    Vector2 rightEnd2D = WorldToScreen(canvas, rightEnd);
-    Vector2 upEnd2D = WorldToScreen(canvas, upEnd);
+void SpeedFlipTrainer::RenderStats(Vector2& pos) {
+    CustomColor color(255, 255, 255, 1.0f);
+    int lineHeight = 15;
 
-    if (IsPointOnScreen(forwardEnd2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) DrawArrow(canvas, carPos2D, forwardEnd2D, greenColor);
-    if (IsPointOnScreen(rightEnd2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) DrawArrow(canvas, carPos2D, rightEnd2D, redColor);
-    if (IsPointOnScreen(upEnd2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) DrawArrow(canvas, carPos2D, upEnd2D, blueColor);
+    FixedString<96> draw("Draw: {} commands, {} canvas calls, {} color changes", lastDrawStats.commands, lastDrawStats.canvasCalls, lastDrawStats.colorChanges);
+    drawList.DrawString(color, pos, draw.View());
+    pos.Y += lineHeight;
 
-    float diagonalLength = (*axisLength) * 0.6f;
-    Vector frontLeftDir_temp = orientation.forward - orientation.right;
-    frontLeftDir_temp.normalize();
-    Vector frontLeftDir = frontLeftDir_temp;
+    FixedString<96> text("Text cache: {} hits, {} misses, {} entries", textMeasureCache.Hits(), textMeasureCache.Misses(), textMeasureCache.Size());
+    drawList.DrawString(color, pos, text.View());
+    pos.Y += lineHeight;
 
-    Vector frontRightDir_temp = orientation.forward + orientation.right;
-    frontRightDir_temp.normalize();
-    Vector frontRightDir = frontRightDir_temp;
+    FixedString<96> wrapper("SetVehicleInput wrapper calls: {} (max {})", lastWrapperCalls, maxWrapperCalls);
+    drawList.DrawString(color, pos, wrapper.View());
+    pos.Y += lineHeight;
 
+    if (AllocationCounter::Enabled) {
+        FixedString<96> allocations("Frame allocations: {} ({} allocating frames)", lastFrameAllocations, allocatingFrames);
+        drawList.DrawString(color, pos, allocations.View());
+        pos.Y += lineHeight;
+    }
+}
 
-    Vector2 frontLeftEnd2D = WorldToScreen(canvas, carLocation + frontLeftDir * diagonalLength);
-    Vector2 frontRightEnd2D = WorldToScreen(canvas, carLocation + frontRightDir * diagonalLength);
+void SpeedFlipTrainer::RenderLatency(Vector2& pos) {
+    CustomColor color(255, 255, 255, 1.0f);
+    int lineHeight = 15;
 
-    if (IsPointOnScreen(frontLeftEnd2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) DrawArrow(canvas, carPos2D, frontLeftEnd2D, orangeColor);
-    if (IsPointOnScreen(frontRightEnd2D, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y))) DrawArrow(canvas, carPos2D, frontRightEnd2D, purpleColor);
+    if (!Profiling::Enabled) {
+        drawList.DrawString(color, pos, "Latency profiling is not compiled in");
+        pos.Y += lineHeight;
+        return;
+    }
 
-    canvas.SetColor(whiteColor.r, whiteColor.g, whiteColor.b, whiteColor.GetAlphaChar());
-    int textY = screenSize.Y - 60;
-    canvas.SetPosition(Vector2{ 10, textY });
-    canvas.DrawString("Rouge (X): Droite | Vert (Y): Avant | Bleu (Z): Haut");
-    textY += 20;
-    canvas.SetPosition(Vector2{ 10, textY });
-    canvas.DrawString("Orange: Avant-Gauche | Violet: Avant-Droit");
+    for (int i = 0; i < Prof_Count; i++) {
+        LatencySummary summary = latency[i].Summarize();
+        FixedString<96> line("{}: p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us ({} samples)", latency[i].Name(),
+            summary.p50 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0, summary.samples);
+        drawList.DrawString(color, pos, line.View());
+        pos.Y += lineHeight;
+    }
 }
 
+void SpeedFlipTrainer::TrackFrameAllocations(uint64_t allocations, bool layoutsRebuilt) {
+    if (!AllocationCounter::Enabled) return;
+    lastFrameAllocations = allocations;
 
-void SpeedFlipTrainer::RenderMeters(CanvasWrapper canvas) {
-    if (!gameWrapper || !*enabled || !loaded || !gameWrapper->IsInCustomTraining()) return;
+    // Buffers still grow during the first frames and rebuilding the layouts allocates
+    if (layoutsRebuilt || ++renderedFrames <= AllocationWarmupFrames) return;
+    if (allocations == 0) return;
 
-    Vector2 screenSize = canvas.GetSize();
-
-    if (*showAngleMeter) RenderAngleMeter(canvas, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y));
-    if (*showPositionMeter) RenderPositionMeter(canvas, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y));
-    if (*showFlipMeter) RenderFlipCancelMeter(canvas, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y));
-    if (*showJumpMeter) RenderFirstJumpMeter(canvas, static_cast<float>(screenSize.X), static_cast<float>(screenSize.Y));
-    if (*showCarAxes) RenderCarAxes(canvas);
+    allocatingFrames++;
+    if (!frameAllocationWarned) {
+        SF_LOG_WARNING("Render frame made {} heap allocations, frames are expected to be allocation free", allocations);
+        frameAllocationWarned = true;
+    }
 }
 
-int ComputeDodgeAngle(DodgeComponentWrapper dodge) {
-    if (dodge.IsNull()) return 0;
-    Vector dd = dodge.GetDodgeDirection();
-    if (dd.X == 0 && dd.Y == 0) return 0;
-    return static_cast<int>(atan2f(dd.Y, dd.X) * (180.0f / CONST_PI_F));
-}
+void SpeedFlipTrainer::RenderMeters(CanvasWrapper canvas) {
+    SF_PROFILE_SCOPE(latency[Prof_Render]);
+    AllocationScope frameAllocations;
+    std::shared_ptr<const TrainerConfig> config = settings.Get();
+    if (!gameWrapper || !config->enabled || !loaded || !gameWrapper->IsInCustomTraining()) return;
 
-clock_time ComputeClockTime(int angle) {
-    if (angle < 0) angle += 360;
-    clock_time time;
-    time.hour_hand = static_cast<int>(angle * (12.0 / 360.0));
-    if (time.hour_hand == 0) time.hour_hand = 12;
-    time.min_hand = (angle % (360 / 12)) * (60 / (360 / 12));
-    return time;
+    Vector2 screenSize = canvas.GetSize();
+
+    bool layoutsRebuilt = UpdateMeterLayouts(*config, screenSize);
+    textMeasureCache.BeginFrame(screenSize);
+
+    const LiveMetrics& live = session.ReadMetrics();
+    if (config->showAngleMeter) RenderAngleMeter(canvas, *config, live);
+    if (config->showPositionMeter) RenderPositionMeter(canvas, *config, live);
+    if (config->showFlipMeter) RenderFlipCancelMeter(canvas, *config, live);
+    if (config->showJumpMeter) RenderFirstJumpMeter(canvas, *config, live);
+    if (config->showCarAxes) RenderCarAxes(canvas, *config, BeginProjection(canvas));
+    Vector2 overlayPos = { 10, 10 };
+    if (config->showStats) RenderStats(overlayPos);
+    if (config->showLatency) RenderLatency(overlayPos);
+
+    lastDrawStats = drawList.Flush(canvas);
+    TrackFrameAllocations(frameAllocations.Allocations(), layoutsRebuilt);
 }
 
 float distance(Vector a, Vector b) {
-    return sqrt(pow(a.X - b.X, 2) + pow(a.Y - b.Y, 2) + pow(a.Z - b.Z, 2));
+    Vector d = a - b;
+    return sqrtf(Vector::dot(d, d));
 }
 
-void SpeedFlipTrainer::Measure(CarWrapper car, PriWrapper pri) {
-    if (!gameWrapper || car.IsNull() || pri.IsNull()) return;
-
-    int currentPhysicsFrame = gameWrapper->GetEngine().GetPhysicsFrame();
-    int currentTick = currentPhysicsFrame - startingPhysicsFrame;
-    if (currentTick < 0) return;
-
-    ControllerInput input = car.GetInput();
-    attempt.Record(currentTick, input);
-
-    Vector loc = car.GetLocation();
-    // Ensure Attempt class has 'pathPoints', 'totalDistanceTraveled', and 'currentPosition' members
-    if (attempt.pathPoints.empty()) {
-        attempt.pathPoints.push_back(loc);
-        attempt.totalDistanceTraveled = 0;
-    }
-    else {
-        attempt.totalDistanceTraveled += distance(attempt.pathPoints.back(), loc);
-        attempt.pathPoints.push_back(loc);
-    }
-    attempt.currentPosition = loc;
-
-    if (!attempt.jumped && car.GetbJumped()) {
-        attempt.jumped = true;
-        attempt.jumpTick = currentTick;
-        LOG("First jump: {} ticks", currentTick);
-    }
-
-    DodgeComponentWrapper dodge = car.GetDodgeComponent();
-    if (!attempt.dodged && !dodge.IsNull() && dodge.GetDodgeTorque().X != 0) {
-        attempt.dodged = true;
-        attempt.dodgedTick = currentTick;
-        attempt.dodgeAngle = ComputeDodgeAngle(dodge);
-        clock_time time = ComputeClockTime(attempt.dodgeAngle);
-        LOG("Dodge Angle: {:03d} deg or {:02d}:{:02d}", attempt.dodgeAngle, time.hour_hand, time.min_hand);
-    }
-
-    if (input.Throttle < 0.9f) attempt.ticksNotPressingThrottle++;
-    if (!input.ActivateBoost) attempt.ticksNotPressingBoost++;
-
-    if (attempt.dodged && !attempt.flipCanceled && input.Pitch > 0.8f) {
-        attempt.flipCanceled = true;
-        attempt.flipCancelTick = currentTick;
-        LOG("Flip Cancel: {} ticks after dodge", attempt.flipCancelTick - attempt.dodgedTick);
+void SpeedFlipTrainer::TrackWrapperCalls(int calls, int budget) {
+    lastWrapperCalls = calls;
+    maxWrapperCalls = std::max(maxWrapperCalls, calls);
+    if (calls > budget && !wrapperBudgetWarned) {
+        wrapperBudgetWarned = true;
+        SF_LOG_WARNING("SetVehicleInput made {} wrapper calls, over the budget of {}", calls, budget);
     }
 }
 
@@ -313,79 +228,44 @@ void SpeedFlipTrainer::Hook() {
     LOG("Hooking events");
     gameWrapper->RegisterDrawable(std::bind(&SpeedFlipTrainer::RenderMeters, this, std::placeholders::_1));
 
-    if (*rememberSpeed) {
-        CVarWrapper speedCvar = _globalCvarManager->getCvar("sv_soccar_gamespeed");
-        if (speedCvar) speedCvar.setValue(*speed);
+    std::shared_ptr<const TrainerConfig> config = settings.Get();
+    if (config->rememberSpeed && settings.gameSpeedCvar) {
+        settings.gameSpeedCvar.setValue(config->speed);
     }
 
     gameWrapper->HookEventWithCaller<CarWrapper>("Function TAGame.Car_TA.SetVehicleInput",
         [this](CarWrapper car, void* params, std::string eventname) {
-            if (!gameWrapper || !*enabled || !loaded || !gameWrapper->IsInCustomTraining() || car.IsNull()) return;
+            SF_PROFILE_SCOPE(latency[Prof_SetVehicleInput]);
+            std::shared_ptr<const TrainerConfig> config = settings.Get();
+            if (!gameWrapper || !config->enabled || !loaded || car.IsNull() || !gameWrapper->IsInCustomTraining()) return;
 
-            if (*rememberSpeed) {
-                CVarWrapper speedCvarRead = _globalCvarManager->getCvar("sv_soccar_gamespeed");
-                if (speedCvarRead) *this->speed = speedCvarRead.getFloatValue();
-            }
+            CarTickSnapshot snap = CarTickSnapshot::Capture(*gameWrapper, car, session.NeedsDodge(), config->capturePhysics);
+            snap.wrapperCalls++; // IsInCustomTraining
 
             ControllerInput* ci = (ControllerInput*)params;
-            PriWrapper pri = car.GetPRI();
-            if (pri.IsNull()) return;
-
-
-            if (mode == SpeedFlipTrainerMode::Bot) {
-                PlayBot(ci);
-            }
-            else if (mode == SpeedFlipTrainerMode::Replay) {
-                PlayAttempt(&replayAttempt, ci);
-            }
-
-
-            ServerWrapper server = gameWrapper->GetCurrentGameState();
-            if (server.IsNull()) return;
-            float timeLeft = server.GetGameTimeRemaining();
-            int currentFrame = gameWrapper->GetEngine().GetPhysicsFrame();
-
-            if (initialTime <= 0 || timeLeft >= initialTime) {
-                if (timeLeft > 0 && (initialTime <= 0 || timeLeft > initialTime + 0.1f)) {
-                    initialTime = timeLeft;
-                    LOG("Initial time set to: {}", initialTime);
-                }
-                return;
-            }
-
-            if (startingPhysicsFrame < 0 && timeLeft < initialTime && timeLeft > 0) {
-                startingPhysicsFrame = currentFrame;
-                LOG("Attempt started at physics frame: {}", startingPhysicsFrame);
-                attempt = Attempt();
-                // Ensure Attempt class has 'initialCarLocation' member
-                attempt.initialCarLocation = car.GetLocation();
-
-                if (!car.IsOnGround()) attempt.startedInAir = true;
-                if (!ci->ActivateBoost) attempt.startedNoBoost = true;
-            }
-
-            if (startingPhysicsFrame >= 0 && !attempt.exploded && !attempt.hit) {
-                Measure(car, pri);
+            if (session.OnTick(snap, ci)) {
+                gameWrapper->OverrideParams(ci, sizeof(ControllerInput));
+                snap.wrapperCalls++;
             }
+            TrackWrapperCalls(snap.wrapperCalls, snap.WrapperCallLimit());
         });
 
     gameWrapper->HookEvent("Function TAGame.Ball_TA.RecordCarHit",
         [this](std::string eventname) {
-            if (!gameWrapper || !*enabled || !loaded || !gameWrapper->IsInCustomTraining() || attempt.hit || attempt.exploded || startingPhysicsFrame < 0) return;
+            SF_PROFILE_SCOPE(latency[Prof_RecordCarHit]);
+            if (!gameWrapper || !settings.Get()->enabled || !loaded || !gameWrapper->IsInCustomTraining() || !session.WaitingForBall()) return;
 
             BallWrapper ball = gameWrapper->GetGameEventAsServer().GetBall();
             CarWrapper car = gameWrapper->GetLocalCar();
             if (ball.IsNull() || car.IsNull()) return;
 
-            attempt.ticksToBall = gameWrapper->GetEngine().GetPhysicsFrame() - startingPhysicsFrame;
-            attempt.timeToBall = initialTime - gameWrapper->GetCurrentGameState().GetGameTimeRemaining();
-            attempt.hit = true;
-            LOG("Ball hit: {:.3f}s after {} ticks", attempt.timeToBall, attempt.ticksToBall);
+            session.OnBallHit(gameWrapper->GetEngine().GetPhysicsFrame(), gameWrapper->GetCurrentGameState().GetGameTimeRemaining());
         });
 
     gameWrapper->HookEvent("Function TAGame.Ball_TA.Explode",
         [this](std::string eventName) {
-            if (!gameWrapper || !*enabled || !loaded || !gameWrapper->IsInCustomTraining() || startingPhysicsFrame < 0) return;
+            SF_PROFILE_SCOPE(latency[Prof_Explode]);
+            if (!gameWrapper || !settings.Get()->enabled || !loaded || !gameWrapper->IsInCustomTraining() || !session.AttemptRunning()) return;
 
             ServerWrapper server = gameWrapper->GetGameEventAsServer();
             if (server.IsNull()) return;
@@ -395,69 +275,51 @@ void SpeedFlipTrainer::Hook() {
 
             float distToBall = distance(ball.GetLocation(), car.GetLocation());
             float meters = distToBall / 100.0f;
-            LOG("Ball exploded. Distance to ball center = {:.1f}m", meters);
+            SF_LOG_INFO("Ball exploded. Distance to ball center = {:.1f}m", meters);
 
-            attempt.exploded = true;
-            attempt.hit = false;
+            session.OnExplode();
         });
 
     gameWrapper->HookEventPost("Function Engine.Controller.Restart",
         [this](std::string eventName) {
-            if (!gameWrapper || !*enabled || !loaded || !gameWrapper->IsInCustomTraining()) return;
+            SF_PROFILE_SCOPE(latency[Prof_Restart]);
+            std::shared_ptr<const TrainerConfig> config = settings.Get();
+            if (!gameWrapper || !config->enabled || !loaded || !gameWrapper->IsInCustomTraining()) return;
 
-            LOG("Round restarted (Controller.Restart)");
+            SF_LOG_DEBUG("Round restarted (Controller.Restart)");
 
             ServerWrapper server = gameWrapper->GetCurrentGameState();
-            if (!server.IsNull()) initialTime = server.GetGameTimeRemaining();
-            else initialTime = 0;
+            RoundResult round = session.OnRestart(server.IsNull() ? 0 : server.GetGameTimeRemaining());
 
-            startingPhysicsFrame = -1;
-
-            if (attempt.hit && !attempt.exploded) {
-                consecutiveHits++;
-                consecutiveMiss = 0;
-            }
-            // Ensure Attempt class has 'inputs' member (std::vector or similar with .size())
-            else if (attempt.inputs.size() > 0) {
-                consecutiveHits = 0;
-                consecutiveMiss++;
-            }
-
-            if (*saveToFile && attempt.inputs.size() > 0) {
-                if (!std::filesystem::exists(dataDir)) {
-                    std::filesystem::create_directories(dataDir);
-                }
-                auto attemptSubDir = dataDir / "attempts";
-                if (!std::filesystem::exists(attemptSubDir)) {
-                    std::filesystem::create_directories(attemptSubDir);
+            if (round.attempt) {
+                lastAttempt = std::move(round.attempt);
+                if (config->saveToFile) {
+                    auto path = lastAttempt->GetFilename(dataDir / "attempts", config->saveBinary ? AttemptFileExtension : ".csv");
+                    SaveAttempt(lastAttempt, path, "attempt");
                 }
-                auto path = attempt.GetFilename(attemptSubDir);
-                attempt.WriteInputsToFile(path);
-                LOG("Saved attempt to: {}", path.string());
             }
 
-            CVarWrapper speedCvar = _globalCvarManager->getCvar("sv_soccar_gamespeed");
-            if (!speedCvar) return;
-            float currentSpeed = speedCvar.getFloatValue();
+            if (!settings.gameSpeedCvar) return;
+            float currentSpeed = config->gameSpeed;
 
-            if (*changeSpeed) {
+            if (config->changeSpeed) {
                 bool speedChanged = false;
-                if (consecutiveHits > 0 && consecutiveHits % (*numHitsChangedSpeed) == 0) {
-                    gameWrapper->LogToChatbox(std::to_string(consecutiveHits) + (consecutiveHits > 1 ? " hits" : " hit") + " in a row!");
-                    currentSpeed += *speedIncrement;
+                if (round.consecutiveHits > 0 && round.consecutiveHits % config->numHitsChangedSpeed == 0) {
+                    gameWrapper->LogToChatbox(std::to_string(round.consecutiveHits) + (round.consecutiveHits > 1 ? " hits" : " hit") + " in a row!");
+                    currentSpeed += config->speedIncrement;
                     speedChanged = true;
                 }
-                else if (consecutiveMiss > 0 && consecutiveMiss % (*numHitsChangedSpeed) == 0) {
-                    gameWrapper->LogToChatbox(std::to_string(consecutiveMiss) + (consecutiveMiss > 1 ? " misses" : " miss") + " in a row.");
-                    currentSpeed -= *speedIncrement;
+                else if (round.consecutiveMiss > 0 && round.consecutiveMiss % config->numHitsChangedSpeed == 0) {
+                    gameWrapper->LogToChatbox(std::to_string(round.consecutiveMiss) + (round.consecutiveMiss > 1 ? " misses" : " miss") + " in a row.");
+                    currentSpeed -= config->speedIncrement;
                     if (currentSpeed < 0.1f) currentSpeed = 0.1f;
                     speedChanged = true;
                 }
 
                 if (speedChanged) {
-                    speedCvar.setValue(currentSpeed);
-                    *this->speed = currentSpeed;
-                    LOG("Game speed changed to: {:.3f}", currentSpeed);
+                    settings.gameSpeedCvar.setValue(currentSpeed);
+                    settings.speedCvar.setValue(currentSpeed);
+                    SF_LOG_INFO("Game speed changed to: {:.3f}", currentSpeed);
                     gameWrapper->LogToChatbox(fmt::format("Game speed set to: {:.0f}%", currentSpeed * 100));
                 }
             }
@@ -466,39 +328,81 @@ void SpeedFlipTrainer::Hook() {
 
 void SpeedFlipTrainer::onLoad() {
     _globalCvarManager = cvarManager;
+    // The console is only written on the game thread, the logger thread queues its lines for it
+    if (gameWrapper) {
+        logLines.SetDispatcher([this](LogLineQueue::Job job) {
+            gameWrapper->Execute([job = std::move(job)](GameWrapper*) { job(); });
+            });
+    }
+    AsyncLogger::Instance().Start([this](LogLevel level, const std::string& line) {
+        logLines.Push(level, line);
+        });
     LOG("SpeedFlipTrainer onLoad start");
+    SF_TRACE_THREAD_NAME("Game");
 
-    cvarManager->registerCvar("sf_show_axes", "1", "Show car orientation axes.", true, true, 0, true, 1)
-        .bindTo(showCarAxes);
-    cvarManager->registerCvar("sf_axis_length", "150.0", "Length of car orientation axes.", true, true, 50.0f, true, 500.0f)
-        .bindTo(axisLength);
-    cvarManager->registerCvar("sf_enabled", "1", "Enable Speedflip trainer plugin.", true, true, 0, true, 1)
-        .bindTo(enabled);
-    cvarManager->getCvar("sf_enabled").addOnValueChanged([this](const std::string& oldVal, CVarWrapper cvar) {
-        if (*enabled) Hook(); else onUnload();
+    settings.Register(*cvarManager);
+    measureScratch.reserve(128);
+    settings.enabledCvar.addOnValueChanged([this](const std::string& oldVal, CVarWrapper cvar) {
+        if (cvar.getBoolValue()) Hook(); else Unhook();
         });
 
-    cvarManager->registerCvar("sf_show_angle", "1", "Show dodge angle meter.").bindTo(showAngleMeter);
-    cvarManager->registerCvar("sf_show_position", "1", "Show horizontal position meter.").bindTo(showPositionMeter);
-    cvarManager->registerCvar("sf_show_jump", "1", "Show first jump timing meter.").bindTo(showJumpMeter);
-    cvarManager->registerCvar("sf_show_flip", "1", "Show flip cancel timing meter.").bindTo(showFlipMeter);
+    cvarManager->registerNotifier("sf_wrapper_calls", [this](std::vector<std::string> args) {
+        LOG("SetVehicleInput wrapper calls: last {}, max {}, budget {} (+{} with sf_capture_physics)", lastWrapperCalls, maxWrapperCalls,
+            CarTickSnapshot::WrapperCallBudget, CarTickSnapshot::PhysicsCallBudget);
+        }, "Print the number of game wrapper calls made per SetVehicleInput tick.", PERMISSION_ALL);
 
-    cvarManager->registerCvar("sf_save_attempts", "0", "Save attempts to a file.").bindTo(saveToFile);
-    cvarManager->registerCvar("sf_change_speed", "0", "Change game speed on consecutive hits/misses.").bindTo(changeSpeed);
-    cvarManager->registerCvar("sf_speed", "1.0", "Current game speed multiplier for training.", true, true, 0.1f, true, 2.0f).bindTo(speed);
-    cvarManager->registerCvar("sf_remember_speed", "1", "Remember last set speed.").bindTo(rememberSpeed);
-    cvarManager->registerCvar("sf_num_hits", "3", "Number of hits/misses for speed change.").bindTo(numHitsChangedSpeed);
-    cvarManager->registerCvar("sf_speed_increment", "0.05", "Speed increment/decrement value.").bindTo(speedIncrement);
+    cvarManager->registerNotifier("sf_draw_calls", [this](std::vector<std::string> args) {
+        LOG("Last frame: {} draw commands, {} canvas calls, {} color changes", lastDrawStats.commands, lastDrawStats.canvasCalls, lastDrawStats.colorChanges);
+        }, "Print the number of canvas calls made by the last rendered frame.", PERMISSION_ALL);
 
-    cvarManager->registerCvar("sf_left_angle", "-30", "Optimal left dodge angle (degrees).").bindTo(optimalLeftAngle);
-    cvarManager->registerCvar("sf_right_angle", "30", "Optimal right dodge angle (degrees).").bindTo(optimalRightAngle);
-    cvarManager->registerCvar("sf_cancel_threshold", "13", "Optimal flip cancel threshold (ticks).").bindTo(flipCancelThreshold);
+    cvarManager->registerNotifier("sf_frame_allocations", [this](std::vector<std::string> args) {
+        if (!AllocationCounter::Enabled) {
+            LOG("Allocation counting is not compiled in, build with SF_COUNT_ALLOCATIONS");
+            return;
+        }
+        LOG("Last frame: {} heap allocations, {} allocating frames after warm-up", lastFrameAllocations, allocatingFrames);
+        }, "Print the heap allocations made by the last rendered frame (SF_COUNT_ALLOCATIONS builds).", PERMISSION_ALL);
 
-    cvarManager->registerCvar("sf_jump_low", "40", "Low threshold for first jump (ticks).").bindTo(jumpLow);
-    cvarManager->registerCvar("sf_jump_high", "90", "High threshold for first jump (ticks).").bindTo(jumpHigh);
+    cvarManager->registerNotifier("sf_latency", [this](std::vector<std::string> args) {
+        if (!Profiling::Enabled) {
+            LOG("Latency profiling is not compiled in, build with SF_ENABLE_PROFILING");
+            return;
+        }
+        if (args.size() > 1 && args[1] == "reset") {
+            for (LatencyHistogram& histogram : latency) histogram.Reset();
+            LOG("Latency histograms reset");
+            return;
+        }
+        for (int i = 0; i < Prof_Count; i++) {
+            LatencySummary summary = latency[i].Summarize();
+            LOG("{}: p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us over {} samples", latency[i].Name(),
+                summary.p50 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0, summary.samples);
+        }
+        }, "Print p50/p99/max latency of each hook and of the render callback over the last seconds. 'sf_latency reset' clears them.", PERMISSION_ALL);
+
+    cvarManager->registerNotifier("sf_trace_dump", [this](std::vector<std::string> args) {
+        if (!Profiling::Enabled) {
+            LOG("Tracing is not compiled in, build with SF_ENABLE_PROFILING");
+            return;
+        }
+        DumpTrace(args.size() > 1 ? std::filesystem::path(args[1]) : std::filesystem::path());
+        }, "Write the recent hook, render, attempt and file events as Chrome trace JSON (chrome://tracing, ui.perfetto.dev). Defaults to the traces folder.", PERMISSION_ALL);
+
+    cvarManager->registerNotifier("sf_convert_attempts", [this](std::vector<std::string> args) {
+        if (args.size() < 2) {
+            LOG("Usage: sf_convert_attempts <file or folder> [sfa|csv]");
+            return;
+        }
+        std::string extension = (args.size() > 2 && args[2] == "csv") ? ".csv" : AttemptFileExtension;
+        ConvertAttempts(args[1], extension);
+        }, "Convert attempt files between .csv and .sfa. A folder converts every attempt inside it.", PERMISSION_ALL);
 
 
     if (gameWrapper) {
+        ioWorkers.SetDispatcher([this](IoWorkerPool::Job job) {
+            gameWrapper->Execute([job = std::move(job)](GameWrapper*) { job(); });
+            });
+
         dataDir = gameWrapper->GetDataFolder() / "SpeedFlipTrainer";
         if (!std::filesystem::exists(dataDir)) {
             std::filesystem::create_directories(dataDir);
@@ -523,7 +427,7 @@ void SpeedFlipTrainer::onLoad() {
         if (std::filesystem::exists(botsPath)) botFileDialog.SetPwd(botsPath); else botFileDialog.SetPwd(dataDir);
 
 
-        if (*enabled) {
+        if (settings.Get()->enabled) {
             if (gameWrapper->IsInCustomTraining()) {
                 // The following line might be the source of E0135 if GetTrainingEditor() is not a member of GameWrapper in your SDK version
                 TrainingEditorWrapper trainingEditor = gameWrapper->GetTrainingEditor();
@@ -533,17 +437,17 @@ void SpeedFlipTrainer::onLoad() {
             }
             gameWrapper->HookEventWithCaller<ActorWrapper>("Function TAGame.GameEvent_TrainingEditor_TA.LoadRound",
                 [this](ActorWrapper cw, void* params, std::string eventName) {
-                    if (*enabled && IsMustysPack(TrainingEditorWrapper(cw.memory_address))) {
+                    if (settings.Get()->enabled && IsMustysPack(TrainingEditorWrapper(cw.memory_address))) {
                         Hook();
                     }
                     else {
-                        onUnload();
+                        Unhook();
                     }
                 });
 
             gameWrapper->HookEventWithCaller<ActorWrapper>("Function TAGame.GameEvent_TrainingEditor_TA.Destroyed",
                 [this](ActorWrapper cw, void* params, std::string eventName) {
-                    if (loaded) onUnload();
+                    if (loaded) Unhook();
                 });
         }
     }
@@ -555,6 +459,21 @@ void SpeedFlipTrainer::onLoad() {
 
 
 void SpeedFlipTrainer::onUnload() {
+    Unhook();
+    settings.Unregister();
+
+    // Pending saves are written, their completions run here instead of on a later tick
+    // that would call into the unloaded plugin, and every queued log line is out
+    ioWorkers.RunRemaining();
+    AsyncLogger::Instance().Stop();
+    logLines.RunPending();
+}
+
+void SpeedFlipTrainer::WriteConsoleLine(LogLevel level, const std::string& line) {
+    if (_globalCvarManager) _globalCvarManager->log(line);
+}
+
+void SpeedFlipTrainer::Unhook() {
     if (!loaded) return;
     loaded = false;
     LOG("Unhooking events and unregistering drawables");
@@ -576,17 +495,11 @@ bool SpeedFlipTrainer::IsMustysPack(TrainingEditorWrapper tw) {
 
 // --- Meter Rendering Functions ---
 
-void SpeedFlipTrainer::RenderPositionMeter(CanvasWrapper canvas, float screenWidth, float screenHeight) {
-    float maxDeviation = 2000.0f;
-    // Ensure Attempt class has 'currentPosition' and 'initialCarLocation' members
-    float currentYDeviation = attempt.currentPosition.Y - attempt.initialCarLocation.Y;
+// Layout builders, only called when the screen size or a threshold changes
 
+static MeterLayout BuildPositionMeterLayout(float screenWidth, float screenHeight) {
     int totalMeterUnits = 400;
     int centerMark = totalMeterUnits / 2;
-    float scale = (maxDeviation * 2) / totalMeterUnits;
-    int meterValue = centerMark + static_cast<int>(currentYDeviation / scale);
-    meterValue = std::max(0, std::min(totalMeterUnits, meterValue));
-
 
     float opacity = 1.0f;
     Vector2 reqSize = { static_cast<int>(screenWidth * 0.7f), static_cast<int>(screenHeight * 0.04f) };
@@ -611,43 +524,15 @@ void SpeedFlipTrainer::RenderPositionMeter(CanvasWrapper canvas, float screenWid
     markings.push_back({ CustomColor(255,255,255,opacity), 1, centerMark + greenZone });
     markings.push_back({ CustomColor(255,255,255,opacity), 1, centerMark - yellowZone });
     markings.push_back({ CustomColor(255,255,255,opacity), 1, centerMark + yellowZone });
-    // markings.push_back({ CustomColor(0,0,0,0.6f), 2, meterValue }); // Current position marker, now handled by RenderMeter's currentValue
-
-    RenderMeter(canvas, startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, false, static_cast<float>(meterValue));
-
-    CVarWrapper speedCvar = _globalCvarManager->getCvar("sv_soccar_gamespeed");
-    if (speedCvar) {
-        float gameSpeed = speedCvar.getFloatValue();
-        std::string speedMsg = fmt::format("Game Speed: {:.0f}%", gameSpeed * 100);
-        Vector2F textSizeF = canvas.GetStringSize(speedMsg); // Returns Vector2F
-        Vector2 textSize = { static_cast<int>(textSizeF.X), static_cast<int>(textSizeF.Y) };
-        canvas.SetColor(255, 255, 255, static_cast<unsigned char>(255 * opacity));
-        canvas.SetPosition(Vector2{ startPos.X + reqSize.X - textSize.X - 5, startPos.Y - textSize.Y - 2 });
-        canvas.DrawString(speedMsg);
-    }
 
-    int textYOffset = reqSize.Y + 5;
-    if (attempt.ticksNotPressingBoost > 0) {
-        std::string boostMsg = fmt::format("No Boost: {}ms", static_cast<int>(attempt.ticksNotPressingBoost / 120.0f * 1000.0f));
-        canvas.SetColor(255, 255, 50, static_cast<unsigned char>(255 * opacity));
-        canvas.SetPosition(Vector2{ startPos.X, startPos.Y + textYOffset });
-        canvas.DrawString(boostMsg);
-        textYOffset += 15;
-    }
-    if (attempt.ticksNotPressingThrottle > 0) {
-        std::string throttleMsg = fmt::format("No Throttle: {}ms", static_cast<int>(attempt.ticksNotPressingThrottle / 120.0f * 1000.0f));
-        canvas.SetColor(255, 255, 50, static_cast<unsigned char>(255 * opacity));
-        canvas.SetPosition(Vector2{ startPos.X, startPos.Y + textYOffset });
-        canvas.DrawString(throttleMsg);
-    }
+    return BuildMeterLayout(startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, false);
 }
 
-
-void SpeedFlipTrainer::RenderFirstJumpMeter(CanvasWrapper canvas, float screenWidth, float screenHeight) {
-    int minTicks = *jumpLow;
-    int maxTicks = *jumpHigh;
+static MeterLayout BuildFirstJumpMeterLayout(const TrainerConfig& config, float screenWidth, float screenHeight) {
+    int minTicks = config.jumpLow;
+    int maxTicks = config.jumpHigh;
     int totalMeterUnits = maxTicks - minTicks;
-    if (totalMeterUnits <= 0) return;
+    if (totalMeterUnits <= 0) return MeterLayout();
 
     int optimalLow = 50 - minTicks;
     int optimalHigh = 60 - minTicks;
@@ -675,35 +560,13 @@ void SpeedFlipTrainer::RenderFirstJumpMeter(CanvasWrapper canvas, float screenWi
     ranges.push_back({ CustomColor(255, 50, 50, 0.7f), 0, std::max(0, optimalLow - yellowBuffer) });
     ranges.push_back({ CustomColor(255, 50, 50, 0.7f), std::min(totalMeterUnits, optimalHigh + yellowBuffer), totalMeterUnits });
 
-    float currentJumpTickRelative = -1.0f;
-    if (attempt.jumped) {
-        currentJumpTickRelative = static_cast<float>(attempt.jumpTick - minTicks);
-        currentJumpTickRelative = std::max(0.0f, std::min(static_cast<float>(totalMeterUnits), currentJumpTickRelative));
-        // Markings list already handles distinct lines, currentValue in RenderMeter handles the main indicator
-    }
-
-    RenderMeter(canvas, startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, true, currentJumpTickRelative);
-
-    std::string label = "First Jump";
-    Vector2F labelSizeF = canvas.GetStringSize(label);
-    Vector2 labelSize = { static_cast<int>(labelSizeF.X), static_cast<int>(labelSizeF.Y) };
-    canvas.SetColor(255, 255, 255, static_cast<unsigned char>(255 * opacity));
-    canvas.SetPosition(Vector2{ startPos.X + reqSize.X / 2 - labelSize.X / 2, startPos.Y + reqSize.Y + 8 });
-    canvas.DrawString(label);
-
-    if (attempt.jumped) {
-        std::string msLabel = fmt::format("{}ms", static_cast<int>(attempt.jumpTick / 120.0f * 1000.0f));
-        Vector2F msLabelSizeF = canvas.GetStringSize(msLabel);
-        Vector2 msLabelSize = { static_cast<int>(msLabelSizeF.X), static_cast<int>(msLabelSizeF.Y) };
-        canvas.SetPosition(Vector2{ startPos.X + reqSize.X / 2 - msLabelSize.X / 2, startPos.Y + reqSize.Y + 8 + 15 });
-        canvas.DrawString(msLabel);
-    }
+    return BuildMeterLayout(startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, true);
 }
 
-void SpeedFlipTrainer::RenderFlipCancelMeter(CanvasWrapper canvas, float screenWidth, float screenHeight) {
+static MeterLayout BuildFlipCancelMeterLayout(const TrainerConfig& config, float screenWidth, float screenHeight) {
     float opacity = 1.0f;
-    int totalMeterUnits = *flipCancelThreshold * 2;
-    int idealCancelPoint = *flipCancelThreshold;
+    int totalMeterUnits = config.flipCancelThreshold * 2;
+    int idealCancelPoint = config.flipCancelThreshold;
 
     Vector2 reqSize = { static_cast<int>(screenWidth * 0.02f), static_cast<int>(screenHeight * 0.55f) };
     Vector2 startPos = { static_cast<int>(screenWidth * 0.75f), static_cast<int>((screenHeight * 0.8f) - reqSize.Y) };
@@ -720,32 +583,10 @@ void SpeedFlipTrainer::RenderFlipCancelMeter(CanvasWrapper canvas, float screenW
     markings.push_back({ CustomColor(200,200,200,opacity), 1, idealCancelPoint });
     markings.push_back({ CustomColor(200,200,200,opacity), 1, static_cast<int>(idealCancelPoint * 1.5f) });
 
-    float currentTicksAfterDodge = -1.0f;
-    if (attempt.flipCanceled) {
-        currentTicksAfterDodge = static_cast<float>(attempt.flipCancelTick - attempt.dodgedTick);
-        currentTicksAfterDodge = std::max(0.0f, std::min(static_cast<float>(totalMeterUnits), currentTicksAfterDodge));
-    }
-
-    RenderMeter(canvas, startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, true, currentTicksAfterDodge);
-
-    std::string label = "Flip Cancel";
-    Vector2F labelSizeF = canvas.GetStringSize(label);
-    Vector2 labelSize = { static_cast<int>(labelSizeF.X), static_cast<int>(labelSizeF.Y) };
-    canvas.SetColor(255, 255, 255, static_cast<unsigned char>(255 * opacity));
-    canvas.SetPosition(Vector2{ startPos.X + reqSize.X / 2 - labelSize.X / 2, startPos.Y + reqSize.Y + 8 });
-    canvas.DrawString(label);
-
-    if (attempt.flipCanceled) {
-        int ticksForCancel = attempt.flipCancelTick - attempt.dodgedTick;
-        std::string msLabel = fmt::format("{}ms", static_cast<int>(ticksForCancel / 120.0f * 1000.0f));
-        Vector2F msLabelSizeF = canvas.GetStringSize(msLabel);
-        Vector2 msLabelSize = { static_cast<int>(msLabelSizeF.X), static_cast<int>(msLabelSizeF.Y) };
-        canvas.SetPosition(Vector2{ startPos.X + reqSize.X / 2 - msLabelSize.X / 2, startPos.Y + reqSize.Y + 8 + 15 });
-        canvas.DrawString(msLabel);
-    }
+    return BuildMeterLayout(startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, true);
 }
 
-void SpeedFlipTrainer::RenderAngleMeter(CanvasWrapper canvas, float screenWidth, float screenHeight) {
+static MeterLayout BuildAngleMeterLayout(const TrainerConfig& config, float screenWidth, float screenHeight) {
     int totalMeterUnits = 180;
     int centerAngle = 90;
 
@@ -762,14 +603,14 @@ void SpeedFlipTrainer::RenderAngleMeter(CanvasWrapper canvas, float screenWidth,
     int greenRangeWidth = 8;
     int yellowRangeWidth = 15;
 
-    int lTargetMeter = *optimalLeftAngle + centerAngle;
+    int lTargetMeter = config.optimalLeftAngle + centerAngle;
     markings.push_back({ CustomColor(200,200,200,opacity), 1, lTargetMeter - greenRangeWidth });
     markings.push_back({ CustomColor(200,200,200,opacity), 1, lTargetMeter + greenRangeWidth });
     ranges.push_back({ CustomColor(50,255,50,0.7f), lTargetMeter - greenRangeWidth, lTargetMeter + greenRangeWidth });
     ranges.push_back({ CustomColor(255,255,50,0.7f), lTargetMeter - yellowRangeWidth, lTargetMeter - greenRangeWidth });
     ranges.push_back({ CustomColor(255,255,50,0.7f), lTargetMeter + greenRangeWidth, lTargetMeter + yellowRangeWidth });
 
-    int rTargetMeter = *optimalRightAngle + centerAngle;
+    int rTargetMeter = config.optimalRightAngle + centerAngle;
     markings.push_back({ CustomColor(200,200,200,opacity), 1, rTargetMeter - greenRangeWidth });
     markings.push_back({ CustomColor(200,200,200,opacity), 1, rTargetMeter + greenRangeWidth });
     ranges.push_back({ CustomColor(50,255,50,0.7f), rTargetMeter - greenRangeWidth, rTargetMeter + greenRangeWidth });
@@ -782,69 +623,311 @@ void SpeedFlipTrainer::RenderAngleMeter(CanvasWrapper canvas, float screenWidth,
         ranges.push_back({ CustomColor(255,50,50,0.7f), lTargetMeter + yellowRangeWidth, rTargetMeter - yellowRangeWidth });
     }
 
+    return BuildMeterLayout(startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, false);
+}
+
+bool SpeedFlipTrainer::UpdateMeterLayouts(const TrainerConfig& config, Vector2 screenSize) {
+    MeterLayoutKey key{ screenSize.X, screenSize.Y, config.optimalLeftAngle, config.optimalRightAngle,
+        config.flipCancelThreshold, config.jumpLow, config.jumpHigh };
+    if (meterLayoutsBuilt && key == meterLayoutKey) return false;
+
+    float screenWidth = static_cast<float>(screenSize.X);
+    float screenHeight = static_cast<float>(screenSize.Y);
+    angleMeterLayout = BuildAngleMeterLayout(config, screenWidth, screenHeight);
+    positionMeterLayout = BuildPositionMeterLayout(screenWidth, screenHeight);
+    flipCancelMeterLayout = BuildFlipCancelMeterLayout(config, screenWidth, screenHeight);
+    firstJumpMeterLayout = BuildFirstJumpMeterLayout(config, screenWidth, screenHeight);
+
+    meterLayoutKey = key;
+    meterLayoutsBuilt = true;
+    return true;
+}
+
+void SpeedFlipTrainer::RenderPositionMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live) {
+    const MeterLayout& layout = positionMeterLayout;
+    Vector2 startPos = layout.startPos;
+    Vector2 reqSize = layout.boxSize;
+
+    float maxDeviation = 2000.0f;
+    float currentYDeviation = live.lateralOffset;
+
+    int totalMeterUnits = layout.totalUnits;
+    int centerMark = totalMeterUnits / 2;
+    float scale = (maxDeviation * 2) / totalMeterUnits;
+    int meterValue = centerMark + static_cast<int>(currentYDeviation / scale);
+    meterValue = std::max(0, std::min(totalMeterUnits, meterValue));
+
+    float opacity = 1.0f;
+    DrawMeterLayout(drawList, layout, static_cast<float>(meterValue));
+
+    FixedString<64> speedMsg("Game Speed: {:.0f}%", config.gameSpeed * 100);
+    Vector2 textSize = MeasureText(canvas, speedMsg.View());
+    drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X - textSize.X - 5, startPos.Y - textSize.Y - 2 }, speedMsg.View());
+
+    int textYOffset = reqSize.Y + 5;
+    if (live.ticksNotPressingBoost > 0) {
+        FixedString<64> boostMsg("No Boost: {}ms", static_cast<int>(live.ticksNotPressingBoost / 120.0f * 1000.0f));
+        drawList.DrawString(CustomColor(255, 255, 50, opacity), Vector2{ startPos.X, startPos.Y + textYOffset }, boostMsg.View());
+        textYOffset += 15;
+    }
+    if (live.ticksNotPressingThrottle > 0) {
+        FixedString<64> throttleMsg("No Throttle: {}ms", static_cast<int>(live.ticksNotPressingThrottle / 120.0f * 1000.0f));
+        drawList.DrawString(CustomColor(255, 255, 50, opacity), Vector2{ startPos.X, startPos.Y + textYOffset }, throttleMsg.View());
+    }
+}
+
+
+void SpeedFlipTrainer::RenderFirstJumpMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live) {
+    const MeterLayout& layout = firstJumpMeterLayout;
+    int totalMeterUnits = layout.totalUnits;
+    if (totalMeterUnits <= 0) return;
+
+    Vector2 startPos = layout.startPos;
+    Vector2 reqSize = layout.boxSize;
+    float opacity = 1.0f;
+
+    float currentJumpTickRelative = -1.0f;
+    if (live.jumped) {
+        currentJumpTickRelative = static_cast<float>(live.jumpTick - config.jumpLow);
+        currentJumpTickRelative = std::max(0.0f, std::min(static_cast<float>(totalMeterUnits), currentJumpTickRelative));
+    }
+
+    DrawMeterLayout(drawList, layout, currentJumpTickRelative);
+
+    std::string_view label = "First Jump";
+    Vector2 labelSize = MeasureText(canvas, label);
+    drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X / 2 - labelSize.X / 2, startPos.Y + reqSize.Y + 8 }, label);
+
+    if (live.jumped) {
+        FixedString<64> msLabel("{}ms", static_cast<int>(live.jumpTick / 120.0f * 1000.0f));
+        Vector2 msLabelSize = MeasureText(canvas, msLabel.View());
+        drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X / 2 - msLabelSize.X / 2, startPos.Y + reqSize.Y + 8 + 15 }, msLabel.View());
+    }
+}
+
+void SpeedFlipTrainer::RenderFlipCancelMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live) {
+    const MeterLayout& layout = flipCancelMeterLayout;
+    int totalMeterUnits = layout.totalUnits;
+    Vector2 startPos = layout.startPos;
+    Vector2 reqSize = layout.boxSize;
+    float opacity = 1.0f;
+
+    float currentTicksAfterDodge = -1.0f;
+    if (live.flipCanceled) {
+        currentTicksAfterDodge = static_cast<float>(live.flipCancelTick - live.dodgedTick);
+        currentTicksAfterDodge = std::max(0.0f, std::min(static_cast<float>(totalMeterUnits), currentTicksAfterDodge));
+    }
+
+    DrawMeterLayout(drawList, layout, currentTicksAfterDodge);
+
+    std::string_view label = "Flip Cancel";
+    Vector2 labelSize = MeasureText(canvas, label);
+    drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X / 2 - labelSize.X / 2, startPos.Y + reqSize.Y + 8 }, label);
+
+    if (live.flipCanceled) {
+        int ticksForCancel = live.flipCancelTick - live.dodgedTick;
+        FixedString<64> msLabel("{}ms", static_cast<int>(ticksForCancel / 120.0f * 1000.0f));
+        Vector2 msLabelSize = MeasureText(canvas, msLabel.View());
+        drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X / 2 - msLabelSize.X / 2, startPos.Y + reqSize.Y + 8 + 15 }, msLabel.View());
+    }
+}
+
+void SpeedFlipTrainer::RenderAngleMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live) {
+    const MeterLayout& layout = angleMeterLayout;
+    int totalMeterUnits = layout.totalUnits;
+    int centerAngle = totalMeterUnits / 2;
+    Vector2 startPos = layout.startPos;
+    Vector2 reqSize = layout.boxSize;
+    float opacity = 1.0f;
+
     float currentAngleMeterValue = -1.0f;
-    if (attempt.dodged) {
-        currentAngleMeterValue = static_cast<float>(attempt.dodgeAngle + centerAngle);
+    if (live.dodged) {
+        currentAngleMeterValue = static_cast<float>(live.dodgeAngle + centerAngle);
         currentAngleMeterValue = std::max(0.0f, std::min(static_cast<float>(totalMeterUnits), currentAngleMeterValue));
     }
 
-    RenderMeter(canvas, startPos, reqSize, baseC, borderS, totalMeterUnits, ranges, markings, false, currentAngleMeterValue);
+    DrawMeterLayout(drawList, layout, currentAngleMeterValue);
 
-    std::string angleText = "Dodge Angle: " + (attempt.dodged ? std::to_string(attempt.dodgeAngle) : "N/A") + " DEG";
-    canvas.SetColor(255, 255, 255, static_cast<unsigned char>(255 * opacity));
-    canvas.SetPosition(Vector2{ startPos.X, startPos.Y - 20 });
-    canvas.DrawString(angleText);
+    FixedString<64> angleText = live.dodged ? FixedString<64>("Dodge Angle: {} DEG", live.dodgeAngle) : FixedString<64>("Dodge Angle: N/A DEG");
+    drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X, startPos.Y - 20 }, angleText.View());
 
-    if (attempt.hit && attempt.ticksToBall > 0) {
-        std::string timeToBallMsg = fmt::format("Time to Ball: {:.3f}s", attempt.timeToBall);
-        Vector2F ttbSizeF = canvas.GetStringSize(timeToBallMsg);
-        Vector2 ttbSize = { static_cast<int>(ttbSizeF.X), static_cast<int>(ttbSizeF.Y) };
-        canvas.SetPosition(Vector2{ startPos.X + reqSize.X / 2 - ttbSize.X / 2, startPos.Y - 20 });
-        canvas.DrawString(timeToBallMsg);
+    if (live.hit && live.ticksToBall > 0) {
+        FixedString<64> timeToBallMsg("Time to Ball: {:.3f}s", live.timeToBall);
+        Vector2 ttbSize = MeasureText(canvas, timeToBallMsg.View());
+        drawList.DrawString(CustomColor(255, 255, 255, opacity), Vector2{ startPos.X + reqSize.X / 2 - ttbSize.X / 2, startPos.Y - 20 }, timeToBallMsg.View());
     }
 
-    // Ensure Attempt class has 'totalDistanceTraveled' member
-    std::string distMsg = fmt::format("Path Length: {:.0f}uu", attempt.totalDistanceTraveled);
-    Vector2F distMsgSizeF = canvas.GetStringSize(distMsg);
-    Vector2 distMsgSize = { static_cast<int>(distMsgSizeF.X), static_cast<int>(distMsgSizeF.Y) };
-    CustomColor distColor = (attempt.totalDistanceTraveled < 2500) ? CustomColor(50, 255, 50, opacity) :
-        (attempt.totalDistanceTraveled < 3500) ? CustomColor(255, 255, 50, opacity) :
+    float pathLength = live.pathLength;
+    FixedString<64> distMsg("Path Length: {:.0f}uu", pathLength);
+    Vector2 distMsgSize = MeasureText(canvas, distMsg.View());
+    CustomColor distColor = (pathLength < 2500) ? CustomColor(50, 255, 50, opacity) :
+        (pathLength < 3500) ? CustomColor(255, 255, 50, opacity) :
         CustomColor(255, 50, 50, opacity);
-    canvas.SetColor(distColor.r, distColor.g, distColor.b, distColor.GetAlphaChar());
-    canvas.SetPosition(Vector2{ startPos.X + reqSize.X - distMsgSize.X - 5, startPos.Y - 20 });
-    canvas.DrawString(distMsg);
+    drawList.DrawString(distColor, Vector2{ startPos.X + reqSize.X - distMsgSize.X - 5, startPos.Y - 20 }, distMsg.View());
 
 
     int warningYOffset = reqSize.Y + 5;
-    if (attempt.startedInAir) {
-        std::string airMsg = "WARNING: Started in air!";
-        canvas.SetColor(255, 10, 10, static_cast<unsigned char>(255 * opacity));
-        canvas.SetPosition(Vector2{ startPos.X, startPos.Y + warningYOffset });
-        canvas.DrawString(airMsg);
+    if (live.startedInAir) {
+        std::string_view airMsg = "WARNING: Started in air!";
+        drawList.DrawString(CustomColor(255, 10, 10, opacity), Vector2{ startPos.X, startPos.Y + warningYOffset }, airMsg);
         warningYOffset += 15;
     }
-    if (attempt.startedNoBoost) {
-        std::string noBoostMsg = "WARNING: Started without boost!";
-        canvas.SetColor(255, 10, 10, static_cast<unsigned char>(255 * opacity));
-        canvas.SetPosition(Vector2{ startPos.X, startPos.Y + warningYOffset });
-        canvas.DrawString(noBoostMsg);
+    if (live.startedNoBoost) {
+        std::string_view noBoostMsg = "WARNING: Started without boost!";
+        drawList.DrawString(CustomColor(255, 10, 10, opacity), Vector2{ startPos.X, startPos.Y + warningYOffset }, noBoostMsg);
     }
 }
 
+void SpeedFlipTrainer::ConvertAttempts(std::filesystem::path path, const std::string& extension) {
+    struct ConvertJob {
+        size_t files = 0;
+        int converted = 0;
+        std::vector<std::string> errors;
+    };
+    auto job = std::make_shared<ConvertJob>();
+
+    auto work = [job, path, extension]() {
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec)) {
+            for (auto& entry : std::filesystem::directory_iterator(path, ec)) {
+                auto ext = entry.path().extension();
+                if (entry.is_regular_file() && (ext == ".csv" || ext == AttemptFileExtension) && ext != extension)
+                    files.push_back(entry.path());
+            }
+        }
+        else {
+            files.push_back(path);
+        }
+
+        job->files = files.size();
+        for (auto& from : files) {
+            auto to = from;
+            to.replace_extension(extension);
+            std::string error;
+            if (Attempt::ConvertFile(from, to, &error)) job->converted++;
+            else job->errors.push_back(fmt::format("Failed to convert {}: {}", from.string(), error));
+        }
+    };
+
+    auto done = [this, job, extension]() {
+        for (auto& error : job->errors) LOG("{}", error);
+        LOG("Converted {} of {} attempt files to {}", job->converted, job->files, extension);
+    };
 
-// --- Bot/Replay Playback ---
-void SpeedFlipTrainer::PlayAttempt(Attempt* att, ControllerInput* ci) {
-    // Ensure Attempt class has 'inputs' member (std::vector or similar with .empty())
-    if (!gameWrapper || att->inputs.empty() || startingPhysicsFrame < 0) return;
-    int tick = gameWrapper->GetEngine().GetPhysicsFrame() - startingPhysicsFrame;
-    att->Play(ci, tick);
-    gameWrapper->OverrideParams(ci, sizeof(ControllerInput));
+    if (!ioWorkers.Submit(work, done)) LOG("Too many file jobs pending, conversion of {} skipped", path.string());
 }
 
-void SpeedFlipTrainer::PlayBot(ControllerInput* ci) {
-    // Ensure BotAttempt class has 'inputs' member
-    if (!gameWrapper || bot.inputs.empty() || startingPhysicsFrame < 0) return;
-    int tick = gameWrapper->GetEngine().GetPhysicsFrame() - startingPhysicsFrame;
-    bot.Play(ci, tick);
-    gameWrapper->OverrideParams(ci, sizeof(ControllerInput));
-}
\ No newline at end of file
+void SpeedFlipTrainer::SaveAttempt(std::shared_ptr<const Attempt> saved, std::filesystem::path path, const std::string& description) {
+    struct SaveJob {
+        std::shared_ptr<const Attempt> attempt;
+        std::string error;
+        bool saved = false;
+    };
+    auto job = std::make_shared<SaveJob>();
+    job->attempt = std::move(saved);
+
+    auto work = [job, path]() {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        job->saved = job->attempt->WriteToFile(path, &job->error);
+    };
+
+    auto done = [this, job, path, description]() {
+        if (job->saved) LOG("Saved {} to: {}", description, path.string());
+        else LOG("Failed to save {} to {}: {}", description, path.string(), job->error);
+    };
+
+    // A full queue means the disk is far behind, writing here beats losing the attempt
+    if (!ioWorkers.Submit(work, done)) {
+        work();
+        done();
+    }
+}
+
+void SpeedFlipTrainer::DumpTrace(std::filesystem::path path) {
+    if (path.empty()) {
+        auto t = time(0);
+        auto now = localtime(&t);
+        path = dataDir / "traces" / fmt::format("{:04}-{:02}-{:02}.{:02}.{:02}.{:02}.json",
+            now->tm_year + 1900, now->tm_mon + 1, now->tm_mday, now->tm_hour, now->tm_min, now->tm_sec);
+    }
+
+    struct DumpJob {
+        TraceSnapshot snapshot;
+        std::string error;
+        bool written = false;
+    };
+    auto job = std::make_shared<DumpJob>();
+    // Copying the rings is quick, formatting and writing happen on a worker
+    job->snapshot = TraceRecorder::Instance().Snapshot();
+
+    auto work = [job, path]() {
+        fmt::memory_buffer json;
+        job->snapshot.FormatJson(json);
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        job->written = WriteWholeFile(path, json.data(), json.size(), &job->error);
+    };
+
+    auto done = [job, path]() {
+        if (job->written) LOG("Wrote {} trace events to: {}", job->snapshot.events.size(), path.string());
+        else LOG("Failed to write trace to {}: {}", path.string(), job->error);
+    };
+
+    if (!ioWorkers.Submit(work, done)) LOG("Too many file jobs pending, try sf_trace_dump again");
+}
+
+void SpeedFlipTrainer::LoadReplayAttempt(std::filesystem::path path) {
+    struct LoadJob {
+        std::shared_ptr<Attempt> attempt = std::make_shared<Attempt>();
+        ParseError error;
+        bool loaded = false;
+    };
+    auto job = std::make_shared<LoadJob>();
+
+    auto work = [job, path]() {
+        job->loaded = job->attempt->ReadInputsFromFile(path, &job->error);
+        if (job->loaded) job->attempt->Compact();
+    };
+
+    auto done = [this, job, path]() {
+        if (!job->loaded) {
+            LOG("Failed to read attempt from file: {0} ({1})", path.string(), job->error.ToString());
+            return;
+        }
+        session.mode = SpeedFlipTrainerMode::Replay;
+        LOG("MODE = Replay");
+        session.replayAttempt = std::move(job->attempt);
+        session.replayCursor.Reset();
+        LOG("Loaded attempt from file: {0}", path.string());
+    };
+
+    if (!ioWorkers.Submit(work, done)) LOG("Too many file jobs pending, try loading {} again", path.string());
+}
+
+void SpeedFlipTrainer::LoadBot(std::filesystem::path path) {
+    struct LoadJob {
+        BotAttempt bot;
+        ParseError error;
+        bool loaded = false;
+    };
+    auto job = std::make_shared<LoadJob>();
+
+    auto work = [job, path]() {
+        job->loaded = job->bot.ReadInputsFromFile(path, &job->error);
+    };
+
+    auto done = [this, job, path]() {
+        if (!job->loaded) {
+            LOG("Failed to read bot from file: {0} ({1})", path.string(), job->error.ToString());
+            return;
+        }
+        session.bot = std::move(job->bot);
+        LOG("Loaded bot from file: {0}", path.string());
+        session.mode = SpeedFlipTrainerMode::Bot;
+        LOG("MODE = Bot");
+    };
+
+    if (!ioWorkers.Submit(work, done)) LOG("Too many file jobs pending, try loading {} again", path.string());
+}
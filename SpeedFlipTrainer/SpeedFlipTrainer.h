@@ -14,7 +14,18 @@
 
 #include "ImGuiFileDialog.h" // Make sure this is the correct header for your ImGuiFileDialog version
 #include "BotAttempt.h"      // Assuming this includes its own necessary headers like <vector>. Ensure BotAttempt has an 'inputs' member.
-#include "Attempt.h"         // Assuming this includes its own necessary headers. Ensure Attempt has members: pathPoints, totalDistanceTraveled, currentPosition, initialCarLocation.
+#include "CarTickSnapshot.h"
+#include "TrainerConfig.h"
+#include "TrainerMath.h"
+#include "Projection.h"
+#include "RenderMeter.h"
+#include "FixedString.h"
+#include "AllocationCounter.h"
+#include "TextMeasureCache.h"
+#include "Attempt.h"
+#include "IoWorkerPool.h"
+#include "LatencyHistogram.h"
+#include "TrainerSession.h"
 
 #include "version.h"
 constexpr auto plugin_version = stringify(VERSION_MAJOR) "." stringify(VERSION_MINOR) "." stringify(VERSION_PATCH) "." stringify(VERSION_BUILD);
@@ -33,117 +44,35 @@ constexpr auto plugin_version = stringify(VERSION_MAJOR) "." stringify(VERSION_M
 #define CONST_PI_F (static_cast<float>(M_PI))
 
 
-// --- Consolidated Structure Definitions ---\
-// Definition for Vector4, necessary for Matrix
-// Ensure 'Vector' is defined (via wrapperstructs.h)
-struct Vector4 {
-    float X, Y, Z, W;
-
-    Vector4() : X(0), Y(0), Z(0), W(1.0f) {}
-    Vector4(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
-    Vector4(const Vector& v, float w = 1.0f) : X(v.X), Y(v.Y), Z(v.Z), W(w) {}
-};
-
-struct Matrix {
-    float M[4][4];
-
-    Matrix() { // Initialize to identity or zero matrix if preferred
-        for (int i = 0; i < 4; ++i)
-            for (int j = 0; j < 4; ++j)
-                M[i][j] = (i == j) ? 1.0f : 0.0f;
-    }
-
-    // Oprateur permettant de multiplier une matrice par un Vector4
-    Vector4 operator*(const Vector4& vec) const {
-        Vector4 result;
-        result.X = M[0][0] * vec.X + M[0][1] * vec.Y + M[0][2] * vec.Z + M[0][3] * vec.W;
-        result.Y = M[1][0] * vec.X + M[1][1] * vec.Y + M[1][2] * vec.Z + M[1][3] * vec.W;
-        result.Z = M[2][0] * vec.X + M[2][1] * vec.Y + M[2][2] * vec.Z + M[2][3] * vec.W;
-        result.W = M[3][0] * vec.X + M[3][1] * vec.Y + M[3][2] * vec.Z + M[3][3] * vec.W;
-        return result;
-    }
-    // Matrix multiplication
-    Matrix operator*(const Matrix& other) const {
-        Matrix result;
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                result.M[i][j] = 0;
-                for (int k = 0; k < 4; ++k) {
-                    result.M[i][j] += M[i][k] * other.M[k][j];
-                }
-            }
-        }
-        return result;
-    }
-};
-
-// Structure for custom colors
-struct CustomColor {
-    unsigned char r, g, b;
-    float a; // Opacity 0.0f to 1.0f
-
-    CustomColor(unsigned char red = 0, unsigned char green = 0, unsigned char blue = 0, float alpha = 1.0f)
-        : r(red), g(green), b(blue), a(alpha) {
-    }
-
-    // Conversion to LinearColor for BakkesMod drawing functions
-    LinearColor ToLinearColor() const {
-        return LinearColor{ static_cast<float>(r) / 255.0f, static_cast<float>(g) / 255.0f, static_cast<float>(b) / 255.0f, a };
+// Everything the meter geometry depends on
+struct MeterLayoutKey {
+    int screenWidth = 0;
+    int screenHeight = 0;
+    int optimalLeftAngle = 0;
+    int optimalRightAngle = 0;
+    int flipCancelThreshold = 0;
+    int jumpLow = 0;
+    int jumpHigh = 0;
+
+    bool operator==(const MeterLayoutKey& o) const {
+        return screenWidth == o.screenWidth && screenHeight == o.screenHeight
+            && optimalLeftAngle == o.optimalLeftAngle && optimalRightAngle == o.optimalRightAngle
+            && flipCancelThreshold == o.flipCancelThreshold && jumpLow == o.jumpLow && jumpHigh == o.jumpHigh;
     }
-    // For CanvasWrapper::SetColor(char, char, char, char)
-    unsigned char GetAlphaChar() const {
-        return static_cast<unsigned char>(a * 255.0f);
-    }
-};
-
-
-// --- Enumrations ---\
-enum class SpeedFlipTrainerMode
-{
-    Replay,
-        Bot,
-        Manual
 };
 
-// --- Dfinition principale de la classe ---\
+// --- Dfinition principale de la classe ---
 class SpeedFlipTrainer : public BakkesMod::Plugin::BakkesModPlugin,
 public BakkesMod::Plugin::PluginSettingsWindow,
 public BakkesMod::Plugin::PluginWindow
 {
 public:
-    struct Orientation {
-        Vector forward;
-        Vector right;
-        Vector up;
-    };
-
-    std::shared_ptr<bool> showCarAxes;
-    std::shared_ptr<float> axisLength;
-    std::shared_ptr<bool> enabled;
-    std::shared_ptr<bool> showAngleMeter;
-    std::shared_ptr<bool> showPositionMeter;
-    std::shared_ptr<bool> showFlipMeter;
-    std::shared_ptr<bool> showJumpMeter;
-    std::shared_ptr<bool> changeSpeed;
-    std::shared_ptr<float> speed;
-    std::shared_ptr<bool> rememberSpeed;
-    std::shared_ptr<int> numHitsChangedSpeed;
-    std::shared_ptr<float> speedIncrement;
-    std::shared_ptr<int> optimalLeftAngle;
-    std::shared_ptr<int> optimalRightAngle;
-    std::shared_ptr<int> flipCancelThreshold;
-    std::shared_ptr<int> jumpLow;
-    std::shared_ptr<int> jumpHigh;
-    std::shared_ptr<bool> saveToFile;
-
-    SpeedFlipTrainer(); // Constructor declaration
-
-    void RenderCarAxes(CanvasWrapper canvas);
-    Orientation RotatorToOrientation(const Rotator& rotation);
-    Vector2 WorldToScreen(CanvasWrapper canvas, Vector location);
-    bool IsPointOnScreen(const Vector2& point, float screenWidth, float screenHeight);
-    void DrawArrow(CanvasWrapper& canvas, Vector2 start, Vector2 end, const CustomColor& color, int thickness = 2);
-    Matrix GetViewProjectionMatrix(CameraWrapper camera);
+    TrainerSettings settings;
+
+    void RenderCarAxes(CanvasWrapper canvas, const TrainerConfig& config, const ProjectionContext& projection);
+    ProjectionContext BeginProjection(CanvasWrapper canvas);
+    void DrawArrow(Vector2 start, Vector2 end, const CustomColor& color, int thickness = 2);
+    Matrix GetViewProjectionMatrix(CameraWrapper camera, Vector2 screenSize);
 
     virtual void onLoad() override;
     virtual void onUnload() override;
@@ -164,29 +93,82 @@ public:
     // Reconsider encapsulation if CustomColor is moved.
     // For now, this is fine as RenderMeter.h includes this file.
 
-        SpeedFlipTrainerMode mode = SpeedFlipTrainerMode::Manual;
         bool loaded = false;
-        float initialTime = 0;
-        int startingPhysicsFrame = -1;
-
-        Attempt attempt;       // Ensure Attempt.h defines members like: inputs, pathPoints, totalDistanceTraveled, currentPosition, initialCarLocation, etc.
-        Attempt replayAttempt;
-        BotAttempt bot;        // Ensure BotAttempt.h defines members like: inputs
 
-        int consecutiveHits = 0;
-        int consecutiveMiss = 0;
+        // Attempt measurement, replay and bot playback, fed by the hooks
+        TrainerSession session;
+        // Attempt that ended at the last Controller.Restart
+        std::shared_ptr<const Attempt> lastAttempt;
 
         void Hook();
+        // Undoes Hook when leaving the training pack, onUnload also stops the workers
+        void Unhook();
         bool IsMustysPack(TrainingEditorWrapper tw);
-        void Measure(CarWrapper car, PriWrapper pri);
-        void PlayBot(ControllerInput* ci);
-        void PlayAttempt(Attempt* a, ControllerInput* ci);
+        // Wrapper calls made by the last SetVehicleInput tick and the most seen so far
+        int lastWrapperCalls = 0;
+        int maxWrapperCalls = 0;
+        bool wrapperBudgetWarned = false;
+
+        void TrackWrapperCalls(int calls, int budget);
+        void ConvertAttempts(std::filesystem::path path, const std::string& extension);
+
+        // File I/O runs on ioWorkers, the results are applied on the game thread
+        IoWorkerPool ioWorkers;
+        // Lines of the AsyncLogger thread, written to the console on the game thread
+        static void WriteConsoleLine(LogLevel level, const std::string& line);
+        LogLineQueue logLines{ &SpeedFlipTrainer::WriteConsoleLine };
+        void SaveAttempt(std::shared_ptr<const Attempt> saved, std::filesystem::path path, const std::string& description);
+        void LoadReplayAttempt(std::filesystem::path path);
+        void LoadBot(std::filesystem::path path);
 
         void RenderMeters(CanvasWrapper canvas);
-        void RenderAngleMeter(CanvasWrapper canvas, float screenWidth, float screenHeight);
-        void RenderFlipCancelMeter(CanvasWrapper canvas, float screenWidth, float screenHeight);
-        void RenderFirstJumpMeter(CanvasWrapper canvas, float screenWidth, float screenHeight);
-        void RenderPositionMeter(CanvasWrapper canvas, float screenWidth, float screenHeight);
+        // Everything drawn in a frame is recorded here and flushed to the canvas at the end of RenderMeters
+        DrawList drawList;
+        DrawListStats lastDrawStats;
+
+        // Heap allocations per rendered frame, only counted with SF_COUNT_ALLOCATIONS
+        static constexpr int AllocationWarmupFrames = 10;
+        uint64_t lastFrameAllocations = 0;
+        uint64_t allocatingFrames = 0;
+        int renderedFrames = 0;
+        bool frameAllocationWarned = false;
+        void TrackFrameAllocations(uint64_t allocations, bool layoutsRebuilt);
+
+        // GetStringSize takes a std::string, the text is copied into this buffer first
+        std::string measureScratch;
+        TextMeasureCache textMeasureCache;
+        Vector2 MeasureText(CanvasWrapper& canvas, std::string_view text);
+        // Both advance pos past the lines they drew
+        void RenderStats(Vector2& pos);
+        void RenderLatency(Vector2& pos);
+
+        // Time spent in each hook and in RenderMeters, recorded with SF_ENABLE_PROFILING.
+        // Each scope is also a trace event, sf_trace_dump writes the recent ones.
+        enum ProfileSection {
+            Prof_SetVehicleInput,
+            Prof_RecordCarHit,
+            Prof_Explode,
+            Prof_Restart,
+            Prof_Render,
+            Prof_Count
+        };
+        LatencyHistogram latency[Prof_Count] = { { "SetVehicleInput" }, { "RecordCarHit" }, { "Explode" }, { "Restart" }, { "RenderMeters" } };
+        void DumpTrace(std::filesystem::path path);
+
+        // Returns true if the layouts were rebuilt
+        bool UpdateMeterLayouts(const TrainerConfig& config, Vector2 screenSize);
+        void RenderAngleMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live);
+        void RenderFlipCancelMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live);
+        void RenderFirstJumpMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live);
+        void RenderPositionMeter(CanvasWrapper canvas, const TrainerConfig& config, const LiveMetrics& live);
+
+        // Meter geometry, rebuilt by UpdateMeterLayouts when meterLayoutKey changes
+        MeterLayoutKey meterLayoutKey;
+        bool meterLayoutsBuilt = false;
+        MeterLayout angleMeterLayout;
+        MeterLayout positionMeterLayout;
+        MeterLayout flipCancelMeterLayout;
+        MeterLayout firstJumpMeterLayout;
 
         bool isWindowOpen_ = false;
         std::string menuTitle_ = "Speedflip Trainer";
@@ -14,19 +14,23 @@ std::string SpeedFlipTrainer::GetPluginName() {
 void SpeedFlipTrainer::RenderSettings() {
 	ImGui::TextUnformatted("A plugin to help give training metrics when learning how to do a speedflip in Musty's training pack: A503-264C-A7EB-D282");
 
-	CVarWrapper enableCvar = cvarManager->getCvar("sf_enabled");
+	CVarWrapper enableCvar = settings.enabledCvar;
 	if (!enableCvar) return;
 
 	// DEBUT
 	ImGui::Separator();
 	ImGui::TextUnformatted("Car Axes Settings");
-	ImGui::Checkbox("Show Car Axes", showCarAxes.get());
+	bool showAxes = settings.showCarAxesCvar.getBoolValue();
+	if (ImGui::Checkbox("Show Car Axes", &showAxes))
+		settings.showCarAxesCvar.setValue(showAxes);
 	if (ImGui::IsItemHovered()) {
 		ImGui::SetTooltip("Display colored axes to help with orientation during aerial maneuvers");
 	}
 
-	if (*showCarAxes) {
-		ImGui::SliderFloat("Axes Length", &axisLength, 50.0f, 300.0f, "%.0f");
+	if (showAxes) {
+		float axisLength = settings.axisLengthCvar.getFloatValue();
+		if (ImGui::SliderFloat("Axes Length", &axisLength, 50.0f, 300.0f, "%.0f"))
+			settings.axisLengthCvar.setValue(axisLength);
 		if (ImGui::IsItemHovered()) {
 			ImGui::SetTooltip("Length of the orientation axes");
 		}
@@ -43,7 +47,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	// ------------------------ ANGLE ----------------------------------
 	ImGui::Separator();
 	{
-		CVarWrapper cvar = cvarManager->getCvar("sf_show_angle");
+		CVarWrapper cvar = settings.showAngleMeterCvar;
 		if (!cvar) return;
 
 		bool value = cvar.getBoolValue();
@@ -54,7 +58,7 @@ void SpeedFlipTrainer::RenderSettings() {
 			ImGui::SetTooltip("Show meter for the dodge angle.");
 	}
 
-	CVarWrapper leftAngleCvar = cvarManager->getCvar("sf_left_angle");
+	CVarWrapper leftAngleCvar = settings.leftAngleCvar;
 	if (!leftAngleCvar) return;
 
 	int leftAngle = leftAngleCvar.getIntValue();
@@ -63,7 +67,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	if (ImGui::IsItemHovered())
 		ImGui::SetTooltip("The optimal angle at which to dodge left.");
 
-	CVarWrapper rightAngleCvar = cvarManager->getCvar("sf_right_angle");
+	CVarWrapper rightAngleCvar = settings.rightAngleCvar;
 	if (!rightAngleCvar) return;
 
 	int rightAngle = rightAngleCvar.getIntValue();
@@ -74,7 +78,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	// ------------------------ FLIP CANCEL ----------------------------------
 	ImGui::Separator();
 	{
-		CVarWrapper cvar = cvarManager->getCvar("sf_show_flip");
+		CVarWrapper cvar = settings.showFlipMeterCvar;
 		if (!cvar) return;
 
 		bool value = cvar.getBoolValue();
@@ -85,7 +89,7 @@ void SpeedFlipTrainer::RenderSettings() {
 			ImGui::SetTooltip("Show meter for the time to flip cancel.");
 	}
 
-	CVarWrapper cancelCvar = cvarManager->getCvar("sf_cancel_threshold");
+	CVarWrapper cancelCvar = settings.cancelThresholdCvar;
 	if (!cancelCvar) return;
 
 	int cancel = cancelCvar.getIntValue();
@@ -98,7 +102,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	// ------------------------ FIRST JUMP ----------------------------------
 	ImGui::Separator();
 	{
-		CVarWrapper cvar = cvarManager->getCvar("sf_show_jump");
+		CVarWrapper cvar = settings.showJumpMeterCvar;
 		if (!cvar) return;
 
 		bool value = cvar.getBoolValue();
@@ -136,7 +140,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	// ------------------------ POSITION ----------------------------------
 	ImGui::Separator();
 	{
-		CVarWrapper cvar = cvarManager->getCvar("sf_show_position");
+		CVarWrapper cvar = settings.showPositionMeterCvar;
 		if (!cvar) return;
 
 		bool value = cvar.getBoolValue();
@@ -149,7 +153,7 @@ void SpeedFlipTrainer::RenderSettings() {
 
 	// ------------------------ SPEED SETTINGS ----------------------------------
 	ImGui::Separator();
-	CVarWrapper changeSpeedCvar = cvarManager->getCvar("sf_change_speed");
+	CVarWrapper changeSpeedCvar = settings.changeSpeedCvar;
 	if (!changeSpeedCvar) return;
 
 	bool changeSpeed = changeSpeedCvar.getBoolValue(); 
@@ -159,7 +163,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	if (ImGui::IsItemHovered())
 		ImGui::SetTooltip("If checked this will alter the game speed on consecutive hits or misses.");
 
-	CVarWrapper remSpeedCvar = cvarManager->getCvar("sf_remember_speed");
+	CVarWrapper remSpeedCvar = settings.rememberSpeedCvar;
 	if (!remSpeedCvar) return;
 
 	bool remSpeed = remSpeedCvar.getBoolValue();
@@ -169,7 +173,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	if (ImGui::IsItemHovered())
 		ImGui::SetTooltip("Remember last game speed achieved on next load of training session.");
 
-	CVarWrapper hitsCvar = cvarManager->getCvar("sf_num_hits");
+	CVarWrapper hitsCvar = settings.numHitsCvar;
 	if (!hitsCvar) return;
 
 	int hit = hitsCvar.getIntValue();
@@ -178,7 +182,7 @@ void SpeedFlipTrainer::RenderSettings() {
 	if (ImGui::IsItemHovered())
 		ImGui::SetTooltip("Number of consecutive hits/misses before speed change.");
 
-	CVarWrapper speedIncCvar = cvarManager->getCvar("sf_speed_increment");
+	CVarWrapper speedIncCvar = settings.speedIncrementCvar;
 	if (!speedIncCvar) return;
 
 	float speedInc = speedIncCvar.getFloatValue();
@@ -199,24 +203,42 @@ void SpeedFlipTrainer::Render()
 		return;
 	}
 
+	// The session belongs to the game thread, every button below changes it from there
 	if (ImGui::Button("Enable manual mode"))
 	{
-		mode = SpeedFlipTrainerMode::Manual;
-		LOG("MODE = Manual");
+		gameWrapper->Execute([this](GameWrapper*) {
+			session.mode = SpeedFlipTrainerMode::Manual;
+			LOG("MODE = Manual");
+		});
 	}
 	ImGui::SameLine();
+	// lastAttempt is replaced on the game thread, the buttons pick it up from there
 	if (ImGui::Button("Save last attempt"))
 	{
-		auto path = attempt.GetFilename(dataDir);
-		attempt.WriteInputsToFile(path);
-		LOG("Saved attempt to: {0}", path.string());
+		gameWrapper->Execute([this](GameWrapper*) {
+			if (!lastAttempt)
+			{
+				LOG("No attempt recorded yet");
+				return;
+			}
+			auto path = lastAttempt->GetFilename(dataDir, settings.Get()->saveBinary ? AttemptFileExtension : ".csv");
+			SaveAttempt(lastAttempt, path, "attempt");
+		});
 	}
 
 	if (ImGui::Button("Replay last attempt"))
 	{
-		mode = SpeedFlipTrainerMode::Replay;
-		LOG("MODE = Replay");
-		replayAttempt = attempt;
+		gameWrapper->Execute([this](GameWrapper*) {
+			if (!lastAttempt)
+			{
+				LOG("No attempt recorded yet");
+				return;
+			}
+			session.mode = SpeedFlipTrainerMode::Replay;
+			LOG("MODE = Replay");
+			session.replayAttempt = lastAttempt;
+			session.replayCursor.Reset();
+		});
 	}
 	ImGui::SameLine();
 	if (ImGui::Button("Load replay attempt"))
@@ -225,52 +247,50 @@ void SpeedFlipTrainer::Render()
 	}
 	if (attemptFileDialog.open && attemptFileDialog.ShowFileDialog(ImGui::FileDialogType::SelectFile))
 	{
-		try 
-		{
-			auto a = Attempt();
-			a.ReadInputsFromFile(attemptFileDialog.selected);
-			mode = SpeedFlipTrainerMode::Replay;
-			LOG("MODE = Replay");
-			replayAttempt = a;
-			LOG("Loaded attempt from file: {0}", attemptFileDialog.selected.string());
-		}
-		catch (...)
-		{
-			LOG("Failed to read attempt from file: {0}", attemptFileDialog.selected.string());
-		}
+		LoadReplayAttempt(attemptFileDialog.selected);
 	}
 
+	// Compile rebuilds the table the input hook plays from, so the bot changes on the game thread
 	if (ImGui::Button("Load -26 Bot"))
 	{
-		bot.Become26Bot();
-		mode = SpeedFlipTrainerMode::Bot;
-		LOG("MODE = Bot");
+		gameWrapper->Execute([this](GameWrapper*) {
+			session.bot.Become26Bot();
+			session.mode = SpeedFlipTrainerMode::Bot;
+			LOG("MODE = Bot");
+		});
 	}
 	ImGui::SameLine();
 	if (ImGui::Button("Load -45 Bot"))
 	{
-		bot.Become45Bot();
-		mode = SpeedFlipTrainerMode::Bot;
-		LOG("MODE = Bot");
+		gameWrapper->Execute([this](GameWrapper*) {
+			session.bot.Become45Bot();
+			session.mode = SpeedFlipTrainerMode::Bot;
+			LOG("MODE = Bot");
+		});
 	}
 	ImGui::SameLine();
 	if (ImGui::Button("Load Bot"))
 	{
 		botFileDialog.open = true;
 	}
+	ImGui::SameLine();
+	if (ImGui::Button("Save bot as attempt"))
+	{
+		// The snapshot is taken where the bot is compiled and played, only the file is written off it
+		gameWrapper->Execute([this](GameWrapper*) {
+			if (session.bot.inputs.empty())
+			{
+				LOG("No bot loaded");
+				return;
+			}
+			auto a = std::make_shared<const Attempt>(session.bot.ToAttempt());
+			auto path = a->GetFilename(dataDir / "attempts", settings.Get()->saveBinary ? AttemptFileExtension : ".csv");
+			SaveAttempt(a, path, "bot as attempt");
+		});
+	}
 	if (botFileDialog.open && botFileDialog.ShowFileDialog(ImGui::FileDialogType::SelectFile))
 	{
-		try
-		{
-			bot.ReadInputsFromFile(botFileDialog.selected);
-			LOG("Loaded bot from file: {0}", botFileDialog.selected.string());
-			mode = SpeedFlipTrainerMode::Bot;
-			LOG("MODE = Bot");
-		}
-		catch (...)
-		{
-			LOG("Failed to read bot from file: {0}", botFileDialog.selected.string());
-		}
+		LoadBot(botFileDialog.selected);
 	}
 
 	ImGui::End();
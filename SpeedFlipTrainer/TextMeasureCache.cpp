@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "TextMeasureCache.h"
+
+#include <cstring>
+
+TextMeasureCache::TextMeasureCache() : entries(Capacity), spare(Capacity)
+{
+	Clear();
+}
+
+void TextMeasureCache::BeginFrame(Vector2 screenSize)
+{
+	frame++;
+	if (screenSize.X != screen.X || screenSize.Y != screen.Y)
+	{
+		Clear();
+		screen = screenSize;
+	}
+}
+
+void TextMeasureCache::Clear()
+{
+	for (Entry& entry : entries)
+		entry.used = false;
+	count = 0;
+}
+
+uint32_t TextMeasureCache::Hash(std::string_view text, float scale)
+{
+	// FNV-1a over the text and the bits of the scale
+	uint32_t hash = 2166136261u;
+	for (char c : text)
+		hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+
+	uint32_t scaleBits;
+	std::memcpy(&scaleBits, &scale, sizeof(scaleBits));
+	return (hash ^ scaleBits) * 16777619u;
+}
+
+bool TextMeasureCache::Find(std::string_view text, float scale, Vector2& size)
+{
+	if (text.size() > MaxTextLength)
+		return false;
+
+	uint32_t hash = Hash(text, scale);
+	for (int i = 0; i < Capacity; i++)
+	{
+		Entry& entry = entries[(hash + i) & (Capacity - 1)];
+		if (!entry.used)
+			return false;
+
+		if (entry.hash == hash && entry.scale == scale && entry.length == text.size()
+			&& std::memcmp(entry.text, text.data(), text.size()) == 0)
+		{
+			entry.lastUsedFrame = frame;
+			size = entry.size;
+			return true;
+		}
+	}
+	return false;
+}
+
+void TextMeasureCache::Insert(std::string_view text, float scale, Vector2 size)
+{
+	if (text.size() > MaxTextLength)
+		return;
+
+	// Linear probing needs free slots to stay fast
+	if (count >= Capacity * 3 / 4)
+		Evict();
+
+	Entry entry;
+	entry.used = true;
+	entry.length = static_cast<uint8_t>(text.size());
+	entry.hash = Hash(text, scale);
+	entry.lastUsedFrame = frame;
+	entry.scale = scale;
+	entry.size = size;
+	std::memcpy(entry.text, text.data(), text.size());
+	Place(entry);
+}
+
+void TextMeasureCache::Place(const Entry& entry)
+{
+	for (int i = 0; i < Capacity; i++)
+	{
+		Entry& slot = entries[(entry.hash + i) & (Capacity - 1)];
+		if (!slot.used)
+		{
+			slot = entry;
+			count++;
+			return;
+		}
+	}
+}
+
+void TextMeasureCache::Evict()
+{
+	// Keeps what the last two frames used, labels drawn every frame survive.
+	// Removing from a linear probing table breaks probe chains, so the survivors are reinserted.
+	entries.swap(spare);
+	Clear();
+	for (const Entry& entry : spare)
+	{
+		if (entry.used && entry.lastUsedFrame + 1 >= frame)
+			Place(entry);
+	}
+
+	// Nothing old enough to drop, start over
+	if (count >= Capacity * 3 / 4)
+		Clear();
+}
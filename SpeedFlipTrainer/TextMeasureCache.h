@@ -0,0 +1,71 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Sizes of text measured with CanvasWrapper::GetStringSize, keyed by the text and its scale.
+// The rendered font follows the resolution, so every entry is dropped when the canvas
+// size changes. Labels drawn every frame are measured once and then only looked up.
+// The table has a fixed size and never allocates after construction.
+class TextMeasureCache
+{
+public:
+	static constexpr int Capacity = 128; // Power of two
+	static constexpr int MaxTextLength = 47; // Longer text is measured every time
+
+	TextMeasureCache();
+
+	// Call once per frame before measuring
+	void BeginFrame(Vector2 screenSize);
+
+	// Returns the cached size of text, or calls measure() and caches its result
+	template <typename Measure>
+	Vector2 Get(std::string_view text, float scale, Measure measure)
+	{
+		Vector2 size;
+		if (Find(text, scale, size))
+		{
+			hits++;
+			return size;
+		}
+		misses++;
+		size = measure();
+		Insert(text, scale, size);
+		return size;
+	}
+
+	void Clear();
+
+	uint64_t Hits() const { return hits; }
+	uint64_t Misses() const { return misses; }
+	int Size() const { return count; }
+
+private:
+	struct Entry
+	{
+		bool used;
+		uint8_t length;
+		uint32_t hash;
+		uint32_t lastUsedFrame;
+		float scale;
+		Vector2 size;
+		char text[MaxTextLength];
+	};
+
+	static uint32_t Hash(std::string_view text, float scale);
+	bool Find(std::string_view text, float scale, Vector2& size);
+	void Insert(std::string_view text, float scale, Vector2 size);
+	void Place(const Entry& entry);
+	void Evict();
+
+	std::vector<Entry> entries;
+	std::vector<Entry> spare; // Rehash target for Evict
+	int count = 0;
+	uint32_t frame = 0;
+	Vector2 screen{ 0, 0 };
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+};
@@ -0,0 +1,171 @@
+#include "pch.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+
+namespace
+{
+	std::atomic<uint64_t> nextInstance{ 1 };
+
+	struct ThreadCache
+	{
+		uint64_t instance = 0;
+		void* buffer = nullptr;
+	};
+	thread_local ThreadCache threadCache;
+}
+
+TraceRecorder& TraceRecorder::Instance()
+{
+	static TraceRecorder recorder;
+	return recorder;
+}
+
+TraceRecorder::TraceRecorder() : epoch(Clock::now()), instance(nextInstance.fetch_add(1))
+{
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder::ThreadBuffer* TraceRecorder::CurrentThread()
+{
+	if (threadCache.instance == instance)
+		return static_cast<ThreadBuffer*>(threadCache.buffer);
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+	uint32_t count = bufferCount.load(std::memory_order_relaxed);
+	ThreadBuffer* buffer = nullptr;
+	if (count < MaxThreads)
+	{
+		buffers[count] = std::make_unique<ThreadBuffer>();
+		buffer = buffers[count].get();
+		buffer->id = count + 1;
+		bufferCount.store(count + 1, std::memory_order_release);
+	}
+
+	// Threads past MaxThreads cache nullptr and stay unrecorded
+	threadCache.instance = instance;
+	threadCache.buffer = buffer;
+	return buffer;
+}
+
+int64_t TraceRecorder::Since(Clock::time_point time) const
+{
+	// A scope may have started just before the recorder was created
+	return std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count());
+}
+
+void TraceRecorder::NameThread(const char* name)
+{
+	if (ThreadBuffer* buffer = CurrentThread())
+		buffer->name.store(name, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Complete(const char* name, Clock::time_point start, Clock::time_point end)
+{
+	Write(name, nullptr, 0, Since(start), std::max<int64_t>(0, Since(end) - Since(start)));
+}
+
+void TraceRecorder::Instant(const char* name, const char* argName, int64_t arg)
+{
+	Write(name, argName, arg, Since(Clock::now()), -1);
+}
+
+void TraceRecorder::Write(const char* name, const char* argName, int64_t arg, int64_t start, int64_t duration)
+{
+	ThreadBuffer* buffer = CurrentThread();
+	if (!buffer)
+		return;
+
+	// Only this thread writes to the buffer, a plain seqlock keeps readers from using torn slots
+	uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	Slot& slot = buffer->slots[index & (EventsPerThread - 1)];
+	slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.argName.store(argName, std::memory_order_relaxed);
+	slot.arg.store(arg, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.duration.store(duration, std::memory_order_relaxed);
+
+	slot.sequence.store(2 * index + 2, std::memory_order_release);
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+TraceSnapshot TraceRecorder::Snapshot() const
+{
+	TraceSnapshot snapshot;
+
+	uint32_t count = bufferCount.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const ThreadBuffer& buffer = *buffers[i];
+		snapshot.threads.push_back(TraceThread{ buffer.id, buffer.name.load(std::memory_order_relaxed) });
+
+		uint64_t written = buffer.written.load(std::memory_order_acquire);
+		uint64_t first = written > EventsPerThread ? written - EventsPerThread : 0;
+		for (uint64_t index = first; index < written; index++)
+		{
+			const Slot& slot = buffer.slots[index & (EventsPerThread - 1)];
+			uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence != 2 * index + 2)
+				continue; // Overwritten since written was read
+
+			TraceEvent event;
+			event.name = slot.name.load(std::memory_order_relaxed);
+			event.argName = slot.argName.load(std::memory_order_relaxed);
+			event.arg = slot.arg.load(std::memory_order_relaxed);
+			event.start = slot.start.load(std::memory_order_relaxed);
+			event.duration = slot.duration.load(std::memory_order_relaxed);
+			event.thread = buffer.id;
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+				continue;
+			snapshot.events.push_back(event);
+		}
+	}
+
+	std::stable_sort(snapshot.events.begin(), snapshot.events.end(),
+		[](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; });
+	return snapshot;
+}
+
+void TraceSnapshot::FormatJson(fmt::memory_buffer& out) const
+{
+	// Names are string literals from the call sites, they need no escaping
+	fmt::format_to(out, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+	bool first = true;
+	auto separate = [&]() {
+		if (!first)
+			fmt::format_to(out, ",\n");
+		first = false;
+	};
+
+	for (const TraceThread& thread : threads)
+	{
+		separate();
+		if (thread.name)
+			fmt::format_to(out, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", thread.id, thread.name);
+		else
+			fmt::format_to(out, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"Thread {}\"}}}}", thread.id, thread.id);
+	}
+
+	// Timestamps are in microseconds, three decimals keep the nanoseconds
+	for (const TraceEvent& event : events)
+	{
+		separate();
+		fmt::format_to(out, "{{\"name\":\"{}\",\"cat\":\"sf\",\"pid\":1,\"tid\":{},\"ts\":{}.{:03}", event.name, event.thread, event.start / 1000, event.start % 1000);
+		if (event.duration >= 0)
+			fmt::format_to(out, ",\"ph\":\"X\",\"dur\":{}.{:03}", event.duration / 1000, event.duration % 1000);
+		else
+			fmt::format_to(out, ",\"ph\":\"i\",\"s\":\"t\"");
+		if (event.argName)
+			fmt::format_to(out, ",\"args\":{{\"{}\":{}}}", event.argName, event.arg);
+		fmt::format_to(out, "}}");
+	}
+
+	fmt::format_to(out, "\n]}}\n");
+}
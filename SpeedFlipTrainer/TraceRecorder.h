@@ -0,0 +1,125 @@
+#pragma once
+
+#include "fmt/format.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TraceEvent
+{
+	const char* name = nullptr;    // String literal
+	const char* argName = nullptr; // String literal, nullptr without an argument
+	int64_t arg = 0;
+	int64_t start = 0;             // Nanoseconds since the recorder was created
+	int64_t duration = -1;         // Negative for instant events
+	uint32_t thread = 0;
+};
+
+struct TraceThread
+{
+	uint32_t id = 0;
+	const char* name = nullptr;
+};
+
+// Events of every thread at one point in time, ordered by start
+struct TraceSnapshot
+{
+	std::vector<TraceEvent> events;
+	std::vector<TraceThread> threads;
+
+	// Chrome trace-event JSON, opens in chrome://tracing and ui.perfetto.dev
+	void FormatJson(fmt::memory_buffer& out) const;
+};
+
+// Keeps the most recent events of each thread for sf_trace_dump. Every thread writes to its
+// own ring, created on its first event, so recording takes no lock: a few relaxed stores
+// guarded by a per-slot sequence number. Old events are overwritten, a ring holds the last
+// EventsPerThread. Snapshot can run on any thread and skips slots that are being written.
+// Only used with SF_ENABLE_PROFILING, through the SF_TRACE macros.
+class TraceRecorder
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr size_t EventsPerThread = 8192; // Power of two
+	static constexpr uint32_t MaxThreads = 16;      // Later threads are not recorded
+
+	static TraceRecorder& Instance();
+
+	TraceRecorder();
+	~TraceRecorder();
+
+	TraceRecorder(const TraceRecorder&) = delete;
+	TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+	// Name shown for the calling thread, a string literal
+	void NameThread(const char* name);
+
+	void Complete(const char* name, Clock::time_point start, Clock::time_point end);
+	void Instant(const char* name, const char* argName = nullptr, int64_t arg = 0);
+
+	TraceSnapshot Snapshot() const;
+
+private:
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence{ 0 }; // Odd while written, 2 * (index + 1) once done
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<const char*> argName{ nullptr };
+		std::atomic<int64_t> arg{ 0 };
+		std::atomic<int64_t> start{ 0 };
+		std::atomic<int64_t> duration{ 0 };
+	};
+
+	struct ThreadBuffer
+	{
+		uint32_t id = 0;
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<uint64_t> written{ 0 };
+		Slot slots[EventsPerThread];
+	};
+
+	ThreadBuffer* CurrentThread();
+	void Write(const char* name, const char* argName, int64_t arg, int64_t start, int64_t duration);
+	int64_t Since(Clock::time_point time) const;
+
+	const Clock::time_point epoch;
+	const uint64_t instance; // Tells the thread local buffer cache which recorder it belongs to
+
+	mutable std::mutex registerMutex;
+	std::unique_ptr<ThreadBuffer> buffers[MaxThreads];
+	std::atomic<uint32_t> bufferCount{ 0 };
+};
+
+// Records the time until the end of the enclosing scope as a complete event
+class TraceScope
+{
+public:
+	explicit TraceScope(const char* name) : name(name), start(TraceRecorder::Clock::now()) {}
+	~TraceScope() { TraceRecorder::Instance().Complete(name, start, TraceRecorder::Clock::now()); }
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name;
+	TraceRecorder::Clock::time_point start;
+};
+
+#define SF_TRACE_CONCAT_INNER(a, b) a##b
+#define SF_TRACE_CONCAT(a, b) SF_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SF_ENABLE_PROFILING
+#define SF_TRACE_SCOPE(name) TraceScope SF_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define SF_TRACE_INSTANT(name, ...) TraceRecorder::Instance().Instant(name, ##__VA_ARGS__)
+#define SF_TRACE_THREAD_NAME(name) TraceRecorder::Instance().NameThread(name)
+#else
+#define SF_TRACE_SCOPE(name) ((void)0)
+#define SF_TRACE_INSTANT(name, ...) ((void)0)
+#define SF_TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "TrainerConfig.h"
+
+static bool ReadValue(CVarWrapper& cvar, bool*) { return cvar.getBoolValue(); }
+static int ReadValue(CVarWrapper& cvar, int*) { return cvar.getIntValue(); }
+static float ReadValue(CVarWrapper& cvar, float*) { return cvar.getFloatValue(); }
+
+TrainerSettings::TrainerSettings() : current(std::make_shared<const TrainerConfig>())
+{
+}
+
+void TrainerSettings::Register(CVarManagerWrapper& cvarManager)
+{
+	enabledCvar = cvarManager.registerCvar("sf_enabled", "1", "Enable Speedflip trainer plugin.", true, true, 0, true, 1);
+	showCarAxesCvar = cvarManager.registerCvar("sf_show_axes", "1", "Show car orientation axes.", true, true, 0, true, 1);
+	axisLengthCvar = cvarManager.registerCvar("sf_axis_length", "150.0", "Length of car orientation axes.", true, true, 50.0f, true, 500.0f);
+
+	showAngleMeterCvar = cvarManager.registerCvar("sf_show_angle", "1", "Show dodge angle meter.");
+	showPositionMeterCvar = cvarManager.registerCvar("sf_show_position", "1", "Show horizontal position meter.");
+	showJumpMeterCvar = cvarManager.registerCvar("sf_show_jump", "1", "Show first jump timing meter.");
+	showFlipMeterCvar = cvarManager.registerCvar("sf_show_flip", "1", "Show flip cancel timing meter.");
+
+	saveToFileCvar = cvarManager.registerCvar("sf_save_attempts", "0", "Save attempts to a file.");
+	saveBinaryCvar = cvarManager.registerCvar("sf_save_binary", "0", "Save attempts in the binary .sfa format instead of .csv.");
+	changeSpeedCvar = cvarManager.registerCvar("sf_change_speed", "0", "Change game speed on consecutive hits/misses.");
+	speedCvar = cvarManager.registerCvar("sf_speed", "1.0", "Current game speed multiplier for training.", true, true, 0.1f, true, 2.0f);
+	rememberSpeedCvar = cvarManager.registerCvar("sf_remember_speed", "1", "Remember last set speed.");
+	numHitsCvar = cvarManager.registerCvar("sf_num_hits", "3", "Number of hits/misses for speed change.");
+	speedIncrementCvar = cvarManager.registerCvar("sf_speed_increment", "0.05", "Speed increment/decrement value.");
+
+	leftAngleCvar = cvarManager.registerCvar("sf_left_angle", "-30", "Optimal left dodge angle (degrees).");
+	rightAngleCvar = cvarManager.registerCvar("sf_right_angle", "30", "Optimal right dodge angle (degrees).");
+	cancelThresholdCvar = cvarManager.registerCvar("sf_cancel_threshold", "13", "Optimal flip cancel threshold (ticks).");
+
+	jumpLowCvar = cvarManager.registerCvar("sf_jump_low", "40", "Low threshold for first jump (ticks).");
+	jumpHighCvar = cvarManager.registerCvar("sf_jump_high", "90", "High threshold for first jump (ticks).");
+
+	showStatsCvar = cvarManager.registerCvar("sf_show_stats", "0", "Show render and cache statistics.");
+	showLatencyCvar = cvarManager.registerCvar("sf_show_latency", "0", "Show hook and render latencies (SF_ENABLE_PROFILING builds).");
+	capturePhysicsCvar = cvarManager.registerCvar("sf_capture_physics", "0", "Record car physics with each attempt (saved in .sfa files).");
+
+	Bind(enabledCvar, &TrainerConfig::enabled);
+	Bind(showCarAxesCvar, &TrainerConfig::showCarAxes);
+	Bind(axisLengthCvar, &TrainerConfig::axisLength);
+	Bind(showAngleMeterCvar, &TrainerConfig::showAngleMeter);
+	Bind(showPositionMeterCvar, &TrainerConfig::showPositionMeter);
+	Bind(showJumpMeterCvar, &TrainerConfig::showJumpMeter);
+	Bind(showFlipMeterCvar, &TrainerConfig::showFlipMeter);
+	Bind(saveToFileCvar, &TrainerConfig::saveToFile);
+	Bind(saveBinaryCvar, &TrainerConfig::saveBinary);
+	Bind(changeSpeedCvar, &TrainerConfig::changeSpeed);
+	Bind(speedCvar, &TrainerConfig::speed);
+	Bind(rememberSpeedCvar, &TrainerConfig::rememberSpeed);
+	Bind(numHitsCvar, &TrainerConfig::numHitsChangedSpeed);
+	Bind(speedIncrementCvar, &TrainerConfig::speedIncrement);
+	Bind(leftAngleCvar, &TrainerConfig::optimalLeftAngle);
+	Bind(rightAngleCvar, &TrainerConfig::optimalRightAngle);
+	Bind(cancelThresholdCvar, &TrainerConfig::flipCancelThreshold);
+	Bind(jumpLowCvar, &TrainerConfig::jumpLow);
+	Bind(jumpHighCvar, &TrainerConfig::jumpHigh);
+	Bind(showStatsCvar, &TrainerConfig::showStats);
+	Bind(showLatencyCvar, &TrainerConfig::showLatency);
+	Bind(capturePhysicsCvar, &TrainerConfig::capturePhysics);
+
+	// Registering again must not leave a second listener on the game's cvar
+	Unregister();
+	gameSpeedCvar = cvarManager.getCvar("sv_soccar_gamespeed");
+	if (!gameSpeedCvar)
+		return;
+
+	Update(&TrainerConfig::gameSpeed, gameSpeedCvar.getFloatValue());
+	gameSpeedCvar.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		float value = cvar.getFloatValue();
+		Update(&TrainerConfig::gameSpeed, value);
+
+		// sf_speed follows the game speed instead of polling it every tick
+		if (Get()->rememberSpeed && speedCvar)
+			speedCvar.setValue(value);
+	});
+}
+
+void TrainerSettings::Unregister()
+{
+	// The trainer cvars go away with the plugin, sv_soccar_gamespeed belongs to the game
+	// and would keep calling a listener that captured this
+	if (gameSpeedCvar)
+		gameSpeedCvar.removeOnValueChanged();
+	gameSpeedCvar = CVarWrapper{ 0 };
+}
+
+std::shared_ptr<const TrainerConfig> TrainerSettings::Get() const
+{
+	return std::atomic_load(&current);
+}
+
+template <typename T>
+void TrainerSettings::Bind(CVarWrapper& cvar, T TrainerConfig::* field)
+{
+	if (!cvar)
+		return;
+
+	Update(field, ReadValue(cvar, static_cast<T*>(nullptr)));
+	cvar.addOnValueChanged([this, field](std::string oldValue, CVarWrapper changed) {
+		Update(field, ReadValue(changed, static_cast<T*>(nullptr)));
+	});
+}
+
+template <typename T>
+void TrainerSettings::Update(T TrainerConfig::* field, T value)
+{
+	auto config = std::make_shared<TrainerConfig>(*Get());
+	config.get()->*field = value;
+	Publish(std::move(config));
+}
+
+void TrainerSettings::Publish(std::shared_ptr<const TrainerConfig> config)
+{
+	std::atomic_store(&current, std::move(config));
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include <memory>
+
+// Every trainer setting as a plain field. A published config is never modified,
+// so hook and render code can read it without cvar lookups or locks.
+struct TrainerConfig
+{
+	bool enabled = true;
+
+	bool showCarAxes = true;
+	float axisLength = 150.0f;
+
+	bool showAngleMeter = true;
+	bool showPositionMeter = true;
+	bool showFlipMeter = true;
+	bool showJumpMeter = true;
+
+	bool saveToFile = false;
+	bool saveBinary = false;
+
+	bool changeSpeed = false;
+	float speed = 1.0f;
+	bool rememberSpeed = true;
+	int numHitsChangedSpeed = 3;
+	float speedIncrement = 0.05f;
+
+	int optimalLeftAngle = -30;
+	int optimalRightAngle = 30;
+	int flipCancelThreshold = 13;
+
+	int jumpLow = 40;
+	int jumpHigh = 90;
+
+	// Draw calls, text cache and allocation counters in the top left corner
+	bool showStats = false;
+	bool showLatency = false;
+
+	// Record the full car state each tick, saved along the inputs in .sfa files
+	bool capturePhysics = false;
+
+	// Mirror of sv_soccar_gamespeed
+	float gameSpeed = 1.0f;
+};
+
+// Registers the trainer cvars once and keeps their handles. Whenever one of them
+// changes a new TrainerConfig is built and swapped in atomically.
+class TrainerSettings
+{
+public:
+	TrainerSettings();
+
+	void Register(CVarManagerWrapper& cvarManager);
+	// Removes the listener on sv_soccar_gamespeed, call it when the plugin unloads
+	void Unregister();
+
+	// Keep the returned pointer for a whole tick or frame so every read sees the same config
+	std::shared_ptr<const TrainerConfig> Get() const;
+
+	// Handles resolved in Register, the GUI and the speed logic write through these
+	CVarWrapper enabledCvar{ 0 };
+	CVarWrapper showCarAxesCvar{ 0 };
+	CVarWrapper axisLengthCvar{ 0 };
+	CVarWrapper showAngleMeterCvar{ 0 };
+	CVarWrapper showPositionMeterCvar{ 0 };
+	CVarWrapper showFlipMeterCvar{ 0 };
+	CVarWrapper showJumpMeterCvar{ 0 };
+	CVarWrapper saveToFileCvar{ 0 };
+	CVarWrapper saveBinaryCvar{ 0 };
+	CVarWrapper changeSpeedCvar{ 0 };
+	CVarWrapper speedCvar{ 0 };
+	CVarWrapper rememberSpeedCvar{ 0 };
+	CVarWrapper numHitsCvar{ 0 };
+	CVarWrapper speedIncrementCvar{ 0 };
+	CVarWrapper leftAngleCvar{ 0 };
+	CVarWrapper rightAngleCvar{ 0 };
+	CVarWrapper cancelThresholdCvar{ 0 };
+	CVarWrapper jumpLowCvar{ 0 };
+	CVarWrapper jumpHighCvar{ 0 };
+	CVarWrapper showStatsCvar{ 0 };
+	CVarWrapper showLatencyCvar{ 0 };
+	CVarWrapper capturePhysicsCvar{ 0 };
+	CVarWrapper gameSpeedCvar{ 0 };
+
+private:
+	template <typename T>
+	void Bind(CVarWrapper& cvar, T TrainerConfig::* field);
+
+	template <typename T>
+	void Update(T TrainerConfig::* field, T value);
+
+	void Publish(std::shared_ptr<const TrainerConfig> config);
+
+	std::shared_ptr<const TrainerConfig> current;
+};
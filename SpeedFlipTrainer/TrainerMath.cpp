@@ -0,0 +1,239 @@
+#include "pch.h"
+#include "TrainerMath.h"
+
+#include <cmath>
+
+#ifdef SF_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+static constexpr float Pi = 3.14159265358979323846f;
+
+Matrix::Matrix()
+{
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			M[i][j] = (i == j) ? 1.0f : 0.0f;
+}
+
+// Both SSE paths add the products in the same order as the scalar code,
+// so results are bit-identical to it.
+
+Vector4 Matrix::operator*(const Vector4& vec) const
+{
+	Vector4 result;
+#ifdef SF_MATH_SSE
+	__m128 c0 = _mm_loadu_ps(M[0]);
+	__m128 c1 = _mm_loadu_ps(M[1]);
+	__m128 c2 = _mm_loadu_ps(M[2]);
+	__m128 c3 = _mm_loadu_ps(M[3]);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	__m128 v = _mm_mul_ps(c0, _mm_set1_ps(vec.X));
+	v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(vec.Y)));
+	v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(vec.Z)));
+	v = _mm_add_ps(v, _mm_mul_ps(c3, _mm_set1_ps(vec.W)));
+	_mm_storeu_ps(&result.X, v);
+#else
+	result.X = M[0][0] * vec.X + M[0][1] * vec.Y + M[0][2] * vec.Z + M[0][3] * vec.W;
+	result.Y = M[1][0] * vec.X + M[1][1] * vec.Y + M[1][2] * vec.Z + M[1][3] * vec.W;
+	result.Z = M[2][0] * vec.X + M[2][1] * vec.Y + M[2][2] * vec.Z + M[2][3] * vec.W;
+	result.W = M[3][0] * vec.X + M[3][1] * vec.Y + M[3][2] * vec.Z + M[3][3] * vec.W;
+#endif
+	return result;
+}
+
+Matrix Matrix::operator*(const Matrix& other) const
+{
+	Matrix result;
+#ifdef SF_MATH_SSE
+	__m128 b0 = _mm_loadu_ps(other.M[0]);
+	__m128 b1 = _mm_loadu_ps(other.M[1]);
+	__m128 b2 = _mm_loadu_ps(other.M[2]);
+	__m128 b3 = _mm_loadu_ps(other.M[3]);
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128 row = _mm_mul_ps(_mm_set1_ps(M[i][0]), b0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(M[i][1]), b1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(M[i][2]), b2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(M[i][3]), b3));
+		_mm_storeu_ps(result.M[i], row);
+	}
+#else
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			result.M[i][j] = 0;
+			for (int k = 0; k < 4; ++k)
+				result.M[i][j] += M[i][k] * other.M[k][j];
+		}
+	}
+#endif
+	return result;
+}
+
+// Sine table with one entry every 64 units. The remaining 0-63 units (< 0.0062 rad) are
+// applied with the angle sum identity, their sin/cos need only the first series terms.
+static constexpr int TableBits = 10;
+static constexpr int TableSize = 1 << TableBits;
+static constexpr int UnitsPerEntry = 65536 / TableSize;
+static constexpr double TablePi = 3.14159265358979323846;
+
+// Built at compile time, sin of 0..pi/2 by its series then mirrored into the other quadrants
+static constexpr double ConstexprSin(double x)
+{
+	double term = x;
+	double sum = x;
+	for (int n = 1; n < 12; n++)
+	{
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+struct SinTable
+{
+	float values[TableSize];
+
+	constexpr SinTable() : values()
+	{
+		const int quarter = TableSize / 4;
+		for (int i = 0; i < TableSize; i++)
+		{
+			int q = i / quarter;
+			int r = i % quarter;
+			double a = (q % 2 == 0 ? r : quarter - r) * (2 * TablePi / TableSize);
+			double v = ConstexprSin(a);
+			values[i] = static_cast<float>(q < 2 ? v : -v);
+		}
+	}
+};
+
+static constexpr SinTable Table;
+
+void RotatorSinCos(int units, float& sin, float& cos)
+{
+	// The angle is periodic in 65536 units, so wrapping the unsigned value is exact
+	unsigned int angle = static_cast<unsigned int>(units);
+	unsigned int index = (angle / UnitsPerEntry) & (TableSize - 1);
+	float sa = Table.values[index];
+	float ca = Table.values[(index + TableSize / 4) & (TableSize - 1)];
+
+	float b = static_cast<float>(angle % UnitsPerEntry) * (Pi / 32768.0f);
+	float b2 = b * b;
+	float sb = b * (1.0f - b2 * (1.0f / 6));
+	float cb = 1.0f - b2 * 0.5f;
+
+	sin = sa * cb + ca * sb;
+	cos = ca * cb - sa * sb;
+}
+
+float RotatorSin(int units)
+{
+	float s, c;
+	RotatorSinCos(units, s, c);
+	return s;
+}
+
+float RotatorCos(int units)
+{
+	float s, c;
+	RotatorSinCos(units, s, c);
+	return c;
+}
+
+Orientation RotatorToOrientation(const Rotator& rotation)
+{
+	Orientation result;
+
+	float sp, cp, sy, cy, sr, cr;
+	RotatorSinCos(rotation.Pitch, sp, cp);
+	RotatorSinCos(rotation.Yaw, sy, cy);
+	RotatorSinCos(rotation.Roll, sr, cr);
+
+	result.forward.X = cp * cy;
+	result.forward.Y = cp * sy;
+	result.forward.Z = sp;
+
+	// Rows of Unreal's FRotationMatrix, right is +Y at zero rotation
+	result.right.X = sr * sp * cy - cr * sy;
+	result.right.Y = sr * sp * sy + cr * cy;
+	result.right.Z = -sr * cp;
+
+	result.up.X = -(cr * sp * cy + sr * sy);
+	result.up.Y = cy * sr - cr * sp * sy;
+	result.up.Z = cr * cp;
+
+	return result;
+}
+
+void TransformPoints(const Matrix& m, const Vector* points, int count, Vector4* out)
+{
+	int i = 0;
+
+#ifdef SF_MATH_SSE
+	__m128 row[4][4];
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 4; c++)
+			row[r][c] = _mm_set1_ps(m.M[r][c]);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const Vector* p = points + i;
+		__m128 x = _mm_setr_ps(p[0].X, p[1].X, p[2].X, p[3].X);
+		__m128 y = _mm_setr_ps(p[0].Y, p[1].Y, p[2].Y, p[3].Y);
+		__m128 z = _mm_setr_ps(p[0].Z, p[1].Z, p[2].Z, p[3].Z);
+
+		// One register per output component, one lane per point.
+		// With w = 1 the last column is added without a multiply, M * 1 is exact so rounding is unchanged.
+		__m128 c[4];
+		for (int r = 0; r < 4; r++)
+		{
+			__m128 v = _mm_mul_ps(row[r][0], x);
+			v = _mm_add_ps(v, _mm_mul_ps(row[r][1], y));
+			v = _mm_add_ps(v, _mm_mul_ps(row[r][2], z));
+			c[r] = _mm_add_ps(v, row[r][3]);
+		}
+
+		_MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+		_mm_storeu_ps(&out[i + 0].X, c[0]);
+		_mm_storeu_ps(&out[i + 1].X, c[1]);
+		_mm_storeu_ps(&out[i + 2].X, c[2]);
+		_mm_storeu_ps(&out[i + 3].X, c[3]);
+	}
+#endif
+
+	for (; i < count; i++)
+		out[i] = m * Vector4(points[i], 1.0f);
+}
+
+Matrix ViewProjectionMatrix(const Vector& location, const Rotator& rotation, float fovDegrees, float aspect)
+{
+	Orientation camOrientation = RotatorToOrientation(rotation);
+	Vector f = camOrientation.forward;
+	Vector r = camOrientation.right;
+	Vector u = camOrientation.up;
+
+	// View space depth has to be positive in front of the camera for the projection below
+	Matrix viewMatrix;
+	viewMatrix.M[0][0] = r.X; viewMatrix.M[0][1] = r.Y; viewMatrix.M[0][2] = r.Z; viewMatrix.M[0][3] = -Vector::dot(r, location);
+	viewMatrix.M[1][0] = u.X; viewMatrix.M[1][1] = u.Y; viewMatrix.M[1][2] = u.Z; viewMatrix.M[1][3] = -Vector::dot(u, location);
+	viewMatrix.M[2][0] = f.X; viewMatrix.M[2][1] = f.Y; viewMatrix.M[2][2] = f.Z; viewMatrix.M[2][3] = -Vector::dot(f, location);
+	viewMatrix.M[3][0] = 0;   viewMatrix.M[3][1] = 0;   viewMatrix.M[3][2] = 0;   viewMatrix.M[3][3] = 1;
+
+	Matrix projMatrix;
+	float nearPlane = 10.0f;
+	float farPlane = 30000.0f;
+	float fovRadians = fovDegrees * (Pi / 180.0f);
+	float yScale = 1.0f / tanf(fovRadians / 2.0f);
+	float xScale = yScale / aspect;
+
+	projMatrix.M[0][0] = xScale; projMatrix.M[0][1] = 0;      projMatrix.M[0][2] = 0;                                   projMatrix.M[0][3] = 0;
+	projMatrix.M[1][0] = 0;      projMatrix.M[1][1] = yScale; projMatrix.M[1][2] = 0;                                   projMatrix.M[1][3] = 0;
+	projMatrix.M[2][0] = 0;      projMatrix.M[2][1] = 0;      projMatrix.M[2][2] = farPlane / (farPlane - nearPlane); projMatrix.M[2][3] = -(farPlane * nearPlane) / (farPlane - nearPlane);
+	projMatrix.M[3][0] = 0;      projMatrix.M[3][1] = 0;      projMatrix.M[3][2] = 1;                                   projMatrix.M[3][3] = 0;
+
+	return projMatrix * viewMatrix;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+
+// SSE2 is part of every x64 target, 32 bit builds need /arch:SSE2
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SF_MATH_SSE 1
+#endif
+
+struct Vector4
+{
+	float X, Y, Z, W;
+
+	Vector4() : X(0), Y(0), Z(0), W(1.0f) {}
+	Vector4(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+	Vector4(const Vector& v, float w = 1.0f) : X(v.X), Y(v.Y), Z(v.Z), W(w) {}
+};
+
+// Row-major 4x4 matrix, M[row][column]. Vectors are columns multiplied from the right.
+struct Matrix
+{
+	float M[4][4];
+
+	// Identity
+	Matrix();
+
+	Vector4 operator*(const Vector4& vec) const;
+	Matrix operator*(const Matrix& other) const;
+};
+
+// Unit axes of a rotated object in world space, Unreal axes: X forward, Y right, Z up
+struct Orientation
+{
+	Vector forward;
+	Vector right;
+	Vector up;
+};
+
+// Sine and cosine of an angle in Unreal rotation units (65536 per turn), any int is accepted.
+// Uses a compile-time table with one entry per 64 units plus the angle sum identity.
+// Max error against double precision sin/cos is 1.1e-7 over every angle, sinf/cosf on
+// the angle converted to float radians are off by up to 2.1e-7.
+float RotatorSin(int units);
+float RotatorCos(int units);
+void RotatorSinCos(int units, float& sin, float& cos);
+
+// Orientation for a rotator in Unreal rotation units
+Orientation RotatorToOrientation(const Rotator& rotation);
+
+// Transforms count points with w = 1, out receives the full homogeneous result.
+// The SSE path handles four points per iteration and gives the same results as Matrix * Vector4.
+void TransformPoints(const Matrix& m, const Vector* points, int count, Vector4* out);
+
+// World to clip space for a camera, with 0 <= Z <= W for points between the near and far plane
+Matrix ViewProjectionMatrix(const Vector& location, const Rotator& rotation, float fovDegrees, float aspect);
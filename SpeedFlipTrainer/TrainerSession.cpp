@@ -0,0 +1,209 @@
+#include "pch.h"
+#include "TrainerSession.h"
+#include "TraceRecorder.h"
+
+#include <cmath>
+
+namespace
+{
+	constexpr float Pi = 3.14159265358979323846f;
+
+	struct ClockTime
+	{
+		int hourHand;
+		int minHand;
+	};
+
+	int ComputeDodgeAngle(const Vector& dd)
+	{
+		if (dd.X == 0 && dd.Y == 0)
+			return 0;
+		return static_cast<int>(atan2f(dd.Y, dd.X) * (180.0f / Pi));
+	}
+
+	ClockTime ComputeClockTime(int angle)
+	{
+		if (angle < 0)
+			angle += 360;
+		ClockTime time;
+		time.hourHand = static_cast<int>(angle * (12.0 / 360.0));
+		if (time.hourHand == 0)
+			time.hourHand = 12;
+		time.minHand = (angle % (360 / 12)) * (60 / (360 / 12));
+		return time;
+	}
+}
+
+bool TrainerSession::OnTick(const CarTickSnapshot& snap, ControllerInput* ci)
+{
+	if (!snap.hasPri)
+		return false;
+
+	bool overridden = false;
+	if (mode == SpeedFlipTrainerMode::Bot)
+		overridden = PlayBot(ci, snap.physicsFrame);
+	else if (mode == SpeedFlipTrainerMode::Replay)
+		overridden = replayAttempt && PlayAttempt(*replayAttempt, replayCursor, ci, snap.physicsFrame);
+
+	if (!snap.hasServer)
+		return overridden;
+	float timeLeft = snap.timeRemaining;
+	int currentFrame = snap.physicsFrame;
+
+	if (initialTime <= 0 || timeLeft >= initialTime)
+	{
+		if (timeLeft > 0 && (initialTime <= 0 || timeLeft > initialTime + 0.1f))
+		{
+			initialTime = timeLeft;
+			SF_LOG_DEBUG("Initial time set to: {}", initialTime);
+		}
+		return overridden;
+	}
+
+	if (startingPhysicsFrame < 0 && timeLeft < initialTime && timeLeft > 0)
+	{
+		startingPhysicsFrame = currentFrame;
+		SF_LOG_DEBUG("Attempt started at physics frame: {}", startingPhysicsFrame);
+		SF_TRACE_INSTANT("Attempt started", "physicsFrame", startingPhysicsFrame);
+		attempt.Clear();
+
+		if (!snap.onGround)
+			attempt.startedInAir = true;
+		if (!ci->ActivateBoost)
+			attempt.startedNoBoost = true;
+		if (snap.hasPhysics)
+			attempt.physics.Reserve(PhysicsTrack::DefaultCapacity);
+	}
+
+	if (startingPhysicsFrame >= 0 && !attempt.exploded && !attempt.hit)
+		Measure(snap);
+	return overridden;
+}
+
+void TrainerSession::OnBallHit(int physicsFrame, float timeRemaining)
+{
+	attempt.ticksToBall = physicsFrame - startingPhysicsFrame;
+	attempt.timeToBall = initialTime - timeRemaining;
+	attempt.hit = true;
+	PublishMetrics();
+	SF_LOG_INFO("Ball hit: {:.3f}s after {} ticks", attempt.timeToBall, attempt.ticksToBall);
+}
+
+void TrainerSession::OnExplode()
+{
+	attempt.exploded = true;
+	attempt.hit = false;
+	PublishMetrics();
+}
+
+RoundResult TrainerSession::OnRestart(float timeRemaining)
+{
+	initialTime = timeRemaining;
+	startingPhysicsFrame = -1;
+
+	RoundResult result;
+	result.hit = attempt.hit && !attempt.exploded;
+	if (result.hit)
+	{
+		consecutiveHits++;
+		consecutiveMiss = 0;
+	}
+	else if (attempt.inputs.size() > 0)
+	{
+		consecutiveHits = 0;
+		consecutiveMiss++;
+	}
+	result.consecutiveHits = consecutiveHits;
+	result.consecutiveMiss = consecutiveMiss;
+
+	if (attempt.inputs.size() > 0)
+	{
+		SF_TRACE_INSTANT(result.hit ? "Attempt hit" : "Attempt missed", "ticks", static_cast<int64_t>(attempt.inputs.size()));
+		result.attempt = attemptPool.Freeze(attempt);
+	}
+	return result;
+}
+
+void TrainerSession::Measure(const CarTickSnapshot& snap)
+{
+	int currentTick = snap.physicsFrame - startingPhysicsFrame;
+	if (currentTick < 0)
+		return;
+
+	const ControllerInput& input = snap.input;
+	attempt.Record(currentTick, input);
+
+	attempt.trajectory.Push(snap.location);
+	if (snap.hasPhysics)
+		attempt.physics.Record(currentTick, snap.physics);
+
+	if (!attempt.jumped && snap.jumped)
+	{
+		attempt.jumped = true;
+		attempt.jumpTick = currentTick;
+		SF_LOG_INFO("First jump: {} ticks", currentTick);
+	}
+
+	if (!attempt.dodged && snap.hasDodge && snap.dodgeTorque.X != 0)
+	{
+		attempt.dodged = true;
+		attempt.dodgedTick = currentTick;
+		attempt.dodgeAngle = ComputeDodgeAngle(snap.dodgeDirection);
+		ClockTime time = ComputeClockTime(attempt.dodgeAngle);
+		SF_LOG_INFO("Dodge Angle: {:03d} deg or {:02d}:{:02d}", attempt.dodgeAngle, time.hourHand, time.minHand);
+	}
+
+	if (input.Throttle < 0.9f)
+		attempt.ticksNotPressingThrottle++;
+	if (!input.ActivateBoost)
+		attempt.ticksNotPressingBoost++;
+
+	if (attempt.dodged && !attempt.flipCanceled && input.Pitch > 0.8f)
+	{
+		attempt.flipCanceled = true;
+		attempt.flipCancelTick = currentTick;
+		SF_LOG_INFO("Flip Cancel: {} ticks after dodge", attempt.flipCancelTick - attempt.dodgedTick);
+	}
+
+	PublishMetrics();
+}
+
+void TrainerSession::PublishMetrics()
+{
+	LiveMetrics live;
+	live.startedInAir = attempt.startedInAir;
+	live.startedNoBoost = attempt.startedNoBoost;
+	live.jumped = attempt.jumped;
+	live.jumpTick = attempt.jumpTick;
+	live.dodged = attempt.dodged;
+	live.dodgeAngle = attempt.dodgeAngle;
+	live.dodgedTick = attempt.dodgedTick;
+	live.flipCanceled = attempt.flipCanceled;
+	live.flipCancelTick = attempt.flipCancelTick;
+	live.hit = attempt.hit;
+	live.ticksToBall = attempt.ticksToBall;
+	live.timeToBall = attempt.timeToBall;
+	live.ticksNotPressingBoost = attempt.ticksNotPressingBoost;
+	live.ticksNotPressingThrottle = attempt.ticksNotPressingThrottle;
+	live.lateralOffset = attempt.trajectory.LateralOffset();
+	live.pathLength = attempt.trajectory.PathLength();
+	liveMetrics.Publish(live);
+}
+
+bool TrainerSession::PlayAttempt(const Attempt& att, InputRuns::Cursor& cursor, ControllerInput* ci, int physicsFrame)
+{
+	if (!att.HasInputs() || startingPhysicsFrame < 0)
+		return false;
+	int tick = physicsFrame - startingPhysicsFrame;
+	att.Play(ci, tick, cursor);
+	return true;
+}
+
+bool TrainerSession::PlayBot(ControllerInput* ci, int physicsFrame)
+{
+	if (bot.inputs.empty() || startingPhysicsFrame < 0)
+		return false;
+	int tick = physicsFrame - startingPhysicsFrame;
+	bot.Play(ci, tick);
+	return true;
+}
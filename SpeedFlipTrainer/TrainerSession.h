@@ -0,0 +1,78 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+#include "Attempt.h"
+#include "AttemptPool.h"
+#include "BotAttempt.h"
+#include "CarTickSnapshot.h"
+#include "LiveMetrics.h"
+#include "TripleBuffer.h"
+
+#include <memory>
+
+enum class SpeedFlipTrainerMode
+{
+	Replay,
+	Bot,
+	Manual
+};
+
+// What the Controller.Restart hook does with the attempt that just ended
+struct RoundResult
+{
+	// nullptr when nothing was recorded since the last restart
+	std::shared_ptr<const Attempt> attempt;
+	bool hit = false;
+	int consecutiveHits = 0;
+	int consecutiveMiss = 0;
+};
+
+// The trainer's game logic between the hooks: starts an attempt when the round clock
+// runs, measures it tick by tick, plays back replays and bots and hands the finished
+// attempt back on restart. It only sees CarTickSnapshot values and plain numbers, never
+// a wrapper, so the same code runs in game and in ReplayHarness.
+// Everything except ReadMetrics runs on the game thread.
+class TrainerSession
+{
+public:
+	SpeedFlipTrainerMode mode = SpeedFlipTrainerMode::Manual;
+	std::shared_ptr<const Attempt> replayAttempt;
+	InputRuns::Cursor replayCursor;
+	BotAttempt bot;
+
+	// SetVehicleInput. Returns true if ci was overridden by a replay or the bot.
+	bool OnTick(const CarTickSnapshot& snap, ControllerInput* ci);
+	// Ball_TA.RecordCarHit, only call it while WaitingForBall
+	void OnBallHit(int physicsFrame, float timeRemaining);
+	// Ball_TA.Explode, only call it while AttemptRunning
+	void OnExplode();
+	// Controller.Restart, timeRemaining is the round clock of the new round (0 without a server)
+	RoundResult OnRestart(float timeRemaining);
+
+	bool AttemptRunning() const { return startingPhysicsFrame >= 0; }
+	bool WaitingForBall() const { return AttemptRunning() && !attempt.hit && !attempt.exploded; }
+	// The dodge component only has to be read until the dodge was seen
+	bool NeedsDodge() const { return !attempt.dodged; }
+
+	// Latest metrics published by the hooks, for the render callback
+	const LiveMetrics& ReadMetrics() { return liveMetrics.Read(); }
+
+private:
+	void Measure(const CarTickSnapshot& snap);
+	void PublishMetrics();
+	bool PlayBot(ControllerInput* ci, int physicsFrame);
+	bool PlayAttempt(const Attempt& a, InputRuns::Cursor& cursor, ControllerInput* ci, int physicsFrame);
+
+	float initialTime = 0;
+	int startingPhysicsFrame = -1;
+
+	// Recorded live, frozen into the RoundResult at restart
+	Attempt attempt;
+	AttemptPool attemptPool;
+
+	int consecutiveHits = 0;
+	int consecutiveMiss = 0;
+
+	// The meters draw from the latest published copy instead of reading attempt while the hook changes it
+	TripleBuffer<LiveMetrics> liveMetrics;
+};
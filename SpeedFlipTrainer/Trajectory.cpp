@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "Trajectory.h"
+
+#include <cmath>
+
+void Trajectory::Reset(Vector lateralAxis)
+{
+	head = 0;
+	total = 0;
+	start = Vector();
+	current = Vector();
+	lateralAxis.normalize();
+	lateral = lateralAxis;
+	pathLength = 0;
+	maxLateral = 0;
+}
+
+void Trajectory::Push(const Vector& point)
+{
+	if (total == 0)
+	{
+		start = point;
+	}
+	else
+	{
+		float dx = point.X - current.X;
+		float dy = point.Y - current.Y;
+		float dz = point.Z - current.Z;
+		pathLength += std::sqrt(dx * dx + dy * dy + dz * dz);
+	}
+	current = point;
+
+	float deviation = std::fabs(LateralOffset());
+	if (deviation > maxLateral)
+		maxLateral = deviation;
+
+	x[head] = point.X;
+	y[head] = point.Y;
+	z[head] = point.Z;
+	head = (head + 1) % Capacity;
+	total++;
+}
+
+Vector Trajectory::At(int i) const
+{
+	int oldest = total < Capacity ? 0 : head;
+	int slot = (oldest + i) % Capacity;
+	return Vector(x[slot], y[slot], z[slot]);
+}
+
+float Trajectory::LateralOffset() const
+{
+	return (current.X - start.X) * lateral.X + (current.Y - start.Y) * lateral.Y + (current.Z - start.Z) * lateral.Z;
+}
+
+float Trajectory::Straightness() const
+{
+	if (pathLength <= 0)
+		return 1.0f;
+
+	float dx = current.X - start.X;
+	float dy = current.Y - start.Y;
+	float dz = current.Z - start.Z;
+	return std::sqrt(dx * dx + dy * dy + dz * dz) / pathLength;
+}
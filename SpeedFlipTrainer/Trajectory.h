@@ -0,0 +1,49 @@
+#pragma once
+
+#include "bakkesmod/wrappers/wrapperstructs.h"
+
+// Car positions of an attempt, one per tick, kept as separate X/Y/Z arrays.
+// Holds the last Capacity points in a ring, older points are overwritten. The path
+// statistics are updated on every Push and always cover the whole attempt.
+class Trajectory
+{
+public:
+	static constexpr int Capacity = 1024; // 8.5 seconds at 120 ticks per second
+
+	// Starts a new path. Lateral deviation is measured along lateralAxis from the start point,
+	// the default matches the horizontal position meter.
+	void Reset(Vector lateralAxis = Vector(0, 1, 0));
+
+	void Push(const Vector& point);
+
+	bool IsEmpty() const { return total == 0; }
+	// Points currently stored, at most Capacity
+	int Size() const { return total < Capacity ? total : Capacity; }
+	// Points pushed since Reset
+	int TotalPoints() const { return total; }
+
+	// i = 0 is the oldest stored point
+	Vector At(int i) const;
+	Vector Start() const { return start; }
+	Vector Current() const { return current; }
+
+	float PathLength() const { return pathLength; }
+	// Offset of the current point along the lateral axis
+	float LateralOffset() const;
+	float MaxLateralDeviation() const { return maxLateral; }
+	// Straight line distance from start to current over the path length, 1 for a straight path
+	float Straightness() const;
+
+private:
+	float x[Capacity];
+	float y[Capacity];
+	float z[Capacity];
+	int head = 0; // Next slot to write
+	int total = 0;
+
+	Vector start;
+	Vector current;
+	Vector lateral = Vector(0, 1, 0);
+	float pathLength = 0;
+	float maxLateral = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Hands the latest value from one writer thread to one reader thread without locks.
+// The writer fills a back slot and swaps it with the shared middle slot, the reader
+// swaps its front slot with the middle one when a newer value was published. Neither
+// side waits, and since a slot is never written and read at the same time the reader
+// always sees a complete value, at worst an older one.
+template <typename T>
+class TripleBuffer
+{
+	static_assert(std::is_trivially_copyable<T>::value, "TripleBuffer values are copied while published");
+
+public:
+	// Writer side, never blocks
+	void Publish(const T& value)
+	{
+		slots[back] = value;
+		uint8_t previous = middle.exchange(static_cast<uint8_t>(back | Fresh), std::memory_order_acq_rel);
+		back = previous & IndexMask;
+	}
+
+	// Reader side, the reference stays valid until the next Read
+	const T& Read()
+	{
+		if (middle.load(std::memory_order_relaxed) & Fresh)
+		{
+			uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+			front = previous & IndexMask;
+		}
+		return slots[front];
+	}
+
+private:
+	static constexpr uint8_t IndexMask = 0x3;
+	static constexpr uint8_t Fresh = 0x4;
+
+	T slots[3] = {};
+	uint8_t back = 0;                 // Writer only
+	uint8_t front = 1;                // Reader only
+	std::atomic<uint8_t> middle{ 2 }; // Shared, Fresh is set until the reader took it
+};
@@ -10,17 +10,28 @@
 #include <memory>
 #include <filesystem> // Added for std::filesystem
 
+// SF_HEADLESS builds the trainer core against the SDK stand-in in Headless/sdk, without ImGui
+#ifndef SF_HEADLESS
 #include "imgui/imgui.h"
+#endif
 
 #include "fmt/core.h"
 #include "fmt/ranges.h"
 
+#include "AsyncLogger.h"
+
 extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
 
+// Cold path logging, formats on the calling thread and queues the line behind the
+// SF_LOG records so the console keeps the order. Hot paths use SF_LOG_* instead.
 template<typename S, typename... Args>
 void LOG(const S& format_str, Args&&... args)
 {
-	if (_globalCvarManager) { // Added null check for safety
+	AsyncLogger& logger = AsyncLogger::Instance();
+	if (logger.IsRunning()) {
+		logger.PushText(LogLevel::Info, fmt::format(format_str, args...));
+	}
+	else if (_globalCvarManager) { // Added null check for safety
 		_globalCvarManager->log(fmt::format(format_str, args...));
 	}
 }
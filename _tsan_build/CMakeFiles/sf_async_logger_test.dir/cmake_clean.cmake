@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_async_logger_test.dir/SpeedFlipTrainer/Headless/AsyncLoggerTest.cpp.o"
+  "CMakeFiles/sf_async_logger_test.dir/SpeedFlipTrainer/Headless/AsyncLoggerTest.cpp.o.d"
+  "sf_async_logger_test"
+  "sf_async_logger_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_async_logger_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_attempt_file_test.dir/SpeedFlipTrainer/Headless/AttemptFileTest.cpp.o"
+  "CMakeFiles/sf_attempt_file_test.dir/SpeedFlipTrainer/Headless/AttemptFileTest.cpp.o.d"
+  "sf_attempt_file_test"
+  "sf_attempt_file_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_attempt_file_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_bench.dir/SpeedFlipTrainer/Headless/BenchMain.cpp.o"
+  "CMakeFiles/sf_bench.dir/SpeedFlipTrainer/Headless/BenchMain.cpp.o.d"
+  "sf_bench"
+  "sf_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
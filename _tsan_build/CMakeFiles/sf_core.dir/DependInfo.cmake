@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SpeedFlipTrainer/AllocationCounter.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AllocationCounter.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AllocationCounter.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/AsyncLogger.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AsyncLogger.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AsyncLogger.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/Attempt.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Attempt.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Attempt.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/AttemptFile.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptFile.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptFile.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/AttemptPool.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptPool.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptPool.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/BotAttempt.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/BotAttempt.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/BotAttempt.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/CarTickSnapshot.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CarTickSnapshot.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CarTickSnapshot.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/CsvReader.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvReader.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvReader.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/CsvWriter.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvWriter.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvWriter.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/DrawList.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/DrawList.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/DrawList.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/FileIO.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/FileIO.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/FileIO.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/Headless/FakeGame.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/FakeGame.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/FakeGame.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/Headless/ReplayHarness.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/ReplayHarness.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/ReplayHarness.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/InputRuns.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputRuns.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputRuns.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/InputTimeline.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputTimeline.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputTimeline.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/IoWorkerPool.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/IoWorkerPool.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/IoWorkerPool.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/LatencyHistogram.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/LatencyHistogram.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/LatencyHistogram.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/PhysicsTrack.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/PhysicsTrack.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/PhysicsTrack.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/Projection.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Projection.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Projection.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/RenderMeter.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/RenderMeter.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/RenderMeter.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/TextMeasureCache.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TextMeasureCache.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TextMeasureCache.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/TraceRecorder.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TraceRecorder.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TraceRecorder.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/TrainerMath.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerMath.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerMath.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/TrainerSession.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerSession.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerSession.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/Trajectory.cpp" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Trajectory.cpp.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Trajectory.cpp.o.d"
+  "/root/repo/SpeedFlipTrainer/fmt/src/format.cc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/fmt/src/format.cc.o" "gcc" "CMakeFiles/sf_core.dir/SpeedFlipTrainer/fmt/src/format.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
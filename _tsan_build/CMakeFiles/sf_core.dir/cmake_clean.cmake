@@ -0,0 +1,61 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AllocationCounter.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AllocationCounter.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AsyncLogger.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AsyncLogger.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Attempt.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Attempt.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptFile.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptFile.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptPool.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/AttemptPool.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/BotAttempt.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/BotAttempt.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CarTickSnapshot.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CarTickSnapshot.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvReader.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvReader.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvWriter.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/CsvWriter.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/DrawList.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/DrawList.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/FileIO.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/FileIO.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/FakeGame.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/FakeGame.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/ReplayHarness.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Headless/ReplayHarness.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputRuns.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputRuns.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputTimeline.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/InputTimeline.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/IoWorkerPool.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/IoWorkerPool.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/LatencyHistogram.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/LatencyHistogram.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/PhysicsTrack.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/PhysicsTrack.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Projection.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Projection.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/RenderMeter.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/RenderMeter.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TextMeasureCache.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TextMeasureCache.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TraceRecorder.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TraceRecorder.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerMath.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerMath.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerSession.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/TrainerSession.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Trajectory.cpp.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/Trajectory.cpp.o.d"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/fmt/src/format.cc.o"
+  "CMakeFiles/sf_core.dir/SpeedFlipTrainer/fmt/src/format.cc.o.d"
+  "libsf_core.a"
+  "libsf_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
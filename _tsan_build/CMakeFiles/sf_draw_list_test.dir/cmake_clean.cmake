@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_draw_list_test.dir/SpeedFlipTrainer/Headless/DrawListTest.cpp.o"
+  "CMakeFiles/sf_draw_list_test.dir/SpeedFlipTrainer/Headless/DrawListTest.cpp.o.d"
+  "sf_draw_list_test"
+  "sf_draw_list_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_draw_list_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_frame_allocation_test.dir/SpeedFlipTrainer/Headless/FrameAllocationTest.cpp.o"
+  "CMakeFiles/sf_frame_allocation_test.dir/SpeedFlipTrainer/Headless/FrameAllocationTest.cpp.o.d"
+  "sf_frame_allocation_test"
+  "sf_frame_allocation_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_frame_allocation_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_io_worker_pool_test.dir/SpeedFlipTrainer/Headless/IoWorkerPoolTest.cpp.o"
+  "CMakeFiles/sf_io_worker_pool_test.dir/SpeedFlipTrainer/Headless/IoWorkerPoolTest.cpp.o.d"
+  "sf_io_worker_pool_test"
+  "sf_io_worker_pool_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_io_worker_pool_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
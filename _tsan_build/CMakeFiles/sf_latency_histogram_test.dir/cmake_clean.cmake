@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_latency_histogram_test.dir/SpeedFlipTrainer/Headless/LatencyHistogramTest.cpp.o"
+  "CMakeFiles/sf_latency_histogram_test.dir/SpeedFlipTrainer/Headless/LatencyHistogramTest.cpp.o.d"
+  "sf_latency_histogram_test"
+  "sf_latency_histogram_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_latency_histogram_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_math_test.dir/SpeedFlipTrainer/Headless/MathTest.cpp.o"
+  "CMakeFiles/sf_math_test.dir/SpeedFlipTrainer/Headless/MathTest.cpp.o.d"
+  "sf_math_test"
+  "sf_math_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_math_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_replay.dir/SpeedFlipTrainer/Headless/ReplayMain.cpp.o"
+  "CMakeFiles/sf_replay.dir/SpeedFlipTrainer/Headless/ReplayMain.cpp.o.d"
+  "sf_replay"
+  "sf_replay.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_replay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
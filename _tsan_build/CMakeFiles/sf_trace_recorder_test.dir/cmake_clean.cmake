@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_trace_recorder_test.dir/SpeedFlipTrainer/Headless/TraceRecorderTest.cpp.o"
+  "CMakeFiles/sf_trace_recorder_test.dir/SpeedFlipTrainer/Headless/TraceRecorderTest.cpp.o.d"
+  "sf_trace_recorder_test"
+  "sf_trace_recorder_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_trace_recorder_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_trajectory_test.dir/SpeedFlipTrainer/Headless/TrajectoryTest.cpp.o"
+  "CMakeFiles/sf_trajectory_test.dir/SpeedFlipTrainer/Headless/TrajectoryTest.cpp.o.d"
+  "sf_trajectory_test"
+  "sf_trajectory_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_trajectory_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sf_triple_buffer_stress.dir/SpeedFlipTrainer/Headless/TripleBufferStressTest.cpp.o"
+  "CMakeFiles/sf_triple_buffer_stress.dir/SpeedFlipTrainer/Headless/TripleBufferStressTest.cpp.o.d"
+  "sf_triple_buffer_stress"
+  "sf_triple_buffer_stress.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sf_triple_buffer_stress.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
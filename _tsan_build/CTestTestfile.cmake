@@ -0,0 +1,30 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_tsan_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(replay_recorded_flips "/root/repo/_tsan_build/sf_replay" "--baseline" "/root/repo/SpeedFlipTrainer/Headless/ReplayBaseline.txt" "/root/repo/RecordedFlips/1.9677-23deg.csv" "/root/repo/RecordedFlips/Kickoff-Left.csv" "/root/repo/RecordedFlips/Kickoff-Right.csv" "/root/repo/RecordedFlips/PhantomTouch.csv")
+set_tests_properties(replay_recorded_flips PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;70;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(bench_allocations "/root/repo/_tsan_build/sf_bench" "--quick" "--ignore-time" "--baseline" "/root/repo/SpeedFlipTrainer/Headless/BenchBaseline.txt")
+set_tests_properties(bench_allocations PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;77;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(attempt_file_round_trip "/root/repo/_tsan_build/sf_attempt_file_test" "/root/repo/RecordedFlips")
+set_tests_properties(attempt_file_round_trip PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;82;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(math "/root/repo/_tsan_build/sf_math_test")
+set_tests_properties(math PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;87;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(triple_buffer_stress "/root/repo/_tsan_build/sf_triple_buffer_stress")
+set_tests_properties(triple_buffer_stress PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;91;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(draw_list "/root/repo/_tsan_build/sf_draw_list_test")
+set_tests_properties(draw_list PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;95;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(frame_allocations "/root/repo/_tsan_build/sf_frame_allocation_test")
+set_tests_properties(frame_allocations PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;99;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(io_worker_pool "/root/repo/_tsan_build/sf_io_worker_pool_test")
+set_tests_properties(io_worker_pool PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;103;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(trajectory "/root/repo/_tsan_build/sf_trajectory_test")
+set_tests_properties(trajectory PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;107;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(latency_histogram "/root/repo/_tsan_build/sf_latency_histogram_test")
+set_tests_properties(latency_histogram PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;111;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(trace_recorder "/root/repo/_tsan_build/sf_trace_recorder_test")
+set_tests_properties(trace_recorder PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;115;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(async_logger "/root/repo/_tsan_build/sf_async_logger_test")
+set_tests_properties(async_logger PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;119;add_test;/root/repo/CMakeLists.txt;0;")